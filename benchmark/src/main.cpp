@@ -0,0 +1,76 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+// Local Includes
+#include "tweenbenchmark.h"
+
+// External Includes
+#include <nap/logger.h>
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+/**
+ * Tween Benchmark.
+ * Measures the hot paths of the tween service without a window and writes the results as JSON.
+ * Usage: naptweenbenchmark [--output file] [--frames n] [--counts n,n,..] [--threads n] [--filter suite] [--quick]
+ * Results are written to tweenbenchmark.json by default.
+ */
+int main(int argc, char *argv[])
+{
+	nap::TweenBenchmarkOptions options;
+	std::string output = "tweenbenchmark.json";
+	for (int i = 1; i < argc; i++)
+	{
+		bool has_value = i + 1 < argc;
+		if (std::strcmp(argv[i], "--output") == 0 && has_value)
+		{
+			output = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--frames") == 0 && has_value)
+		{
+			options.mFrames = static_cast<nap::uint32>(std::max(std::atoi(argv[++i]), 1));
+		}
+		else if (std::strcmp(argv[i], "--threads") == 0 && has_value)
+		{
+			options.mThreadCount = static_cast<nap::uint32>(std::max(std::atoi(argv[++i]), 0));
+		}
+		else if (std::strcmp(argv[i], "--filter") == 0 && has_value)
+		{
+			options.mFilter = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--counts") == 0 && has_value)
+		{
+			options.mCounts.clear();
+			for (char* count = std::strtok(argv[++i], ","); count != nullptr; count = std::strtok(nullptr, ","))
+				options.mCounts.emplace_back(static_cast<nap::uint32>(std::max(std::atoi(count), 1)));
+		}
+		else if (std::strcmp(argv[i], "--quick") == 0)
+		{
+			options.mCounts = { 1000, 10000 };
+			options.mFrames = 10;
+			options.mWarmup = 2;
+		}
+		else
+		{
+			nap::Logger::error("Unknown argument: %s", argv[i]);
+			return -1;
+		}
+	}
+
+	nap::TweenBenchmark benchmark(options);
+	benchmark.run();
+
+	// write results
+	std::ofstream file(output);
+	if (!file)
+	{
+		nap::Logger::error("Unable to write results to: %s", output.c_str());
+		return -1;
+	}
+	file << benchmark.toJSON();
+	nap::Logger::info("Results written to: %s", output.c_str());
+	return 0;
+}
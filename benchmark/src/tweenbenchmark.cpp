@@ -0,0 +1,496 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+// Local Includes
+#include "tweenbenchmark.h"
+
+// External Includes
+#include <tweenallocationcounter.h>
+#include <tweeneasetable.h>
+#include <tweensimd.h>
+#include <nap/logger.h>
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+namespace nap
+{
+	/**
+	 * Exposes the update loop of the service, which is normally driven by core
+	 */
+	class BenchmarkTweenService : public TweenService
+	{
+	public:
+		using TweenService::TweenService;
+		using TweenService::init;
+		using TweenService::update;
+		using TweenService::shutdown;
+	};
+
+
+	/**
+	 * Service configuration of an update case
+	 */
+	enum class EBenchmarkConfig : int
+	{
+		Serial,
+		Parallel,
+		EaseTable,
+		Lazy
+	};
+
+
+	/**
+	 * Representative eases: polynomial, trigonometric, exponential, square root and piecewise
+	 */
+	static const ETweenEaseType sEases[] =
+	{
+		ETweenEaseType::LINEAR,
+		ETweenEaseType::CUBIC_INOUT,
+		ETweenEaseType::SINE_INOUT,
+		ETweenEaseType::EXPO_OUT,
+		ETweenEaseType::CIRC_IN,
+		ETweenEaseType::ELASTIC_OUT,
+		ETweenEaseType::BOUNCE_OUT
+	};
+
+	static constexpr double sDeltaTime = 1.0 / 60.0;
+	static constexpr uint32 sEaseSamples = 1 << 16;
+	static constexpr uint32 sChurnCount = 10000;
+	static constexpr uint32 sSignalCount = 10000;
+	static constexpr uint32 sSignalListeners = 8;
+
+
+	static std::string getName(ETweenEaseType easing)
+	{
+		return RTTI_OF(ETweenEaseType).get_enumeration().value_to_name(easing).to_string();
+	}
+
+
+	static std::string getName(ETweenMode mode)
+	{
+		return RTTI_OF(ETweenMode).get_enumeration().value_to_name(mode).to_string();
+	}
+
+
+	static std::string getName(EBenchmarkConfig config)
+	{
+		switch (config)
+		{
+		case EBenchmarkConfig::Parallel:	return "parallel";
+		case EBenchmarkConfig::EaseTable:	return "ease table";
+		case EBenchmarkConfig::Lazy:		return "lazy";
+		default:							return "serial";
+		}
+	}
+
+
+	static std::string getName(ETweenInstructionSet set)
+	{
+		switch (set)
+		{
+		case ETweenInstructionSet::SSE2:	return "SSE2";
+		case ETweenInstructionSet::AVX2:	return "AVX2";
+		case ETweenInstructionSet::NEON:	return "NEON";
+		default:							return "Scalar";
+		}
+	}
+
+
+	/**
+	 * Median time of a run and average number of heap allocations per run
+	 */
+	struct Measurement
+	{
+		double mTime = 0.0;				///< Median time of a run in nanoseconds
+		double mAllocations = 0.0;		///< Heap allocations per run
+	};
+
+
+	/**
+	 * Measures repeated runs of a function
+	 */
+	template<typename Function>
+	static Measurement measure(uint32 warmup, uint32 runs, Function&& function)
+	{
+		for (uint32 i = 0; i < warmup; i++)
+			function();
+
+		std::vector<double> samples(runs);
+		size_t allocations = 0;
+		for (uint32 i = 0; i < runs; i++)
+		{
+			size_t before = getHeapAllocationCount();
+			auto start = std::chrono::steady_clock::now();
+			function();
+			samples[i] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+			allocations += getHeapAllocationCount() - before;
+		}
+
+		Measurement measurement;
+		std::nth_element(samples.begin(), samples.begin() + runs / 2, samples.end());
+		measurement.mTime = samples[runs / 2];
+		measurement.mAllocations = static_cast<double>(allocations) / runs;
+		return measurement;
+	}
+
+
+	/**
+	 * Deterministic durations, short for looping modes so they wrap often, long for the others so they stay active
+	 */
+	static std::vector<float> makeDurations(uint32 count, ETweenMode mode)
+	{
+		bool loops = mode == ETweenMode::LOOP || mode == ETweenMode::PING_PONG;
+		float base = loops ? 0.1f : 10.0f;
+		float range = loops ? 0.4f : 10.0f;
+
+		std::vector<float> durations(count);
+		uint32 state = 12345;
+		for (auto& duration : durations)
+		{
+			state = state * 1664525u + 1013904223u;
+			duration = base + range * static_cast<float>(state >> 8) / static_cast<float>(1u << 24);
+		}
+		return durations;
+	}
+
+
+	static bool initService(BenchmarkTweenService& service)
+	{
+		utility::ErrorState error;
+		if (!service.init(error))
+		{
+			nap::Logger::error("Unable to initialize tween service: %s", error.toString().c_str());
+			return false;
+		}
+		return true;
+	}
+
+
+	template<typename T>
+	static Measurement measureUpdate(const TweenServiceConfiguration& config, uint32 count, ETweenMode mode, ETweenEaseType easing, const TweenBenchmarkOptions& options)
+	{
+		TweenServiceConfiguration copy = config;
+		BenchmarkTweenService service(&copy);
+		if (!initService(service))
+			return {};
+
+		std::vector<T> starts(count, T(0.0f));
+		std::vector<T> ends(count, T(1.0f));
+		std::vector<float> durations = makeDurations(count, mode);
+		std::vector<ETweenEaseType> eases(count, easing);
+		std::vector<ETweenMode> modes(count, mode);
+
+		utility::ErrorState error;
+		auto handle = service.createTweens<T>(count, starts.data(), ends.data(), durations.data(), error, eases.data(), modes.data());
+		Measurement measurement = measure(options.mWarmup, options.mFrames, [&]() { service.update(sDeltaTime); });
+
+		handle = nullptr;
+		service.update(0.0);
+		service.shutdown();
+		return measurement;
+	}
+
+
+	TweenBenchmark::TweenBenchmark(const TweenBenchmarkOptions& options) :
+		mOptions(options)
+	{ }
+
+
+	void TweenBenchmark::run()
+	{
+		if (isEnabled("ease"))
+			runEase();
+		if (isEnabled("signal"))
+			runSignal();
+		if (isEnabled("churn"))
+			runChurn();
+		if (isEnabled("update"))
+			runUpdate();
+	}
+
+
+	bool TweenBenchmark::isEnabled(const std::string& suite) const
+	{
+		return mOptions.mFilter.empty() || suite.find(mOptions.mFilter) != std::string::npos;
+	}
+
+
+	void TweenBenchmark::addResult(TweenBenchmarkResult&& result)
+	{
+		std::ostringstream line;
+		line << result.mSuite << ":";
+		for (const auto& parameter : result.mParameters)
+			line << " " << parameter.first << "=" << parameter.second;
+		for (const auto& metric : result.mMetrics)
+			line << " " << metric.first << "=" << metric.second;
+		nap::Logger::info(line.str());
+		mResults.emplace_back(std::move(result));
+	}
+
+
+	void TweenBenchmark::runUpdate()
+	{
+		const EBenchmarkConfig configs[] = { EBenchmarkConfig::Serial, EBenchmarkConfig::Parallel, EBenchmarkConfig::EaseTable, EBenchmarkConfig::Lazy };
+		const ETweenMode modes[] = { ETweenMode::NORMAL, ETweenMode::LOOP, ETweenMode::PING_PONG, ETweenMode::REVERSE };
+		for (auto config : configs)
+		{
+			TweenServiceConfiguration service_config;
+			service_config.mParallel = config == EBenchmarkConfig::Parallel;
+			service_config.mThreadCount = static_cast<int>(mOptions.mThreadCount);
+			service_config.mEaseTable = config == EBenchmarkConfig::EaseTable;
+			service_config.mLazy = config == EBenchmarkConfig::Lazy;
+
+			for (uint32 count : mOptions.mCounts)
+			{
+				for (auto mode : modes)
+				{
+					for (auto easing : sEases)
+					{
+						// vec3 tweens only serially, the other configurations don't depend on the value type
+						bool vec3 = config == EBenchmarkConfig::Serial;
+						for (int type = 0; type < (vec3 ? 2 : 1); type++)
+						{
+							Measurement update = type == 0 ?
+								measureUpdate<float>(service_config, count, mode, easing, mOptions) :
+								measureUpdate<glm::vec3>(service_config, count, mode, easing, mOptions);
+
+							TweenBenchmarkResult result;
+							result.mSuite = "update";
+							result.mParameters =
+							{
+								{ "config", getName(config) },
+								{ "type", type == 0 ? "float" : "vec3" },
+								{ "count", std::to_string(count) },
+								{ "mode", getName(mode) },
+								{ "ease", getName(easing) }
+							};
+							result.mMetrics =
+							{
+								{ "ns_per_update", update.mTime },
+								{ "ns_per_tween", update.mTime / count },
+								{ "allocations_per_update", update.mAllocations }
+							};
+							addResult(std::move(result));
+						}
+					}
+				}
+			}
+		}
+	}
+
+
+	void TweenBenchmark::runChurn()
+	{
+		TweenServiceConfiguration config;
+		BenchmarkTweenService service(&config);
+		if (!initService(service))
+			return;
+
+		// create and destroy tweens one handle at a time, removal happens in the next update
+		std::vector<std::unique_ptr<TweenHandle<float>>> handles;
+		handles.reserve(sChurnCount);
+		utility::ErrorState error;
+		auto churn = [&]()
+		{
+			for (uint32 i = 0; i < sChurnCount; i++)
+				handles.emplace_back(service.createTween<float>(0.0f, 1.0f, 1.0f, error, ETweenEaseType::CUBIC_OUT));
+			handles.clear();
+			service.update(sDeltaTime);
+		};
+
+		Measurement single = measure(mOptions.mWarmup, mOptions.mFrames, churn);
+
+		TweenBenchmarkResult result;
+		result.mSuite = "churn";
+		result.mParameters = { { "api", "createTween" }, { "count", std::to_string(sChurnCount) } };
+		result.mMetrics =
+		{
+			{ "ns_per_tween", single.mTime / sChurnCount },
+			{ "allocations_per_tween", single.mAllocations / sChurnCount }
+		};
+		addResult(std::move(result));
+
+		// create and destroy all tweens with a single handle
+		std::vector<float> starts(sChurnCount, 0.0f);
+		std::vector<float> ends(sChurnCount, 1.0f);
+		std::vector<float> durations(sChurnCount, 1.0f);
+		auto batch = [&]()
+		{
+			auto handle = service.createTweens<float>(sChurnCount, starts.data(), ends.data(), durations.data(), error);
+			handle = nullptr;
+			service.update(sDeltaTime);
+		};
+
+		Measurement batched = measure(mOptions.mWarmup, mOptions.mFrames, batch);
+
+		result = TweenBenchmarkResult();
+		result.mSuite = "churn";
+		result.mParameters = { { "api", "createTweens" }, { "count", std::to_string(sChurnCount) } };
+		result.mMetrics =
+		{
+			{ "ns_per_tween", batched.mTime / sChurnCount },
+			{ "allocations_per_tween", batched.mAllocations / sChurnCount }
+		};
+		addResult(std::move(result));
+
+		// play tweens without a handle, they complete and are recycled in the next update
+		auto play = [&]()
+		{
+			for (uint32 i = 0; i < sChurnCount; i++)
+				service.play<float>(0.0f, 1.0f, static_cast<float>(sDeltaTime) * 0.5f, error, ETweenEaseType::CUBIC_OUT);
+			service.update(sDeltaTime);
+		};
+
+		Measurement played = measure(mOptions.mWarmup, mOptions.mFrames, play);
+
+		result = TweenBenchmarkResult();
+		result.mSuite = "churn";
+		result.mParameters = { { "api", "play" }, { "count", std::to_string(sChurnCount) } };
+		result.mMetrics =
+		{
+			{ "ns_per_tween", played.mTime / sChurnCount },
+			{ "allocations_per_tween", played.mAllocations / sChurnCount }
+		};
+		addResult(std::move(result));
+		service.shutdown();
+	}
+
+
+	void TweenBenchmark::runEase()
+	{
+		std::vector<float> progress(sEaseSamples);
+		std::vector<float> out(sEaseSamples);
+		for (uint32 i = 0; i < sEaseSamples; i++)
+			progress[i] = static_cast<float>(i) / static_cast<float>(sEaseSamples - 1);
+
+		TweenEaseTable linear(1024, ETweenEaseTableInterpolation::LINEAR);
+		TweenEaseTable cubic(1024, ETweenEaseTableInterpolation::CUBIC);
+		volatile float sink = 0.0f;
+		for (uint32 e = 0; e < tweenEaseCount; e++)
+		{
+			auto easing = static_cast<ETweenEaseType>(e);
+			Measurement scalar = measure(mOptions.mWarmup, mOptions.mFrames, [&]()
+			{
+				float sum = 0.0f;
+				for (uint32 i = 0; i < sEaseSamples; i++)
+					sum += evaluateTweenEase(easing, progress[i]);
+				sink = sum;
+			});
+			Measurement batch = measure(mOptions.mWarmup, mOptions.mFrames, [&]()
+			{
+				evaluateEaseBatch(easing, progress.data(), out.data(), sEaseSamples);
+				sink = out[sEaseSamples / 2];
+			});
+			Measurement table_linear = measure(mOptions.mWarmup, mOptions.mFrames, [&]()
+			{
+				linear.evaluate(easing, progress.data(), out.data(), sEaseSamples);
+				sink = out[sEaseSamples / 2];
+			});
+			Measurement table_cubic = measure(mOptions.mWarmup, mOptions.mFrames, [&]()
+			{
+				cubic.evaluate(easing, progress.data(), out.data(), sEaseSamples);
+				sink = out[sEaseSamples / 2];
+			});
+
+			TweenBenchmarkResult result;
+			result.mSuite = "ease";
+			result.mParameters = { { "ease", getName(easing) } };
+			result.mMetrics =
+			{
+				{ "ns_scalar", scalar.mTime / sEaseSamples },
+				{ "ns_batch", batch.mTime / sEaseSamples },
+				{ "ns_table_linear", table_linear.mTime / sEaseSamples },
+				{ "ns_table_cubic", table_cubic.mTime / sEaseSamples },
+				{ "table_linear_max_error", linear.getMaxError(easing) },
+				{ "table_cubic_max_error", cubic.getMaxError(easing) }
+			};
+			addResult(std::move(result));
+		}
+	}
+
+
+	void TweenBenchmark::runSignal()
+	{
+		const uint32 listeners[] = { 0, 1, sSignalListeners };
+		for (uint32 count : listeners)
+		{
+			TweenServiceConfiguration config;
+			BenchmarkTweenService service(&config);
+			if (!initService(service))
+				return;
+
+			// looping tweens update every frame without completing
+			std::vector<float> starts(sSignalCount, 0.0f);
+			std::vector<float> ends(sSignalCount, 1.0f);
+			std::vector<float> durations = makeDurations(sSignalCount, ETweenMode::LOOP);
+			std::vector<ETweenMode> modes(sSignalCount, ETweenMode::LOOP);
+			utility::ErrorState error;
+			auto handle = service.createTweens<float>(sSignalCount, starts.data(), ends.data(), durations.data(), error, nullptr, modes.data());
+
+			volatile float sink = 0.0f;
+			for (uint32 i = 0; i < sSignalCount; i++)
+			{
+				for (uint32 l = 0; l < count; l++)
+					handle->getTween(i).UpdateSignal.connect([&sink](const float& value) { sink = value; });
+			}
+
+			Measurement update = measure(mOptions.mWarmup, mOptions.mFrames, [&]() { service.update(sDeltaTime); });
+
+			TweenBenchmarkResult result;
+			result.mSuite = "signal";
+			result.mParameters = { { "listeners", std::to_string(count) }, { "count", std::to_string(sSignalCount) } };
+			result.mMetrics =
+			{
+				{ "ns_per_update", update.mTime },
+				{ "ns_per_tween", update.mTime / sSignalCount },
+				{ "allocations_per_update", update.mAllocations }
+			};
+			addResult(std::move(result));
+
+			handle = nullptr;
+			service.update(0.0);
+			service.shutdown();
+		}
+	}
+
+
+	static std::string escape(const std::string& value)
+	{
+		std::string escaped;
+		for (char c : value)
+		{
+			if (c == '"' || c == '\\')
+				escaped += '\\';
+			escaped += c;
+		}
+		return escaped;
+	}
+
+
+	std::string TweenBenchmark::toJSON() const
+	{
+		std::ostringstream json;
+		json.precision(9);
+		json << "{\n";
+		json << "\t\"module\": \"naptween\",\n";
+		json << "\t\"instructionSet\": \"" << getName(getTweenInstructionSet()) << "\",\n";
+		json << "\t\"frames\": " << mOptions.mFrames << ",\n";
+		json << "\t\"warmup\": " << mOptions.mWarmup << ",\n";
+		json << "\t\"threadCount\": " << mOptions.mThreadCount << ",\n";
+		json << "\t\"results\": [";
+		for (size_t r = 0; r < mResults.size(); r++)
+		{
+			const auto& result = mResults[r];
+			json << (r > 0 ? ",\n" : "\n") << "\t\t{ \"suite\": \"" << escape(result.mSuite) << "\"";
+			for (const auto& parameter : result.mParameters)
+				json << ", \"" << escape(parameter.first) << "\": \"" << escape(parameter.second) << "\"";
+			for (const auto& metric : result.mMetrics)
+				json << ", \"" << escape(metric.first) << "\": " << metric.second;
+			json << " }";
+		}
+		json << "\n\t]\n}\n";
+		return json.str();
+	}
+}
@@ -0,0 +1,94 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// External Includes
+#include <tweenservice.h>
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace nap
+{
+	//////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * Settings of a benchmark run
+	 */
+	struct TweenBenchmarkOptions
+	{
+		std::vector<uint32>	mCounts = { 1000, 10000, 100000, 1000000 };		///< Number of tweens per update case
+		uint32				mFrames = 30;			///< Measured updates per case
+		uint32				mWarmup = 5;			///< Updates before measuring
+		uint32				mThreadCount = 0;		///< Worker threads of the parallel cases, 0 uses all available cores
+		std::string			mFilter;				///< Only run suites whose name contains this string, empty runs all
+	};
+
+
+	/**
+	 * Measurement of one benchmark case
+	 */
+	struct TweenBenchmarkResult
+	{
+		std::string										mSuite;			///< Suite the case belongs to
+		std::vector<std::pair<std::string, std::string>>	mParameters;	///< Parameters of the case
+		std::vector<std::pair<std::string, double>>			mMetrics;		///< Measured values
+	};
+
+
+	/**
+	 * Headless benchmark of the tween service hot paths: no window, no core, the service is driven directly.
+	 * Suites:
+	 * 	- update: TweenService::update at several tween counts, for every mode and a set of representative eases,
+	 * 	  serial, parallel, with the ease table and lazy
+	 * 	- churn: creating and destroying tweens through their handles, and playing tweens without a handle
+	 * 	- ease: cost of a single ease evaluation per ease, scalar, batched and sampled from the ease table
+	 * 	- signal: update cost with 0, 1 and N update listeners per tween
+	 * Every case reports the median time per update or operation and the number of heap allocations.
+	 */
+	class TweenBenchmark
+	{
+	public:
+		/**
+		 * Constructor
+		 * @param options settings of the run
+		 */
+		TweenBenchmark(const TweenBenchmarkOptions& options);
+
+		/**
+		 * Runs all suites that pass the filter
+		 */
+		void run();
+
+		/**
+		 * @return results of all cases that ran
+		 */
+		const std::vector<TweenBenchmarkResult>& getResults() const		{ return mResults; }
+
+		/**
+		 * @return all results as a JSON document
+		 */
+		std::string toJSON() const;
+
+	private:
+		void runUpdate();
+		void runChurn();
+		void runEase();
+		void runSignal();
+
+		/**
+		 * @return if the suite with the given name passes the filter
+		 */
+		bool isEnabled(const std::string& suite) const;
+
+		/**
+		 * Adds a result and logs it
+		 */
+		void addResult(TweenBenchmarkResult&& result);
+
+		TweenBenchmarkOptions					mOptions;
+		std::vector<TweenBenchmarkResult>		mResults;
+	};
+}
@@ -59,6 +59,13 @@ namespace nap
 
 		mGuiService->selectWindow(mRenderWindow);
 
+		// the animation position follows the pointer with a slightly under damped spring
+		mAnimationPosSpring = mTweenService->createSpring<glm::vec2>(mAnimationPos, 2.0f, 0.7f, error);
+		if (mAnimationPosSpring == nullptr)
+			return false;
+		mAnimationPosSpring->setLabel("Plane Animation Position");
+		mAnimationPosSpring->getTween().bind(&mAnimationPos);
+
 		return true;
 	}
 
@@ -154,11 +161,83 @@ namespace nap
 					mMovementTweenHandle->getTween().setMode(mCurrentTweenMode);
 				}
 			}
+
+			// show what the tween service costs every frame
+			if (ImGui::CollapsingHeader("Statistics"))
+				drawStats();
 		}
 		ImGui::End();
 	}
 
 
+	void TweenApp::drawStats()
+	{
+		const TweenServiceStats& stats = mTweenService->getStats();
+
+		// record the update time of this frame, the plot starts at the oldest sample
+		mUpdateTimes[mUpdateTimeIndex] = static_cast<float>(stats.getUpdateTime() * 1000.0);
+		mUpdateTimeIndex = (mUpdateTimeIndex + 1) % static_cast<int>(mUpdateTimes.size());
+		ImGui::PlotLines("Update (ms)", mUpdateTimes.data(), static_cast<int>(mUpdateTimes.size()), mUpdateTimeIndex);
+
+		// time spent per phase
+		ImGui::Text(utility::stringFormat("Evaluation: %.3f ms", stats.mEvaluationTime * 1000.0).c_str());
+		ImGui::Text(utility::stringFormat("Dispatch: %.3f ms", stats.mDispatchTime * 1000.0).c_str());
+		ImGui::Text(utility::stringFormat("Removal: %.3f ms", stats.mRemovalTime * 1000.0).c_str());
+		ImGui::Text(utility::stringFormat("Tasks: %.3f ms (%d running)", stats.mTaskTime * 1000.0, static_cast<int>(stats.mTaskCount)).c_str());
+		ImGui::Text(utility::stringFormat("Allocations: %d", static_cast<int>(stats.mAllocationCount)).c_str());
+
+		// tween counts per value type
+		ImGui::Columns(5, "TweenCounts");
+		ImGui::Text("Type");	ImGui::NextColumn();
+		ImGui::Text("Active");	ImGui::NextColumn();
+		ImGui::Text("Dormant");	ImGui::NextColumn();
+		ImGui::Text("Removed");	ImGui::NextColumn();
+		ImGui::Text("Peak");	ImGui::NextColumn();
+		ImGui::Separator();
+		for (const auto& type : stats.mTypes)
+		{
+			ImGui::Text("%s", type.mName.c_str());								ImGui::NextColumn();
+			ImGui::Text("%d", static_cast<int>(type.mActiveCount));				ImGui::NextColumn();
+			ImGui::Text("%d", static_cast<int>(type.mDormantCount));			ImGui::NextColumn();
+			ImGui::Text("%d", static_cast<int>(type.mPendingRemovalCount));		ImGui::NextColumn();
+			ImGui::Text("%d", static_cast<int>(type.mPeakCount));				ImGui::NextColumn();
+		}
+		ImGui::Separator();
+		ImGui::TextColored(mGuiService->getPalette().mHighlightColor2, "Total");	ImGui::NextColumn();
+		ImGui::Text("%d", static_cast<int>(stats.mActiveCount));				ImGui::NextColumn();
+		ImGui::Text("%d", static_cast<int>(stats.mDormantCount));				ImGui::NextColumn();
+		ImGui::Text("%d", static_cast<int>(stats.mPendingRemovalCount));		ImGui::NextColumn();
+		ImGui::Text("%d", static_cast<int>(stats.mPeakCount));					ImGui::NextColumn();
+		ImGui::Columns(1);
+
+		if (ImGui::Button("Reset Peak"))
+			mTweenService->resetPeakCount();
+
+		// record tween lifecycles, open the written file in chrome://tracing or ui.perfetto.dev
+		bool tracing = mTweenService->isTracing();
+		if (ImGui::Checkbox("Record Trace", &tracing))
+		{
+			if (tracing)
+				mTweenService->startTrace();
+			else
+				mTweenService->stopTrace();
+		}
+
+		if (mTweenService->getTrace() != nullptr)
+		{
+			ImGui::SameLine();
+			if (ImGui::Button("Write Trace"))
+			{
+				utility::ErrorState trace_error;
+				if (mTweenService->writeTrace("tween_trace.json", trace_error))
+					nap::Logger::info("Trace written to: tween_trace.json");
+				else
+					nap::Logger::error("TweenApp::drawStats: %s", trace_error.toString().c_str());
+			}
+		}
+	}
+
+
 	void TweenApp::createTween(const glm::vec3& pos)
 	{
 		// get the sphere transformation
@@ -167,37 +246,44 @@ namespace nap
 		// get the current sphere position in world coordinates
 		glm::vec3 sphere_position = math::extractPosition(sphere_transform.getGlobalTransform());
 
-		// create a tween and store the handle
-        utility::ErrorState tween_error;
-		mMovementTweenHandle = mTweenService->createTween<glm::vec3>(sphere_position, pos, mTweenDuration, tween_error, (ETweenEaseType)mCurrentTweenType, (ETweenMode)mCurrentTweenMode);
-        if(tween_error.hasErrors())
-        {
-            nap::Logger::error("TweenApp::createTween: %s", tween_error.toString().c_str());
-            return;
-        }
+		// a moving sphere is retargeted, it heads for the new position without losing its speed
+		utility::ErrorState tween_error;
+		if (mMovementTweenHandle != nullptr && (ETweenMode)mCurrentTweenMode == ETweenMode::NORMAL)
+		{
+			mMovementTweenHandle->getTween().retarget(pos, mTweenDuration);
+		}
+		else
+		{
+			// create a tween and store the handle
+			mMovementTweenHandle = mTweenService->createTween<glm::vec3>(sphere_position, pos, mTweenDuration, tween_error, (ETweenEaseType)mCurrentTweenType, (ETweenMode)mCurrentTweenMode);
+			if(tween_error.hasErrors())
+			{
+				nap::Logger::error("TweenApp::createTween: %s", tween_error.toString().c_str());
+				return;
+			}
 
-		// get reference to tween from tween handle
-		Tween<glm::vec3>& movement_tween = mMovementTweenHandle->getTween();
+			// get reference to tween from tween handle, the label identifies the tween in a trace
+			mMovementTweenHandle->setLabel("Sphere Movement");
+			Tween<glm::vec3>& movement_tween = mMovementTweenHandle->getTween();
 
-		// connect to update signal
-		movement_tween.UpdateSignal.connect([this](const glm::vec3& value) {
-		  auto& sphere_transform = mSphereEntity->getComponent<TransformComponentInstance>();
-		  sphere_transform.setTranslate(value);
-		});
+			// bind the tween to the translation of the sphere, the tween writes into the transform without a signal
+			movement_tween.bind<TransformComponentInstance, &TransformComponentInstance::setTranslate>(sphere_transform);
+		}
 
-		// animate the animation intensity uniform of the plane
-		mAnimationIntensity 	= 0.0f;
-		mAnimationTweenHandle	= mTweenService->createTween<float>(0.0f, 1.0f, 0.5f, tween_error, ETweenEaseType::CIRC_OUT);
+		// animate the animation intensity uniform of the plane, the tween is recycled when it completes
+		// stop the previous animation, nothing happens when it already completed
+		mTweenService->kill(mAnimationTween);
+		mAnimationIntensity = 0.0f;
+		mAnimationTween = mTweenService->play<float>(0.0f, 1.0f, 0.5f, tween_error, ETweenEaseType::CIRC_OUT);
         if(tween_error.hasErrors())
         {
             nap::Logger::error("TweenApp::createTween: %s", tween_error.toString().c_str());
             return;
         }
 
-		mAnimationTweenHandle->getTween().UpdateSignal.connect([this](const float& value)
-		{
-			mAnimationIntensity = value;
-		});
+		// bind the tween to the animation intensity
+		mTweenService->setLabel(mAnimationTween, "Plane Animation");
+		mTweenService->getTween<float>(mAnimationTween)->bind(&mAnimationIntensity);
 	}
 
 	/**
@@ -330,7 +416,8 @@ namespace nap
 			if (utility::intersect(cam_pos, screen_to_world_ray, tri_vertices, bary_coord))
 			{
 				TriangleData<glm::vec3> uv_triangle_data = triangle.getVertexData(uvs);
-				mAnimationPos = utility::interpolateVertexAttr<glm::vec3>(uv_triangle_data, bary_coord);
+				glm::vec3 uv = utility::interpolateVertexAttr<glm::vec3>(uv_triangle_data, bary_coord);
+				mAnimationPosSpring->getTween().setTarget(glm::vec2(uv.x, uv.y));
 
 				// use bary centric coordinates to find world position
 				glm::vec3 world_pos = (tri_vertices[0] * (1.0f - bary_coord.x - bary_coord.y)) + (tri_vertices[1] * bary_coord.x) + (tri_vertices[2] * bary_coord.y);
@@ -345,6 +432,7 @@ namespace nap
 
 	int TweenApp::shutdown()
 	{
+		mAnimationPosSpring = nullptr;
 		return 0;
 	}
 }
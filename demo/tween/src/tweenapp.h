@@ -17,6 +17,8 @@
 #include <app.h>
 #include <spheremesh.h>
 #include <tweenhandle.h>
+#include <tweenservice.h>
+#include <array>
 
 namespace nap
 {
@@ -80,6 +82,11 @@ namespace nap
 		 */
 		void createTween(const glm::vec3& pos);
 
+		/**
+		 * Draws the statistics of the tween service of the last update
+		 */
+		void drawStats();
+
 		// Nap Services
 		RenderService* mRenderService = nullptr;						//< Render Service that handles render calls
 		ResourceManager* mResourceManager = nullptr;					//< Manages all the loaded resources
@@ -98,8 +105,13 @@ namespace nap
 		ETweenEaseType mCurrentTweenType = ETweenEaseType::CUBIC_OUT;		//< Tween ease type
 		ETweenMode mCurrentTweenMode = ETweenMode::NORMAL;				//< Tween mode
 		std::unique_ptr<TweenHandle<glm::vec3>> mMovementTweenHandle; 	//< Handle of tween of sphere movement
-		std::unique_ptr<TweenHandle<float>> 	mAnimationTweenHandle; 	//< Handle of animation tween of plane shader
+		TweenPlayID mAnimationTween;									//< Fire and forget animation tween of plane shader
 		float mAnimationIntensity = 0.0f;								//< Handle of animation intensity, used in plane shader
 		glm::vec2 mAnimationPos = { 0.0f, 0.0f };				//< Animation position in UV space, used in plane shader
+		std::unique_ptr<SpringTweenHandle<glm::vec2>> mAnimationPosSpring;	//< Spring that moves the animation position to the pointer
+
+		// Tween statistics
+		std::array<float, 120> mUpdateTimes = {};						//< Tween update time in milliseconds of the last frames
+		int mUpdateTimeIndex = 0;										//< Index of the oldest update time in mUpdateTimes
 	};
 }
\ No newline at end of file
@@ -0,0 +1,17 @@
+# Heap allocation counter shared by the benchmark and the tests, replaces the global operator new
+set(ALLOCATION_COUNTER_SOURCES ${CMAKE_CURRENT_LIST_DIR}/test/src/tweenallocationcounter.cpp ${CMAKE_CURRENT_LIST_DIR}/test/src/tweenallocationcounter.h)
+
+# Headless benchmark of the tween service hot paths, built alongside mod_naptween
+# Writes its results as JSON, see benchmark/src/main.cpp for the available arguments
+file(GLOB BENCHMARK_SOURCES ${CMAKE_CURRENT_LIST_DIR}/benchmark/src/*.cpp ${CMAKE_CURRENT_LIST_DIR}/benchmark/src/*.h)
+add_executable(naptweenbenchmark ${BENCHMARK_SOURCES} ${ALLOCATION_COUNTER_SOURCES})
+target_include_directories(naptweenbenchmark PRIVATE ${CMAKE_CURRENT_LIST_DIR}/test/src)
+target_link_libraries(naptweenbenchmark mod_naptween)
+set_target_properties(naptweenbenchmark PROPERTIES FOLDER Benchmarks)
+
+# Headless tests of the tween module, exits with a non zero code when a check fails
+file(GLOB TEST_SOURCES ${CMAKE_CURRENT_LIST_DIR}/test/src/*.cpp ${CMAKE_CURRENT_LIST_DIR}/test/src/*.h)
+add_executable(naptweentest ${TEST_SOURCES})
+target_link_libraries(naptweentest mod_naptween)
+set_target_properties(naptweentest PROPERTIES FOLDER Tests)
+add_test(NAME naptweentest COMMAND naptweentest)
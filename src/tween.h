@@ -7,6 +7,7 @@
  // internal includes
 #include "tweeneasing.h"
 #include "tweenmode.h"
+#include "tweenpool.h"
 
 // external includes
 #include <mathutils.h>
@@ -22,6 +23,7 @@ namespace nap
 
 	/**
 	 * Base class of every tween
+	 * Holds the id of the tween in its pool
 	 */
 	class NAPAPI TweenBase
 	{
@@ -39,10 +41,15 @@ namespace nap
 		virtual ~TweenBase() = default;
 
 		/**
-		 * Update function called by tween service
-		 * @param deltaTime
+		 * Tweens are not copyable
 		 */
-		virtual void update(double deltaTime) = 0;
+		TweenBase(const TweenBase&) = delete;
+		TweenBase& operator=(const TweenBase&) = delete;
+
+		/**
+		 * @return id of the tween in its pool
+		 */
+		TweenID getID() const								{ return mID; }
 	public:
 		// signals
 
@@ -51,30 +58,58 @@ namespace nap
 		 */
 		Signal<> KilledSignal;
 	protected:
-		// killed boolean
-		bool 	mKilled = false;
+		// id of the tween in the pool
+		TweenID 		mID;
+	};
 
-		// complete boolean
-		bool 	mComplete = false;
+	/**
+	 * Signal of a tween that tells the pool when a handler is connected.
+	 * The pool only records events for tweens that have a handler, a tween without handlers costs nothing to signal.
+	 * @tparam T the type of value that is tweened
+	 * @tparam Owner the tween that owns the signal, notified through its listen() function
+	 */
+	template<typename T, typename Owner = Tween<T>>
+	class TweenSignal : public Signal<const T&>
+	{
+	public:
+		/**
+		 * Constructor
+		 * @param tween the tween that owns this signal
+		 */
+		TweenSignal(Owner& tween) : mTween(tween)			{ }
+
+		/**
+		 * Connects a slot, function or signal, see Signal::connect
+		 */
+		template<typename... Args>
+		void connect(Args&&... args);
+	private:
+		Owner& mTween;
 	};
 
+
 	/**
 	 * A Tween is responsible for interpolating between two values over the period of a certain time using an easing method ( see : https://github.com/jesusgollonet/ofpennereasing )
 	 * A Tween can be created by the user in which case the user is responsible for updating and managing the tween.
 	 * A Tween can also be created by the TweenService
-	 * When the Tween is created by the TweenService, the service retains the unique pointers to the Tween and gives back a tween handle to the user
+	 * When the Tween is created by the TweenService, the service retains the Tween and gives back a tween handle to the user
 	 * When the Tween is created by the TweenService, the tween will receive update calls from the service, which is the main thread
 	 * this update call happens before the update call on components and application
+	 * The state of the tween ( time, duration, values, mode and ease ) is stored in a TweenPool, the Tween is a view onto its slot in that pool
 	 * You can tween any type that supports arithmetic operators
 	 * Please note that when the tween is created by the TweenService, it can ONLY be accessible outside the TweenService by using the TweenHandle
+	 * To fix the ease at compile time, declare the tween with an ease tag, for example: Tween<glm::vec3, EaseOutCubic>
 	 * @tparam T the type of value that you would like to tween
 	 */
 	template<typename T>
-	class Tween : public TweenBase
+	class Tween<T, void> : public TweenBase
 	{
+		friend class TweenPool<T>;
+		friend class TweenSignal<T>;
 	public:
 		/**
 		 * Constructor taking the initial start & end value of the tween, plus duration
+		 * Creates a tween that is managed by the user, call update() to advance it
 		 * @param start start value of the tween
 		 * @param end end value of the tween
 		 * @param duration duration of the tween
@@ -82,10 +117,10 @@ namespace nap
 		Tween(T start, T end, float duration);
 
 		/**
-		 * update function called by the TweenService
+		 * update function, only available when the tween is managed by the user
 		 * @param deltaTime
 		 */
-		void update(double deltaTime) override;
+		void update(double deltaTime);
 
 		/**
 		 * set easing method used for tweening
@@ -95,56 +130,187 @@ namespace nap
 
 		/**
 		 * sets the tween mode for this tween, see ETweenMode enum
+		 * a completed tween wakes up when switched to LOOP or PING_PONG
 		 * @param mode
 		 */
 		void setMode(ETweenMode mode);
 
 		/**
 		 * set the duration for this tween
-		 * also changes mTime of this tween, to ensure smooth tweening
+		 * also scales the time of this tween within its current cycle, to ensure smooth tweening
+		 * a completed tween wakes up when it isn't finished at the new duration
 		 * asserts when duration < 0.0f
 		 */
 		void setDuration(float duration);
 
 		/**
-		 * restart the tween
+		 * restart the tween, wakes the tween when it completed
+		 * when the tween has a delay, it waits for the delay again
 		 */
 		void restart();
 
+		/**
+		 * Moves the tween from its current value to a new end value, without a jump in position or velocity.
+		 * The tween starts over in NORMAL mode and keeps its ease, slot, signal connections and output binding.
+		 * The difference between the current velocity and the start of the ease is blended out over the new duration,
+		 * eases that start vertically ( CIRC_OUT ) don't preserve the velocity.
+		 * Cancels a pending delay
+		 * @param end the new end value
+		 * @param duration the new duration in seconds
+		 */
+		void retarget(const T& end, float duration)			{ mPool->retarget(mID.mSlot, end, duration); }
+
+		/**
+		 * @return rate of change of the tween value per second, zero when the tween is completed or waits for its delay
+		 */
+		T getVelocity() const								{ return mPool->getVelocity(mID.mSlot); }
+
+		/**
+		 * Moves the tween to the given time since its start, in O(1) for every mode
+		 * The current value and output binding are updated immediately, no signal is dispatched
+		 * A NORMAL or REVERSE tween moved past its duration completes on the next update
+		 * Cancels a pending delay
+		 * @param time time since the start of the tween in seconds
+		 */
+		void seek(double time)								{ mPool->seek(mID.mSlot, time); }
+
+		/**
+		 * Evaluates the tween at the given time since its start, in O(1) for every mode, without changing its state
+		 * @param time time since the start of the tween in seconds
+		 * @return value of the tween at the given time
+		 */
+		T evaluateAt(double time) const						{ return mPool->evaluateAt(mID.mSlot, time); }
+
+		/**
+		 * pauses or resumes the tween, a paused tween is dormant and costs nothing to update
+		 * @param paused if the tween is paused
+		 */
+		void setPaused(bool paused)							{ mPool->setPaused(mID.mSlot, paused); }
+
+		/**
+		 * @return if the tween is paused
+		 */
+		bool isPaused() const								{ return (bucket().mFlags[index()] & TweenPool<T>::EFlags::Paused) != 0; }
+
+		/**
+		 * restarts the tween after the given delay, the tween is dormant until the delay expires
+		 * restarting the tween waits for the delay again
+		 * @param delay time to wait in seconds
+		 */
+		void setDelay(float delay);
+
+		/**
+		 * @return time the tween waits before it starts
+		 */
+		float getDelay() const								{ return mPool->mSlots[mID.mSlot].mDelay; }
+
+		/**
+		 * @return if the tween is evaluated every update, false when the tween is completed, paused or delayed
+		 */
+		bool isActive() const								{ return index() < bucket().mActive; }
+
 		/**
 		 * @return current tween mode
 		 */
-		ETweenMode getMode() const { return mMode; }
+		ETweenMode getMode() const							{ return bucket().mMode; }
 
 		/**
 		 * @return current ease type
 		 */
-		ETweenEaseType getEase() const { return mEasing; }
+		ETweenEaseType getEase() const						{ return bucket().mEasing; }
 
 		/**
-		 * @return current time in time
+		 * @return current time of the tween within its current cycle, 0 - duration
 		 */
-		float getTime() const { return mTime; }
+		float getTime() const								{ return mPool->getTime(mID.mSlot); }
+
+		/**
+		 * LOOP and PING_PONG tweens move their start forward by whole cycles every update, their elapsed time
+		 * restarts every cycle and stays below the duration, or twice the duration for PING_PONG tweens.
+		 * @return time since the start of the tween in seconds, or since the start of the current cycle when looping
+		 */
+		double getElapsedTime() const						{ return std::max(mPool->getElapsed(mID.mSlot), 0.0); }
 
 		/**
 		 * @return duration of tween
 		 */
-		float getDuration() const { return mDuration; }
+		float getDuration() const							{ return bucket().mDuration[index()]; }
 
 		/**
-		 * @return current tweened value
+		 * @return current tweened value, computed on first access every update when the tween is lazy
 		 */
-		const T& getCurrentValue() const { return mCurrentValue; }
+		const T& getCurrentValue() const					{ return mPool->getCurrentValue(mID.mSlot); }
 
 		/**
 		 * @return start value
 		 */
-		const T& getStartValue() const { return mStart; }
+		const T& getStartValue() const						{ return bucket().mStart[index()]; }
 
 		/**
 		 * @return end value
 		 */
-		const T& getEndValue() const { return mEnd; }
+		const T& getEndValue() const						{ return bucket().mEnd[index()]; }
+
+		/**
+		 * @return if the ease of this tween is fixed at compile time
+		 */
+		bool hasFixedEase() const							{ return mPool->mSlots[mID.mSlot].mFixedEase; }
+
+		/**
+		 * Writes the value of the tween into the given memory location every update, without dispatching a signal.
+		 * The target must outlive the tween or be unbound. Destroying the handle of the tween unbinds it.
+		 * When the service updates in parallel, the target is written on a worker thread.
+		 * @param target the memory location to write to
+		 */
+		void bind(T* target);
+
+		/**
+		 * Calls an accessor of an object with the value of the tween every update, without dispatching a signal.
+		 * For example: tween.bind<TransformComponentInstance, &TransformComponentInstance::setTranslate>(transform)
+		 * The object must outlive the tween or be unbound. Destroying the handle of the tween unbinds it.
+		 * When the service updates in parallel, the accessor is called on a worker thread.
+		 * @param object the object to call the accessor on
+		 * @tparam Object the type of object
+		 * @tparam Setter the member function that receives the value
+		 */
+		template<typename Object, void (Object::*Setter)(const T&)>
+		void bind(Object& object);
+
+		/**
+		 * Removes the output binding of the tween
+		 */
+		void unbind()										{ mPool->unbind(mID); }
+
+		/**
+		 * @return if the output of the tween is bound
+		 */
+		bool isBound() const								{ return bucket().mBindings[index()].mTarget != nullptr; }
+
+		/**
+		 * Makes the tween lazy: every update only checks if the tween completed, its value is computed when read.
+		 * Use for tweens that are read rarely or at a lower rate than the update rate.
+		 * A lazy tween with an output binding or a handler connected to its UpdateSignal is evaluated every update.
+		 * The CompleteSignal is dispatched in the same update as when the tween isn't lazy.
+		 * @param lazy if the tween is lazy
+		 */
+		void setLazy(bool lazy)								{ mPool->setLazy(mID.mSlot, lazy); }
+
+		/**
+		 * @return if the tween is lazy, see setLazy()
+		 */
+		bool isLazy() const									{ return mPool->mSlots[mID.mSlot].mLazy; }
+
+		/**
+		 * @return if the value of the tween is computed when read instead of every update
+		 */
+		bool isEvaluatedLazily() const						{ return bucket().mLazy; }
+
+		/**
+		 * Moves the tween to a group, the tween follows the time scale and paused state of the group from now on.
+		 * The tween continues at its current time. The group must be created by the service that created the tween.
+		 * @param group the group, nullptr to follow the clock of the service
+		 */
+		void setGroup(const TweenGroup* group)				{ mPool->setGroup(mID.mSlot, group); }
 	public:
 		// Signals
 
@@ -152,45 +318,89 @@ namespace nap
 		 * Update signal dispatched on value update
 		 * Occurs on main thread
 		 */
-		Signal<const T&> UpdateSignal;
+		TweenSignal<T> UpdateSignal { *this };
 
 		/**
 		 * Complete signal dispatched when tween is finished
 		 * Always dispatched on main thread
 		 */
-		Signal<const T&> CompleteSignal;
-	private:
+		TweenSignal<T> CompleteSignal { *this };
+	protected:
+		/**
+		 * Constructor used by the pool
+		 * @param pool the pool that owns this tween
+		 */
+		Tween(TweenPool<T>& pool);
 
 		/**
-		 * unique ptr to current easing method
+		 * Constructor of a tween that is managed by the user
+		 * @param start start value of the tween
+		 * @param end end value of the tween
+		 * @param duration duration of the tween
+		 * @param easing the ease type
+		 * @param fixedEase if the ease can't be changed
+		 */
+		Tween(T start, T end, float duration, ETweenEaseType easing, bool fixedEase);
+	private:
+		/**
+		 * @return bucket the tween is stored in
 		 */
-		std::unique_ptr<TweenEaseBase<T>> mEase = nullptr;
+		typename TweenPool<T>::Bucket& bucket() const		{ return *mPool->mBuckets[mPool->mSlots[mID.mSlot].mBucket]; }
 
 		/**
-		 * holds update function, update function is dependent on current tween mode
+		 * @return index of the tween in its bucket
 		 */
-		std::function<void(double)> mUpdateFunc;
+		uint32 index() const								{ return mPool->mSlots[mID.mSlot].mIndex; }
 
-		// current time
-		float 			mTime = 0.0f;
+		/**
+		 * Called when a handler connects to one of the signals, from now on the pool records events for this tween
+		 * @param signal the signal the handler connected to
+		 */
+		void listen(const TweenSignal<T>& signal)			{ mPool->listen(mID.mSlot, &signal == &UpdateSignal); }
 
-		// start value
-		T 				mStart;
+		// pool the tween state is stored in
+		TweenPool<T>* 					mPool = nullptr;
 
-		// end value
-		T				mEnd;
+		// pool owned by this tween when managed by the user
+		std::unique_ptr<TweenPool<T>> 	mOwnedPool = nullptr;
+	};
 
-		// current value
-		T 				mCurrentValue;
 
-		// duration
-		float 			mDuration;
+	/**
+	 * A Tween with an ease that is fixed at compile time, for example: Tween<glm::vec3, EaseOutCubic>
+	 * The ease can't be changed, the pool evaluates it without any indirect call
+	 * @tparam T the type of value that you would like to tween
+	 * @tparam Ease the ease tag, see tweeneasing.h
+	 */
+	template<typename T, typename Ease>
+	class Tween : public Tween<T, void>
+	{
+		friend class TweenPool<T>;
+	public:
+		/**
+		 * Constructor taking the initial start & end value of the tween, plus duration
+		 * Creates a tween that is managed by the user, call update() to advance it
+		 * @param start start value of the tween
+		 * @param end end value of the tween
+		 * @param duration duration of the tween
+		 */
+		Tween(T start, T end, float duration) : Tween<T, void>(start, end, duration, Ease::type, true)	{ }
 
-		// tween mode
-		ETweenMode 		mMode = ETweenMode::NORMAL;
+		/**
+		 * The ease is fixed at compile time
+		 */
+		void setEase(ETweenEaseType easing) = delete;
 
-		// ease type
-		ETweenEaseType 	mEasing = ETweenEaseType::LINEAR;
+		/**
+		 * @return the ease type
+		 */
+		static constexpr ETweenEaseType getEase()			{ return Ease::type; }
+	private:
+		/**
+		 * Constructor used by the pool
+		 * @param pool the pool that owns this tween
+		 */
+		Tween(TweenPool<T>& pool) : Tween<T, void>(pool)	{ }
 	};
 
 
@@ -208,216 +418,144 @@ namespace nap
 	//////////////////////////////////////////////////////////////////////////
 	template<typename T>
 	Tween<T>::Tween(T start, T end, float duration)
-		: TweenBase(), mStart(start), mEnd(end), mCurrentValue(start), mDuration(duration)
-	{
-		setEase(ETweenEaseType::LINEAR);
-		setMode(ETweenMode::NORMAL);
+		: Tween(start, end, duration, ETweenEaseType::LINEAR, false)
+	{ }
+
 
-		// when this tween is killed, update function doesn't do anything anymore
-		KilledSignal.connect([this] {
-			mUpdateFunc = [this](double deltaTime) {};
-			});
+	template<typename T>
+	Tween<T>::Tween(T start, T end, float duration, ETweenEaseType easing, bool fixedEase)
+		: TweenBase(), mOwnedPool(std::make_unique<TweenPool<T>>())
+	{
+		mPool = mOwnedPool.get();
+		mID = mPool->add(this, start, end, duration, easing, ETweenMode::NORMAL, fixedEase);
 	}
 
+
+	template<typename T>
+	Tween<T>::Tween(TweenPool<T>& pool)
+		: TweenBase(), mPool(&pool)
+	{ }
+
+
 	template<typename T>
 	void Tween<T>::update(double deltaTime)
 	{
-		mUpdateFunc(deltaTime);
+		assert(mOwnedPool != nullptr); // tween is updated by the service
+		mOwnedPool->update(deltaTime);
 	}
 
+
 	template<typename T>
 	void Tween<T>::setDuration(float duration)
 	{
 		assert(duration >= 0.0f); // invalid duration
 
-		// when duration is bigger then 0, scale time accordingly to ensure smooth transition
-		if (duration > 0.0f)
-		{
-			float current_progress = mTime / mDuration;
-			mDuration = duration;
-			mTime = mDuration * current_progress;
-		}
-		else
-		{
-			// when duration is 0, it doesn't matter since we will hit complete in next update
-			mDuration = duration;
-			mTime = 0.0f;
-		}
+		auto& entry = bucket();
+		uint32 idx = index();
+		float& current_duration = entry.mDuration[idx];
+
+		// scale the time within the current cycle accordingly to ensure smooth transition,
+		// when duration is 0 it doesn't matter since we will hit complete in next update
+		double elapsed = mPool->getElapsed(mID.mSlot);
+		double time = TweenPool<T>::getCycleTime(getMode(), elapsed, current_duration);
+		time = duration > 0.0f && current_duration > 0.0f ? time * (duration / current_duration) : 0.0;
+		current_duration = duration;
+
+		// a delayed tween keeps waiting
+		if (elapsed >= 0.0)
+			mPool->setElapsed(mID.mSlot, time);
+
+		// wake the tween when there's time left
+		if (time < current_duration)
+			entry.mFlags[idx] &= ~TweenPool<T>::EFlags::Complete;
+		mPool->refresh(mID.mSlot);
 	}
 
+
 	template<typename T>
 	void Tween<T>::setMode(ETweenMode mode)
 	{
-		mMode = mode;
-
-		switch (mode)
+		if (static_cast<uint32>(mode) >= tweenModeCount)
 		{
-		default:
 			nap::Logger::warn("Unknown tween mode, choosing NORMAL mode");
-		case NORMAL:
-		{
-			mUpdateFunc = [this](double deltaTime)
-			{
-				if (!mComplete)
-				{
-					mTime += deltaTime;
-
-					if (mTime >= mDuration)
-					{
-						mTime = mDuration;
-						mComplete = true;
-
-						mCurrentValue = mEase->evaluate(mStart, mEnd, mTime / mDuration);
-
-						UpdateSignal.trigger(mCurrentValue);
-						CompleteSignal.trigger(mCurrentValue);
-					}
-					else
-					{
-						mCurrentValue = mEase->evaluate(mStart, mEnd, mTime / mDuration);
-						UpdateSignal.trigger(mCurrentValue);
-					}
-				}
-			};
-		}
-		break;
-		case PING_PONG:
-		{
-			float direction = 1.0f;
-			mUpdateFunc = [this, direction](double deltaTime) mutable
-			{
-				mTime += deltaTime * direction;
-
-				if (mTime >= mDuration)
-				{
-					mTime = mDuration - (mTime - mDuration);
-					direction = -1.0f;
-
-					mCurrentValue = mEase->evaluate(mStart, mEnd, mTime / mDuration);
-					UpdateSignal.trigger(mCurrentValue);
-				}
-				else if (mTime <= 0.0f)
-				{
-					mTime = -mTime;
-					direction = 1.0f;
-
-					mCurrentValue = mEase->evaluate(mStart, mEnd, mTime / mDuration);
-					UpdateSignal.trigger(mCurrentValue);
-				}
-				else
-				{
-					mCurrentValue = mEase->evaluate(mStart, mEnd, mTime / mDuration);
-					UpdateSignal.trigger(mCurrentValue);
-				}
-			};
-		}
-		break;
-		case LOOP:
-		{
-			mUpdateFunc = [this](double deltaTime)
-			{
-				if (!mComplete)
-				{
-					mTime += deltaTime;
-
-					if (mTime >= mDuration)
-					{
-						mTime = mDuration - mTime;
-
-						mCurrentValue = mEase->evaluate(mStart, mEnd, mTime / mDuration);
-						UpdateSignal.trigger(mCurrentValue);
-					}
-					else
-					{
-						mCurrentValue = mEase->evaluate(mStart, mEnd, mTime / mDuration);
-						UpdateSignal.trigger(mCurrentValue);
-					}
-				}
-			};
-		}
-		break;
-		case REVERSE:
-		{
-			mUpdateFunc = [this](double deltaTime)
-			{
-				if (!mComplete)
-				{
-					mTime += deltaTime;
-
-					if (mTime >= mDuration)
-					{
-						mComplete = true;
-						mTime = mDuration;
-
-						mCurrentValue = mEase->evaluate(mStart, mEnd, 1.0f - (mTime / mDuration));
-
-						UpdateSignal.trigger(mCurrentValue);
-						CompleteSignal.trigger(mCurrentValue);
-					}
-					else
-					{
-						mCurrentValue = mEase->evaluate(mStart, mEnd, 1.0f - (mTime / mDuration));
-						UpdateSignal.trigger(mCurrentValue);
-					}
-				}
-			};
-		}
-		break;
+			mode = ETweenMode::NORMAL;
 		}
+
+		// changing mode always starts travelling forward from the current time, looping tweens never complete
+		double elapsed = mPool->getElapsed(mID.mSlot);
+		float time = getTime();
+		mPool->clearCorrection(mID.mSlot);
+		mPool->move(mID.mSlot, mode, getEase());
+		if (elapsed >= 0.0)
+			mPool->setElapsed(mID.mSlot, time);
+		if (mode == ETweenMode::LOOP || mode == ETweenMode::PING_PONG)
+			bucket().mFlags[index()] &= ~TweenPool<T>::EFlags::Complete;
+		mPool->refresh(mID.mSlot);
 	}
 
+
 	template<typename T>
 	void Tween<T>::restart()
 	{
-		mTime = 0.0f;
-		mComplete = false;
-		mKilled = false;
-		mCurrentValue = mStart;
+		auto& entry = bucket();
+		uint32 idx = index();
+		entry.mFlags[idx] &= ~TweenPool<T>::EFlags::Complete;
+		entry.mCurrent[idx] = entry.mStart[idx];
+		mPool->clearCorrection(mID.mSlot);
+		mPool->setElapsed(mID.mSlot, 0.0);
+		mPool->trace(ETweenTraceEvent::Restart, mID.mSlot);
+
+		if (getDelay() > 0.0f)
+			mPool->schedule(mID.mSlot);
+		else
+			mPool->refresh(mID.mSlot);
+	}
+
+
+	template<typename T>
+	void Tween<T>::setDelay(float delay)
+	{
+		assert(delay >= 0.0f); // invalid delay
+		mPool->mSlots[mID.mSlot].mDelay = delay;
+		bucket().mFlags[index()] &= ~TweenPool<T>::EFlags::Delayed;
+		restart();
+	}
+
+
+	template<typename T>
+	void Tween<T>::bind(T* target)
+	{
+		TweenBinding<T> binding;
+		binding.mTarget = target;
+		mPool->bind(mID, binding);
+	}
+
+
+	template<typename T>
+	template<typename Object, void (Object::*Setter)(const T&)>
+	void Tween<T>::bind(Object& object)
+	{
+		TweenBinding<T> binding;
+		binding.mTarget = &object;
+		binding.mSetter = [](void* target, const T& value) { (static_cast<Object*>(target)->*Setter)(value); };
+		mPool->bind(mID, binding);
+	}
+
+
+	template<typename T, typename Owner>
+	template<typename... Args>
+	void TweenSignal<T, Owner>::connect(Args&&... args)
+	{
+		Signal<const T&>::connect(std::forward<Args>(args)...);
+		mTween.listen(*this);
 	}
 
 
 	template<typename T>
 	void Tween<T>::setEase(ETweenEaseType easing)
 	{
-		static std::unordered_map<ETweenEaseType, std::function<std::unique_ptr<TweenEaseBase<T>>()>> ease_constructors
-		{
-			{ETweenEaseType::LINEAR, 		[]() { return std::make_unique<TweenEaseLinear<T>>(); 		}},
-			{ETweenEaseType::CUBIC_INOUT, 	[]() { return std::make_unique<TweenEaseOutCubic<T>>(); 	}},
-			{ETweenEaseType::CUBIC_OUT, 	[]() { return std::make_unique<TweenEaseOutCubic<T>>(); 	}},
-			{ETweenEaseType::CUBIC_IN, 		[]() { return std::make_unique<TweenEaseInCubic<T>>(); 		}},
-			{ETweenEaseType::BACK_OUT, 		[]() { return std::make_unique<TweenEaseOutBack<T>>(); 		}},
-			{ETweenEaseType::BACK_INOUT, 	[]() { return std::make_unique<TweenEaseInOutBack<T>>(); 	}},
-			{ETweenEaseType::BACK_IN, 		[]() { return std::make_unique<TweenEaseInBack<T>>(); 		}},
-			{ETweenEaseType::BOUNCE_OUT, 	[]() { return std::make_unique<TweenEaseOutBounce<T>>(); 	}},
-			{ETweenEaseType::BOUNCE_INOUT, 	[]() { return std::make_unique<TweenEaseInOutBounce<T>>(); 	}},
-			{ETweenEaseType::BOUNCE_IN, 	[]() { return std::make_unique<TweenEaseInBounce<T>>(); 	}},
-			{ETweenEaseType::CIRC_OUT,	 	[]() { return std::make_unique<TweenEaseOutCirc<T>>(); 		}},
-			{ETweenEaseType::CIRC_INOUT, 	[]() { return std::make_unique<TweenEaseInOutCirc<T>>(); 	}},
-			{ETweenEaseType::CIRC_IN, 		[]() { return std::make_unique<TweenEaseInCirc<T>>(); 		}},
-			{ETweenEaseType::ELASTIC_OUT, 	[]() { return std::make_unique<TweenEaseOutElastic<T>>(); 	}},
-			{ETweenEaseType::ELASTIC_INOUT, []() { return std::make_unique<TweenEaseInOutElastic<T>>(); }},
-			{ETweenEaseType::ELASTIC_IN, 	[]() { return std::make_unique<TweenEaseInElastic<T>>(); 	}},
-			{ETweenEaseType::EXPO_OUT, 		[]() { return std::make_unique<TweenEaseOutExpo<T>>(); 		}},
-			{ETweenEaseType::EXPO_INOUT, 	[]() { return std::make_unique<TweenEaseInOutExpo<T>>(); 	}},
-			{ETweenEaseType::EXPO_IN, 		[]() { return std::make_unique<TweenEaseInExpo<T>>(); 		}},
-			{ETweenEaseType::QUAD_OUT, 		[]() { return std::make_unique<TweenEaseOutQuad<T>>(); 		}},
-			{ETweenEaseType::QUAD_INOUT, 	[]() { return std::make_unique<TweenEaseInOutQuad<T>>(); 	}},
-			{ETweenEaseType::QUAD_IN, 		[]() { return std::make_unique<TweenEaseInQuad<T>>(); 		}},
-			{ETweenEaseType::QUART_OUT, 	[]() { return std::make_unique<TweenEaseOutQuart<T>>(); 	}},
-			{ETweenEaseType::QUART_INOUT, 	[]() { return std::make_unique<TweenEaseInOutQuart<T>>(); 	}},
-			{ETweenEaseType::QUART_IN, 		[]() { return std::make_unique<TweenEaseInQuart<T>>(); 		}},
-			{ETweenEaseType::QUINT_OUT, 	[]() { return std::make_unique<TweenEaseOutQuint<T>>(); 	}},
-			{ETweenEaseType::QUINT_INOUT, 	[]() { return std::make_unique<TweenEaseInOutQuint<T>>(); 	}},
-			{ETweenEaseType::QUINT_IN, 		[]() { return std::make_unique<TweenEaseInQuint<T>>(); 		}},
-			{ETweenEaseType::SINE_OUT, 		[]() { return std::make_unique<TweenEaseOutSine<T>>(); 		}},
-			{ETweenEaseType::SINE_INOUT, 	[]() { return std::make_unique<TweenEaseInOutSine<T>>(); 	}},
-			{ETweenEaseType::SINE_IN, 		[]() { return std::make_unique<TweenEaseInSine<T>>(); 		}}
-		};
-
-		mEasing = easing;
-
-		auto constructor_it = ease_constructors.find(easing);
-		assert(constructor_it != ease_constructors.end()); // entry not found
-		mEase = constructor_it->second();
+		assert(!hasFixedEase()); // ease is fixed at compile time
+		mPool->clearCorrection(mID.mSlot);
+		mPool->move(mID.mSlot, getMode(), easing);
 	}
 }
@@ -0,0 +1,63 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "tweenbuffer.h"
+
+namespace nap
+{
+	BufferTween::BufferTween(const float* start, const float* end, float* output, uint32 count, float duration)
+		: TweenBase(), mOwnedPool(std::make_unique<BufferTweenPool>())
+	{
+		mPool = mOwnedPool.get();
+		mID = mPool->add(this, start, end, output, count, duration, ETweenEaseType::LINEAR, ETweenMode::NORMAL);
+	}
+
+
+	void BufferTween::update(double deltaTime)
+	{
+		assert(mOwnedPool != nullptr); // tween is updated by the service
+		mOwnedPool->update(deltaTime);
+	}
+
+
+	void BufferTween::setBuffers(const float* start, const float* end, float* output, uint32 count)
+	{
+		assert(count == 0 || (start != nullptr && end != nullptr && output != nullptr)); // missing buffer
+		assert(count == 0 || (output != start && output != end)); // output would be interpolated from itself
+		uint32 i = index();
+		mPool->mStart[i] = start;
+		mPool->mEnd[i] = end;
+		mPool->mOutput[i] = output;
+		mPool->mCount[i] = count;
+		mPool->apply(mID.mSlot);
+	}
+
+
+	void BufferTween::setMode(ETweenMode mode)
+	{
+		uint32 i = index();
+		mPool->mMode[i] = mode;
+		if (mode == ETweenMode::LOOP || mode == ETweenMode::PING_PONG)
+		{
+			mPool->mFlags[i] &= ~BufferTweenPool::EFlags::Complete;
+			mPool->refresh(mID.mSlot);
+		}
+	}
+
+
+	void BufferTween::setDuration(float duration)
+	{
+		assert(duration >= 0.0f); // invalid duration
+		uint32 i = index();
+		mPool->mDuration[i] = duration;
+
+		// wake when the tween didn't reach the new duration yet
+		double elapsed = mPool->mClocks->getTime(mPool->mGroup[i]) - mPool->mStartTime[i];
+		if (elapsed < duration)
+		{
+			mPool->mFlags[i] &= ~BufferTweenPool::EFlags::Complete;
+			mPool->refresh(mID.mSlot);
+		}
+	}
+}
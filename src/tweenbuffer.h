@@ -0,0 +1,163 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// internal includes
+#include "tween.h"
+#include "tweenbufferpool.h"
+
+// external includes
+#include <mathutils.h>
+#include <nap/signalslot.h>
+
+namespace nap
+{
+	//////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * A BufferTween interpolates a whole buffer of floats at once: blend shape weights, vertex positions or pixel colors.
+	 * The start, end and output buffers are owned by the user and must outlive the tween, the output is written in place,
+	 * for example into a mapped vertex attribute. The buffers of a vector type are tweened as a flat array of floats.
+	 * Every update the progress of the tween is eased once, after which the output is interpolated with a batch kernel,
+	 * no value is copied through a signal. When the service updates in parallel, large buffers are split into ranges
+	 * that are interpolated on different threads.
+	 * A BufferTween can be created by the user, call update() to advance it,
+	 * or by the TweenService with createBufferTween, the service updates it and returns a BufferTweenHandle.
+	 * The state of the tween is stored in a BufferTweenPool, the BufferTween is a view onto its slot in that pool
+	 */
+	class NAPAPI BufferTween : public TweenBase
+	{
+		friend class BufferTweenPool;
+		friend class TweenSignal<float, BufferTween>;
+	public:
+		/**
+		 * Constructor of a tween that is managed by the user, call update() to advance it.
+		 * The output is written right away.
+		 * @param start values at the start of the tween
+		 * @param end values at the end of the tween
+		 * @param output receives the interpolated values, must not alias start or end: both are read every update
+		 * @param count number of floats in every buffer
+		 * @param duration duration in seconds
+		 */
+		BufferTween(const float* start, const float* end, float* output, uint32 count, float duration);
+
+		/**
+		 * update function, only available when the tween is managed by the user
+		 * @param deltaTime time in seconds since last update
+		 */
+		void update(double deltaTime);
+
+		/**
+		 * Changes the buffers of the tween, keeps its progress and writes the output right away.
+		 * @param start values at the start of the tween
+		 * @param end values at the end of the tween
+		 * @param output receives the interpolated values, must not alias start or end: both are read every update
+		 * @param count number of floats in every buffer
+		 */
+		void setBuffers(const float* start, const float* end, float* output, uint32 count);
+
+		/**
+		 * @return number of floats in every buffer
+		 */
+		uint32 getCount() const								{ return mPool->mCount[index()]; }
+
+		/**
+		 * @return the buffer the interpolated values are written to
+		 */
+		float* getOutput() const							{ return mPool->mOutput[index()]; }
+
+		/**
+		 * set easing method used for tweening
+		 * @param easing the easing method
+		 */
+		void setEase(ETweenEaseType easing)					{ mPool->mEasing[index()] = easing; }
+
+		/**
+		 * @return the easing method
+		 */
+		ETweenEaseType getEase() const						{ return mPool->mEasing[index()]; }
+
+		/**
+		 * sets the tween mode, a completed tween wakes up when switched to LOOP or PING_PONG
+		 * @param mode the tween mode
+		 */
+		void setMode(ETweenMode mode);
+
+		/**
+		 * @return the tween mode
+		 */
+		ETweenMode getMode() const							{ return mPool->mMode[index()]; }
+
+		/**
+		 * set the duration of the tween, a completed tween wakes up when it isn't finished at the new duration
+		 * asserts when duration < 0.0f
+		 * @param duration duration in seconds
+		 */
+		void setDuration(float duration);
+
+		/**
+		 * @return duration in seconds
+		 */
+		float getDuration() const							{ return mPool->mDuration[index()]; }
+
+		/**
+		 * restart the tween, writes the output at the start of the tween and wakes the tween when it completed
+		 */
+		void restart()										{ mPool->restart(mID.mSlot); }
+
+		/**
+		 * @return eased progress of the tween at the last update
+		 */
+		float getProgress() const							{ return mPool->mProgress[index()]; }
+
+		/**
+		 * @return if the tween completed, looping and ping pong tweens never complete
+		 */
+		bool isComplete() const								{ return (mPool->mFlags[index()] & BufferTweenPool::EFlags::Complete) != 0; }
+
+		/**
+		 * Moves the tween to a group, the tween follows the time scale and paused state of the group from now on.
+		 * The group must be created by the service that created the tween.
+		 * @param group the group, nullptr to follow the clock of the service
+		 */
+		void setGroup(const TweenGroup* group)				{ mPool->setGroup(mID.mSlot, group); }
+	public:
+		// Signals
+
+		/**
+		 * Update signal dispatched with the eased progress after the output is written
+		 * Occurs on main thread
+		 */
+		TweenSignal<float, BufferTween> UpdateSignal { *this };
+
+		/**
+		 * Complete signal dispatched when the tween completes, the output holds the end values
+		 * Always dispatched on main thread
+		 */
+		TweenSignal<float, BufferTween> CompleteSignal { *this };
+	protected:
+		/**
+		 * Constructor used by the pool
+		 * @param pool the pool that owns this tween
+		 */
+		BufferTween(BufferTweenPool& pool) : TweenBase(), mPool(&pool)	{ }
+	private:
+		/**
+		 * @return index of the tween in the pool
+		 */
+		uint32 index() const								{ return mPool->mSlots[mID.mSlot].mIndex; }
+
+		/**
+		 * Called when a handler connects to one of the signals, from now on the pool records events for this tween
+		 */
+		void listen(const TweenSignal<float, BufferTween>&)	{ mPool->listen(mID.mSlot); }
+
+		// pool the tween state is stored in
+		BufferTweenPool* 					mPool = nullptr;
+
+		// pool owned by this tween when managed by the user
+		std::unique_ptr<BufferTweenPool> 	mOwnedPool = nullptr;
+	};
+}
@@ -0,0 +1,467 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "tweenbufferpool.h"
+#include "tweenbuffer.h"
+#include "tweensimd.h"
+
+// external includes
+#include <algorithm>
+#include <new>
+
+namespace nap
+{
+	BufferTweenPool::~BufferTweenPool()
+	{
+		for (auto& slot : mSlots)
+			destroy(slot);
+	}
+
+
+	void BufferTweenPool::reserve(size_t capacity)
+	{
+		if (capacity > mTweenSlots.capacity())
+		{
+			mStart.reserve(capacity);
+			mEnd.reserve(capacity);
+			mOutput.reserve(capacity);
+			mCount.reserve(capacity);
+			mDuration.reserve(capacity);
+			mEasing.reserve(capacity);
+			mMode.reserve(capacity);
+			mGroup.reserve(capacity);
+			mStartTime.reserve(capacity);
+			mProgress.reserve(capacity);
+			mFlags.reserve(capacity);
+			mTweenSlots.reserve(capacity);
+			mAllocations += arrayCount;
+		}
+		mSlots.reserve(capacity);
+		reserve(mEvents, capacity);
+		mTweenStorage.reserve(capacity);
+	}
+
+
+	BufferTween& BufferTweenPool::create(const float* start, const float* end, float* output, uint32 count, float duration, ETweenEaseType easing, ETweenMode mode)
+	{
+		BufferTween& ref = *new (mTweenStorage.allocate()) BufferTween(*this);
+		ref.mID = add(&ref, start, end, output, count, duration, easing, mode);
+		mSlots[ref.mID.mSlot].mOwned = true;
+		return ref;
+	}
+
+
+	TweenID BufferTweenPool::add(BufferTween* tween, const float* start, const float* end, float* output, uint32 count, float duration, ETweenEaseType easing, ETweenMode mode)
+	{
+		assert(duration >= 0.0f); // invalid duration
+		assert(count == 0 || (start != nullptr && end != nullptr && output != nullptr)); // missing buffer
+		assert(count == 0 || (output != start && output != end)); // output would be interpolated from itself
+
+		uint32 slot_index = mSlots.allocate();
+		Slot& slot = mSlots[slot_index];
+		track(mTweenSlots, arrayCount);
+		mStart.emplace_back(start);
+		mEnd.emplace_back(end);
+		mOutput.emplace_back(output);
+		mCount.emplace_back(count);
+		mDuration.emplace_back(duration);
+		mEasing.emplace_back(easing);
+		mMode.emplace_back(mode);
+		mGroup.emplace_back(TweenClocks::root);
+		mStartTime.emplace_back(mClocks->getTime(TweenClocks::root));
+		mProgress.emplace_back(0.0f);
+		mFlags.emplace_back(0);
+		mTweenSlots.emplace_back(slot_index);
+		mClocks->join(TweenClocks::root);
+
+		// new tweens are active, move the first dormant tween behind it
+		uint32 index = static_cast<uint32>(mTweenSlots.size() - 1);
+		slot.mIndex = index;
+		slot.mTween = tween;
+		slot.mOwned = false;
+		slot.mLabel = nullptr;
+		refresh(slot_index);
+
+		// the output holds the start values before the first update
+		apply(slot_index);
+		trace(ETweenTraceEvent::Create, slot_index);
+		return { slot_index, slot.mGeneration };
+	}
+
+
+	void BufferTweenPool::remove(TweenID id)
+	{
+		if (!isValid(id))
+			return;
+
+		// notify listeners the tween is killed before it completed
+		const Slot& killed = mSlots[id.mSlot];
+		bool completed = (mFlags[killed.mIndex] & EFlags::Complete) != 0;
+		if (!mSlots.kill(id, *killed.mTween, completed))
+			return;
+		trace(ETweenTraceEvent::Kill, id.mSlot, completed);
+
+		// swap and pop, update the slot of the tween that took its place
+		Slot& entry = mSlots[id.mSlot];
+		mSlots.leave(id.mSlot, mGroup[entry.mIndex]);
+		mClocks->leave(mGroup[entry.mIndex]);
+		erase(entry.mIndex);
+
+		// release slot, invalidates all ids that refer to it
+		mSlots.release(id.mSlot);
+		destroy(entry);
+	}
+
+
+	void BufferTweenPool::killCancelled(const std::vector<uint32>& groups)
+	{
+		// collect first, handlers of the killed signal can create, change or remove tweens
+		const uint8* cancelled = mClocks->getCancelled();
+		for (uint32 group : groups)
+		{
+			if (!cancelled[group])
+				continue;
+
+			for (uint32 slot = mSlots.getFirstMember(group); slot != invalid; slot = mSlots.getNextMember(slot))
+			{
+				if (!(mFlags[mSlots[slot].mIndex] & EFlags::Complete))
+				{
+					track(mKilled);
+					mKilled.push_back({ slot, mSlots[slot].mGeneration });
+				}
+			}
+		}
+
+		// handlers might have completed, moved or removed the tween since it was collected
+		for (const auto& id : mKilled)
+		{
+			if (!isValid(id))
+				continue;
+
+			Slot& entry = mSlots[id.mSlot];
+			if (!mClocks->getCancelled()[mGroup[entry.mIndex]] || (mFlags[entry.mIndex] & EFlags::Complete))
+				continue;
+
+			// the output stays where it is, the kill is traced when the handle removes the tween
+			mFlags[entry.mIndex] |= EFlags::Complete;
+			refresh(id.mSlot);
+			trace(ETweenTraceEvent::Complete, id.mSlot);
+			entry.mTween->KilledSignal();
+		}
+		mKilled.clear();
+	}
+
+
+	void BufferTweenPool::destroy(Slot& slot)
+	{
+		BufferTween* tween = slot.mTween;
+		bool owned = slot.mOwned;
+		slot.mTween = nullptr;
+		slot.mOwned = false;
+		if (owned)
+		{
+			tween->~BufferTween();
+			mTweenStorage.release(tween);
+		}
+	}
+
+
+	bool BufferTweenPool::isValid(TweenID id) const
+	{
+		return mSlots.isValid(id);
+	}
+
+
+	BufferTween* BufferTweenPool::find(TweenID id) const
+	{
+		return isValid(id) ? mSlots[id.mSlot].mTween : nullptr;
+	}
+
+
+	void BufferTweenPool::erase(uint32 index)
+	{
+		// move an active tween to the front of the dormant set first
+		if (index < mActive)
+		{
+			mActive--;
+			swap(index, mActive);
+			index = mActive;
+		}
+
+		uint32 last = static_cast<uint32>(mTweenSlots.size() - 1);
+		if (index != last)
+		{
+			mStart[index] 		= mStart[last];
+			mEnd[index] 		= mEnd[last];
+			mOutput[index] 		= mOutput[last];
+			mCount[index] 		= mCount[last];
+			mDuration[index] 	= mDuration[last];
+			mEasing[index] 		= mEasing[last];
+			mMode[index] 		= mMode[last];
+			mGroup[index] 		= mGroup[last];
+			mStartTime[index] 	= mStartTime[last];
+			mProgress[index] 	= mProgress[last];
+			mFlags[index] 		= mFlags[last];
+			mTweenSlots[index] 	= mTweenSlots[last];
+			mSlots[mTweenSlots[index]].mIndex = index;
+		}
+
+		mStart.pop_back();
+		mEnd.pop_back();
+		mOutput.pop_back();
+		mCount.pop_back();
+		mDuration.pop_back();
+		mEasing.pop_back();
+		mMode.pop_back();
+		mGroup.pop_back();
+		mStartTime.pop_back();
+		mProgress.pop_back();
+		mFlags.pop_back();
+		mTweenSlots.pop_back();
+	}
+
+
+	void BufferTweenPool::swap(uint32 a, uint32 b)
+	{
+		if (a == b)
+			return;
+
+		std::swap(mStart[a], mStart[b]);
+		std::swap(mEnd[a], mEnd[b]);
+		std::swap(mOutput[a], mOutput[b]);
+		std::swap(mCount[a], mCount[b]);
+		std::swap(mDuration[a], mDuration[b]);
+		std::swap(mEasing[a], mEasing[b]);
+		std::swap(mMode[a], mMode[b]);
+		std::swap(mGroup[a], mGroup[b]);
+		std::swap(mStartTime[a], mStartTime[b]);
+		std::swap(mProgress[a], mProgress[b]);
+		std::swap(mFlags[a], mFlags[b]);
+		std::swap(mTweenSlots[a], mTweenSlots[b]);
+		mSlots[mTweenSlots[a]].mIndex = a;
+		mSlots[mTweenSlots[b]].mIndex = b;
+	}
+
+
+	void BufferTweenPool::refresh(uint32 slot)
+	{
+		uint32 index = mSlots[slot].mIndex;
+		bool active = index < mActive;
+		bool awake = (mFlags[index] & EFlags::Complete) == 0;
+
+		// a killed member of a cancelled group that is restarted is killed again
+		if (awake && mClocks->getCancelled()[mGroup[index]])
+			mClocks->queueKill(mGroup[index]);
+
+		if (awake && !active)
+		{
+			swap(index, mActive);
+			mActive++;
+		}
+		else if (!awake && active)
+		{
+			mActive--;
+			swap(index, mActive);
+		}
+	}
+
+
+	void BufferTweenPool::restart(uint32 slot)
+	{
+		uint32 index = mSlots[slot].mIndex;
+		mStartTime[index] = mClocks->getTime(mGroup[index]);
+		mFlags[index] &= ~EFlags::Complete;
+		refresh(slot);
+		apply(slot);
+	}
+
+
+	void BufferTweenPool::apply(uint32 slot)
+	{
+		// advancing without a completion event: the tween completes during the next update
+		uint32 index = mSlots[slot].mIndex;
+		uint8 flags = mFlags[index];
+		advance(index);
+		mFlags[index] = flags;
+		lerpBatch(mStart[index], mEnd[index], mProgress[index], mOutput[index], mCount[index]);
+	}
+
+
+	void BufferTweenPool::setGroup(uint32 slot, const TweenGroup* group)
+	{
+		assert(group == nullptr || &group->getClocks() == mClocks); // group belongs to another service
+		uint32 index = mSlots[slot].mIndex;
+		uint32 next = group != nullptr ? group->getIndex() : TweenClocks::root;
+		uint32 current = mGroup[index];
+		if (current == next)
+			return;
+
+		// keep the elapsed time, measured on the clock of the new group from now on
+		double elapsed = mClocks->getTime(current) - mStartTime[index];
+		mSlots.leave(slot, current);
+		mClocks->leave(current);
+		mSlots.join(slot, next);
+		mClocks->join(next);
+		mGroup[index] = next;
+		mStartTime[index] = mClocks->getTime(next) - elapsed;
+	}
+
+
+	void BufferTweenPool::listen(uint32 slot)
+	{
+		mFlags[mSlots[slot].mIndex] |= EFlags::Listening;
+	}
+
+
+	void BufferTweenPool::setLabel(TweenID id, const char* label)
+	{
+		if (isValid(id))
+			mSlots[id.mSlot].mLabel = label;
+	}
+
+
+	void BufferTweenPool::update(double deltaTime)
+	{
+		evaluate(deltaTime);
+		dispatch();
+	}
+
+
+	void BufferTweenPool::evaluate(double deltaTime)
+	{
+		beginUpdate(deltaTime);
+		mEvents.clear();
+		size_t capacity = mEvents.capacity();
+		for (uint32 i = 0; i < mActive; i++)
+		{
+			if (!(mFlags[i] & EFlags::Stopped))
+				updateRange(i, 0, mCount[i], mEvents);
+		}
+		mAllocations += mEvents.capacity() != capacity ? 1 : 0;
+		endUpdate();
+	}
+
+
+	void BufferTweenPool::beginUpdate(double deltaTime)
+	{
+		// the clocks of a service are advanced by the service
+		if (mClocks == &mOwnClocks)
+			mOwnClocks.advance(deltaTime);
+
+		// the ease is evaluated once per tween, the ranges of a buffer share it.
+		// tweens of a stopped group keep their output
+		const uint8* running = mClocks->getRunning();
+		for (uint32 i = 0; i < mActive; i++)
+		{
+			if (running[mGroup[i]])
+			{
+				mFlags[i] &= ~EFlags::Stopped;
+				advance(i);
+			}
+			else
+			{
+				mFlags[i] |= EFlags::Stopped;
+			}
+		}
+	}
+
+
+	void BufferTweenPool::advance(uint32 index)
+	{
+		double elapsed = mClocks->getTime(mGroup[index]) - mStartTime[index];
+		ETweenMode mode = mMode[index];
+		float duration = mDuration[index];
+		double cycle = TweenPool<float>::getCycleTime(mode, elapsed, duration);
+		mProgress[index] = evaluateTweenEase(mEasing[index], TweenPool<float>::getProgress(mode, cycle, duration));
+		if ((mode == ETweenMode::NORMAL || mode == ETweenMode::REVERSE) && elapsed >= duration)
+			mFlags[index] |= EFlags::Complete;
+	}
+
+
+	void BufferTweenPool::setClocks(TweenClocks& clocks)
+	{
+		assert(size() == 0); // tweens follow the clocks they were added with
+		mClocks = &clocks;
+	}
+
+
+	void BufferTweenPool::endUpdate()
+	{
+		for (uint32 i = 0; i < mActive;)
+		{
+			if (mFlags[i] & EFlags::Complete)
+			{
+				trace(ETweenTraceEvent::Complete, mTweenSlots[i]);
+				mActive--;
+				swap(i, mActive);
+			}
+			else
+			{
+				i++;
+			}
+		}
+	}
+
+
+	void BufferTweenPool::getRanges(uint32 maxSize, std::vector<TweenRange>& ranges)
+	{
+		assert(maxSize > 0);
+
+		// every tween has at least one range, even an empty buffer raises its signals
+		uint32 floats = maxSize * bufferTweenRangeScale;
+		for (uint32 i = 0; i < mActive; i++)
+		{
+			if (mFlags[i] & EFlags::Stopped)
+				continue;
+
+			uint32 count = mCount[i];
+			uint32 begin = 0;
+			do
+			{
+				uint32 end = count - begin > floats ? begin + floats : count;
+				ranges.push_back({ this, i, begin, end });
+				begin = end;
+			} while (begin < count);
+		}
+	}
+
+
+	void BufferTweenPool::updateRange(const TweenRange& range, std::vector<TweenEvent>& events)
+	{
+		assert(range.mPool == this);
+		updateRange(range.mBucket, range.mBegin, range.mEnd, events);
+	}
+
+
+	void BufferTweenPool::updateRange(uint32 index, uint32 begin, uint32 end, std::vector<TweenEvent>& events)
+	{
+		lerpBatch(mStart[index] + begin, mEnd[index] + begin, mProgress[index], mOutput[index] + begin, end - begin);
+		if (end == mCount[index] && (mFlags[index] & EFlags::Listening))
+		{
+			uint8 raised = EEvents::Updated;
+			if (mFlags[index] & EFlags::Complete)
+				raised |= EEvents::Completed;
+			events.push_back({ mTweenSlots[index], raised });
+		}
+	}
+
+
+	void BufferTweenPool::dispatch(const std::vector<TweenEvent>& events)
+	{
+		// handlers are allowed to create, change or remove tweens: resolve every event through its slot and copy the progress
+		for (const auto& event : events)
+		{
+			const Slot& entry = mSlots[event.mSlot];
+			if (entry.mTween == nullptr)
+				continue;
+
+			float progress = mProgress[entry.mIndex];
+			BufferTween& tween = *entry.mTween;
+			if (event.mEvents & EEvents::Updated)
+				tween.UpdateSignal.trigger(progress);
+			if (event.mEvents & EEvents::Completed)
+				tween.CompleteSignal.trigger(progress);
+		}
+	}
+}
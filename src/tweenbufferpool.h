@@ -0,0 +1,366 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// internal includes
+#include "tweenpool.h"
+#include "tweenstorage.h"
+
+// external includes
+#include <mathutils.h>
+#include <vector>
+
+namespace nap
+{
+	//////////////////////////////////////////////////////////////////////////
+
+	// forward declares
+	class BufferTween;
+
+	/**
+	 * A range of a buffer tween costs about as much to evaluate as a range of this many times fewer regular tweens,
+	 * the chunk size of the service is scaled by it to get the number of floats in a range
+	 */
+	constexpr uint32 bufferTweenRangeScale = 16;
+
+	/**
+	 * Stores all buffer tweens in contiguous arrays, see BufferTween.
+	 * The pool only stores the buffers a tween reads from and writes to, the memory is owned by the user.
+	 * Every update the progress of a tween is computed and eased once, after which the output buffer is interpolated in place with a batch kernel.
+	 * Large buffers are split into ranges of floats that are interpolated on different threads when the service updates in parallel.
+	 * Completed tweens are stored after the active tweens and cost nothing to update.
+	 * Like the TweenPool, a BufferTween is a view onto a slot in the pool, slots are reused and guarded by a generation counter.
+	 */
+	class NAPAPI BufferTweenPool : public TweenPoolBase
+	{
+		friend class BufferTween;
+	public:
+		/**
+		 * Constructor
+		 */
+		BufferTweenPool() = default;
+
+		/**
+		 * Deconstructor, deletes all tweens owned by the pool
+		 */
+		~BufferTweenPool() override;
+
+		/**
+		 * Makes sure the given number of tweens can be created without allocating memory
+		 * @param capacity number of tweens
+		 */
+		void reserve(size_t capacity);
+
+		/**
+		 * Constructs a new tween owned by the pool, the output is written right away
+		 * @param start values at the start of the tween
+		 * @param end values at the end of the tween
+		 * @param output receives the interpolated values, must not alias start or end: both are read every update
+		 * @param count number of floats in every buffer
+		 * @param duration duration in seconds
+		 * @param easing the ease type
+		 * @param mode the tween mode
+		 * @return the new tween
+		 */
+		BufferTween& create(const float* start, const float* end, float* output, uint32 count, float duration, ETweenEaseType easing, ETweenMode mode);
+
+		/**
+		 * Adds a tween that is owned by someone else to the pool, the output is written right away
+		 * @param tween the tween to add
+		 * @param start values at the start of the tween
+		 * @param end values at the end of the tween
+		 * @param output receives the interpolated values, must not alias start or end: both are read every update
+		 * @param count number of floats in every buffer
+		 * @param duration duration in seconds
+		 * @param easing the ease type
+		 * @param mode the tween mode
+		 * @return the id of the tween
+		 */
+		TweenID add(BufferTween* tween, const float* start, const float* end, float* output, uint32 count, float duration, ETweenEaseType easing, ETweenMode mode);
+
+		/**
+		 * Evaluates all tweens in the pool, dispatches signals afterwards
+		 * @param deltaTime time in seconds since last update
+		 */
+		void update(double deltaTime) override;
+
+		/**
+		 * Evaluates all tweens in the pool, the raised signals are dispatched by dispatch()
+		 * @param deltaTime time in seconds since last update
+		 */
+		void evaluate(double deltaTime) override;
+
+		/**
+		 * Dispatches the signals raised by the last call to evaluate()
+		 */
+		void dispatch() override					{ dispatch(mEvents); }
+
+		/**
+		 * Advances the clocks of the pool when it owns them and eases the progress of every active tween
+		 * @param deltaTime time in seconds since last update
+		 */
+		void beginUpdate(double deltaTime) override;
+
+		/**
+		 * Makes the pool follow the given group clocks instead of its own
+		 * @param clocks the clocks, advanced by their owner
+		 */
+		void setClocks(TweenClocks& clocks) override;
+
+		/**
+		 * Moves tweens that completed during the update to the dormant set
+		 */
+		void endUpdate() override;
+
+		/**
+		 * Splits the buffers of all active tweens into ranges that can be interpolated independently.
+		 * The bucket of a range is the index of the tween, begin and end are offsets in its buffers.
+		 * @param maxSize maximum number of regular tweens in a range, scaled by bufferTweenRangeScale
+		 * @param ranges the ranges to append to
+		 */
+		void getRanges(uint32 maxSize, std::vector<TweenRange>& ranges) override;
+
+		/**
+		 * Interpolates a range of a buffer without dispatching signals,
+		 * the range that ends the buffer raises the signals of the tween
+		 * @param range the range to interpolate
+		 * @param events receives the raised signals
+		 */
+		void updateRange(const TweenRange& range, std::vector<TweenEvent>& events) override;
+
+		/**
+		 * Dispatches signals raised by updateRange()
+		 * @param events the events to dispatch
+		 */
+		void dispatch(const std::vector<TweenEvent>& events) override;
+
+		/**
+		 * Buffer tweens write their output when they are added and never move a value by themselves, there is nothing to stage
+		 */
+		void beginStaging() override				{ }
+
+		/**
+		 * Buffer tweens are never staged, there is nothing to merge
+		 */
+		uint32 merge(bool) override					{ return 0; }
+
+		/**
+		 * Buffer tweens are never recycled, they are removed by their handle
+		 */
+		void recycle() override						{ }
+
+		/**
+		 * Completes every tween that didn't complete yet in the given cancelled groups and dispatches its KilledSignal.
+		 * The output keeps its current values, the tween is removed by its handle.
+		 * @param groups indices of the cancelled groups
+		 */
+		void killCancelled(const std::vector<uint32>& groups) override;
+
+		/**
+		 * The output of a buffer tween can't be unbound, the tween is removed instead
+		 */
+		void unbind(TweenID) override				{ }
+
+		/**
+		 * Removes the tween with the given id in O(1), ignored when the id is no longer valid.
+		 * Dispatches the KilledSignal of the tween when it isn't completed yet
+		 * @param id the id of the tween to remove
+		 */
+		void remove(TweenID id) override;
+
+		/**
+		 * @param id the id to validate
+		 * @return if the id refers to a tween in this pool
+		 */
+		bool isValid(TweenID id) const override;
+
+		/**
+		 * @param id the id of the tween
+		 * @return the tween with the given id, nullptr if the id is no longer valid
+		 */
+		BufferTween* find(TweenID id) const;
+
+		/**
+		 * @return number of tweens in the pool
+		 */
+		size_t size() const override				{ return mSlots.size(); }
+
+		/**
+		 * @return number of tweens that are evaluated every update
+		 */
+		size_t getActiveCount() const override		{ return mActive; }
+
+		/**
+		 * @return number of memory allocations made by the pool since it was created
+		 */
+		size_t getAllocationCount() const override	{ return mAllocations + mSlots.getAllocationCount() + mTweenStorage.getChunkCount(); }
+
+		/**
+		 * Records the lifecycle events of all tweens in the pool into the given trace
+		 * @param trace the trace to record into, nullptr stops recording
+		 * @param type name of the tweened value type, must outlive the trace
+		 */
+		void setTrace(TweenTrace* trace, const char* type) override	{ mTrace = trace; mTraceType = type; }
+
+		/**
+		 * Sets the label that identifies the tween in a trace, ignored when the id is no longer valid
+		 * @param id the id of the tween
+		 * @param label the label, nullptr for none, must outlive the trace
+		 */
+		void setLabel(TweenID id, const char* label) override;
+
+		/**
+		 * @param id the id of the tween
+		 * @return label of the tween, nullptr when it has none or the id is no longer valid
+		 */
+		const char* getLabel(TweenID id) const override		{ return isValid(id) ? mSlots[id.mSlot].mLabel : nullptr; }
+
+	private:
+		/**
+		 * Tween state flags
+		 */
+		enum EFlags : uint8
+		{
+			Complete	= 1 << 0,		///< Tween completed, its output holds the end values unless its group was cancelled
+			Listening	= 1 << 1,		///< A handler is connected to the update or complete signal
+			Stopped		= 1 << 2		///< The group of the tween is stopped, the output isn't written this update
+		};
+
+		/**
+		 * Events raised during evaluation
+		 */
+		enum EEvents : uint8
+		{
+			Updated		= 1 << 0,		///< Output changed, UpdateSignal
+			Completed	= 1 << 1		///< Tween completed, CompleteSignal
+		};
+
+		/**
+		 * Number of arrays that hold the state of the tweens, they grow at the same time
+		 */
+		static constexpr size_t arrayCount = 12;
+
+		/**
+		 * Maps a stable slot to the index a tween is currently stored at
+		 */
+		struct Slot
+		{
+			uint32						mIndex = invalid;		///< Index of the tween, invalid when the slot is free
+			uint32						mGeneration = 0;		///< Incremented every time the slot is released
+			BufferTween*				mTween = nullptr;		///< The tween that occupies this slot, receives signals
+			bool						mOwned = false;			///< If the tween is owned by the pool, stored in mTweenStorage
+			const char*					mLabel = nullptr;		///< Label that identifies the tween in a trace
+		};
+
+		/**
+		 * Computes the eased progress of the tween at the given index from the clock of its group, flags it when it completes
+		 */
+		void advance(uint32 index);
+
+		/**
+		 * Interpolates floats [begin, end) of the tween at the given index, the last range of the buffer appends the raised events
+		 */
+		void updateRange(uint32 index, uint32 begin, uint32 end, std::vector<TweenEvent>& events);
+
+		/**
+		 * Removes the tween at the given index by moving the last tween into its place, keeps the active and dormant set intact
+		 */
+		void erase(uint32 index);
+
+		/**
+		 * Swaps two tweens and updates their slots
+		 */
+		void swap(uint32 a, uint32 b);
+
+		/**
+		 * Moves the tween in the given slot to the active or dormant set, based on its flags
+		 */
+		void refresh(uint32 slot);
+
+		/**
+		 * Starts the tween in the given slot over, writes its output and wakes it
+		 */
+		void restart(uint32 slot);
+
+		/**
+		 * Writes the output of the tween in the given slot at its current progress, used when the tween changes in between updates
+		 */
+		void apply(uint32 slot);
+
+		/**
+		 * Moves the tween in the given slot to a group, the tween follows the clock of that group
+		 */
+		void setGroup(uint32 slot, const TweenGroup* group);
+
+		/**
+		 * Called when a handler connects to a signal of the tween in the given slot, from now on the pool records its events
+		 */
+		void listen(uint32 slot);
+
+		/**
+		 * Destroys the tween owned by the pool in the given slot and releases its memory
+		 */
+		void destroy(Slot& slot);
+
+		/**
+		 * Records a lifecycle event of the tween in the given slot, costs a single branch when the pool isn't traced
+		 */
+		void trace(ETweenTraceEvent event, uint32 slot, bool completed = false)
+		{
+			if (mTrace != nullptr)
+				mTrace->record(event, mTraceType, mSlots[slot].mLabel, slot, mSlots[slot].mGeneration, completed);
+		}
+
+		/**
+		 * Counts the allocations made when an element is appended to the given array
+		 */
+		template<typename Array>
+		void track(const Array& array, size_t count = 1)		{ mAllocations += array.size() == array.capacity() ? count : 0; }
+
+		/**
+		 * Reserves memory in the given array, counts the allocation
+		 */
+		template<typename Array>
+		void reserve(Array& array, size_t capacity);
+
+		std::vector<const float*>			mStart;			///< Start values of every tween, owned by the user
+		std::vector<const float*>			mEnd;			///< End values of every tween, owned by the user
+		std::vector<float*>					mOutput;		///< Output of every tween, owned by the user
+		std::vector<uint32>					mCount;			///< Number of floats in the buffers of every tween
+		std::vector<float>					mDuration;		///< Durations in seconds
+		std::vector<ETweenEaseType>			mEasing;		///< Ease types
+		std::vector<ETweenMode>				mMode;			///< Tween modes
+		std::vector<uint32>					mGroup;			///< Group the tween follows the clock of
+		std::vector<double>					mStartTime;		///< Clock of the group when the tween started
+		std::vector<float>					mProgress;		///< Eased progress, computed once per update
+		std::vector<uint8>					mFlags;			///< State flags
+		std::vector<uint32>					mTweenSlots;	///< Slot that points to the tween at the same index
+		uint32								mActive = 0;	///< Number of active tweens, stored in front
+
+		TweenStorage<BufferTween>			mTweenStorage;	///< Memory of tweens owned by the pool
+		TweenSlots<Slot>					mSlots;			///< All slots
+		TweenClocks							mOwnClocks;		///< Clocks of the pool when it isn't managed by a service
+		TweenClocks*						mClocks = &mOwnClocks;	///< Clocks the tweens follow
+		std::vector<TweenEvent>				mEvents;		///< Events raised during last update
+		std::vector<TweenID>				mKilled;		///< Tweens in cancelled groups, killed by killCancelled()
+		size_t								mAllocations = 0;	///< Number of times the arrays of the pool allocated memory
+		TweenTrace*							mTrace = nullptr;	///< Records lifecycle events, nullptr when not traced
+		const char*							mTraceType = nullptr;	///< Name of the tweened value type in the trace
+	};
+
+
+	//////////////////////////////////////////////////////////////////////////
+	// Template Definitions
+	//////////////////////////////////////////////////////////////////////////
+
+	template<typename Array>
+	void BufferTweenPool::reserve(Array& array, size_t capacity)
+	{
+		if (capacity <= array.capacity())
+			return;
+		array.reserve(capacity);
+		mAllocations++;
+	}
+}
@@ -0,0 +1,79 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "tweencommand.h"
+
+namespace nap
+{
+	TweenCommandQueue::TweenCommandQueue() :
+		mHead(&mStub), mTail(&mStub)
+	{ }
+
+
+	TweenCommandQueue::~TweenCommandQueue()
+	{
+		while (TweenCommand* command = pop())
+			delete command;
+	}
+
+
+	void TweenCommandQueue::push(TweenCommand* command)
+	{
+		// claim the head, then link the previous head to the command.
+		// until the link is stored the consumer sees the queue end at the previous head
+		command->mNext.store(nullptr, std::memory_order_relaxed);
+		TweenCommand* previous = mHead.exchange(command, std::memory_order_acq_rel);
+		previous->mNext.store(command, std::memory_order_release);
+	}
+
+
+	TweenCommand* TweenCommandQueue::pop()
+	{
+		// skip the stub
+		TweenCommand* tail = mTail;
+		TweenCommand* next = tail->mNext.load(std::memory_order_acquire);
+		if (tail == &mStub)
+		{
+			if (next == nullptr)
+				return nullptr;
+			mTail = next;
+			tail = next;
+			next = next->mNext.load(std::memory_order_acquire);
+		}
+
+		// the tail has a successor, producers no longer touch it
+		if (next != nullptr)
+		{
+			mTail = next;
+			return tail;
+		}
+
+		// a producer claimed the head but didn't link it yet, try again during the next update
+		if (tail != mHead.load(std::memory_order_acquire))
+			return nullptr;
+
+		// the tail is the last command: push the stub behind it, so the tail gets a successor
+		push(&mStub);
+		next = tail->mNext.load(std::memory_order_acquire);
+		if (next != nullptr)
+		{
+			mTail = next;
+			return tail;
+		}
+		return nullptr;
+	}
+
+
+	size_t TweenCommandQueue::execute()
+	{
+		size_t count = 0;
+		while (TweenCommand* command = pop())
+		{
+			command->execute();
+			delete command;
+			count++;
+		}
+		return count;
+	}
+}
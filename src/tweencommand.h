@@ -0,0 +1,129 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// external includes
+#include <mathutils.h>
+#include <atomic>
+#include <utility>
+
+namespace nap
+{
+	//////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * A request to change the tweens of a service, posted by any thread and executed on the main thread.
+	 * Commands are linked into a TweenCommandQueue, the queue deletes a command after executing it.
+	 */
+	class NAPAPI TweenCommand
+	{
+		friend class TweenCommandQueue;
+	public:
+		/**
+		 * Destructor
+		 */
+		virtual ~TweenCommand() = default;
+
+		/**
+		 * Executes the command on the main thread
+		 */
+		virtual void execute() = 0;
+
+	private:
+		std::atomic<TweenCommand*> mNext = { nullptr };		///< Next command in the queue
+	};
+
+
+	/**
+	 * Command that calls a function object
+	 * @tparam Function the function object, called without arguments
+	 */
+	template<typename Function>
+	class TweenFunctionCommand : public TweenCommand
+	{
+	public:
+		/**
+		 * Constructor
+		 * @param function the function to call
+		 */
+		TweenFunctionCommand(Function&& function) : mFunction(std::move(function))	{ }
+
+		/**
+		 * Calls the function
+		 */
+		void execute() override												{ mFunction(); }
+
+	private:
+		Function mFunction;
+	};
+
+
+	/**
+	 * Unbounded lock-free queue of commands with many producers and a single consumer.
+	 * Any thread can push a command, only one thread, the main thread, pops them.
+	 * Pushing is wait free: a single atomic exchange, commands of the same thread are popped in the order they were pushed.
+	 * Commands are allocated by the producer and deleted by the consumer.
+	 */
+	class NAPAPI TweenCommandQueue
+	{
+	public:
+		/**
+		 * Constructor
+		 */
+		TweenCommandQueue();
+
+		/**
+		 * Destructor, deletes the commands that weren't executed
+		 */
+		~TweenCommandQueue();
+
+		/**
+		 * The queue is not copyable, commands refer to each other
+		 */
+		TweenCommandQueue(const TweenCommandQueue&) = delete;
+		TweenCommandQueue& operator=(const TweenCommandQueue&) = delete;
+
+		/**
+		 * Appends a command, can be called from any thread
+		 * @param command the command, owned by the queue from now on
+		 */
+		void push(TweenCommand* command);
+
+		/**
+		 * Appends a command that calls the given function, can be called from any thread
+		 * @param function the function to call on the main thread
+		 */
+		template<typename Function>
+		void post(Function&& function)						{ push(new TweenFunctionCommand<typename std::decay<Function>::type>(std::forward<Function>(function))); }
+
+		/**
+		 * Removes the oldest command, only called by the consumer.
+		 * Returns nullptr when the queue is empty, or when the oldest command is still being pushed by another thread.
+		 * @return the command, owned by the caller
+		 */
+		TweenCommand* pop();
+
+		/**
+		 * Executes and deletes all commands in the queue, only called by the consumer.
+		 * Commands pushed while executing are executed as well.
+		 * @return number of executed commands
+		 */
+		size_t execute();
+
+	private:
+		/**
+		 * Node that keeps the queue linked when it's empty
+		 */
+		class Stub : public TweenCommand
+		{
+		public:
+			void execute() override							{ }
+		};
+
+		alignas(64) std::atomic<TweenCommand*>	mHead;			///< Last pushed command, producers exchange it
+		alignas(64) TweenCommand*				mTail;			///< Oldest command, only accessed by the consumer
+		Stub									mStub;			///< Linked into the queue when it runs empty
+	};
+}
@@ -0,0 +1,119 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+// Local Includes
+#include "tweeneasetable.h"
+
+// External Includes
+#include <rtti/typeinfo.h>
+#include <utility/stringutils.h>
+#include <algorithm>
+#include <cmath>
+
+RTTI_BEGIN_ENUM(nap::ETweenEaseTableInterpolation)
+	RTTI_ENUM_VALUE(nap::ETweenEaseTableInterpolation::LINEAR,	"Linear"),
+	RTTI_ENUM_VALUE(nap::ETweenEaseTableInterpolation::CUBIC,	"Cubic")
+RTTI_END_ENUM
+
+namespace nap
+{
+	// number of points tested per interval when measuring the error of a table
+	static constexpr uint32 errorSamplesPerInterval = 8;
+
+
+	TweenEaseTable::TweenEaseTable(uint32 resolution, ETweenEaseTableInterpolation interpolation) :
+		mResolution(std::max<uint32>(resolution, 2)), mInterpolation(interpolation)
+	{
+		// bake resolution + 1 samples per ease, extrapolate one sample on both sides for cubic interpolation
+		uint32 stride = mResolution + 3;
+		mSamples.resize(stride * tweenEaseCount);
+		mMaxError.resize(tweenEaseCount, 0.0f);
+		for (uint32 e = 0; e < tweenEaseCount; e++)
+		{
+			auto easing = static_cast<ETweenEaseType>(e);
+			float* samples = mSamples.data() + e * stride + 1;
+			for (uint32 i = 0; i <= mResolution; i++)
+				samples[i] = evaluateTweenEase(easing, static_cast<float>(i) / static_cast<float>(mResolution));
+			samples[-1] = 2.0f * samples[0] - samples[1];
+			samples[mResolution + 1] = 2.0f * samples[mResolution] - samples[mResolution - 1];
+		}
+
+		// measure the error in between samples
+		for (uint32 e = 0; e < tweenEaseCount; e++)
+		{
+			auto easing = static_cast<ETweenEaseType>(e);
+			float max_error = 0.0f;
+			for (uint32 i = 0; i < mResolution; i++)
+			{
+				for (uint32 k = 0; k < errorSamplesPerInterval; k++)
+				{
+					float progress = (static_cast<float>(i) + (static_cast<float>(k) + 0.5f) / errorSamplesPerInterval) / static_cast<float>(mResolution);
+					float error = std::fabs(evaluate(easing, progress) - evaluateTweenEase(easing, progress));
+					max_error = std::max(max_error, error);
+				}
+			}
+			mMaxError[e] = max_error;
+		}
+	}
+
+
+	float TweenEaseTable::evaluate(ETweenEaseType easing, float progress) const
+	{
+		return mInterpolation == ETweenEaseTableInterpolation::CUBIC ?
+			sample<ETweenEaseTableInterpolation::CUBIC>(getSamples(easing), progress) :
+			sample<ETweenEaseTableInterpolation::LINEAR>(getSamples(easing), progress);
+	}
+
+
+	void TweenEaseTable::evaluate(ETweenEaseType easing, const float* progress, float* out, size_t count) const
+	{
+		if (mInterpolation == ETweenEaseTableInterpolation::CUBIC)
+			sample<ETweenEaseTableInterpolation::CUBIC>(getSamples(easing), progress, out, count);
+		else
+			sample<ETweenEaseTableInterpolation::LINEAR>(getSamples(easing), progress, out, count);
+	}
+
+
+	std::string TweenEaseTable::getReport() const
+	{
+		rtti::TypeInfo ease_type = RTTI_OF(ETweenEaseType);
+		std::string report = utility::stringFormat("Ease table: %d intervals, %s interpolation", mResolution,
+			mInterpolation == ETweenEaseTableInterpolation::CUBIC ? "cubic" : "linear");
+
+		for (uint32 e = 0; e < tweenEaseCount; e++)
+		{
+			std::string name = ease_type.get_enumeration().value_to_name(static_cast<ETweenEaseType>(e)).to_string();
+			report += utility::stringFormat("\n%s: max error %.3g", name.c_str(), mMaxError[e]);
+		}
+		return report;
+	}
+
+
+	template<ETweenEaseTableInterpolation Interpolation>
+	float TweenEaseTable::sample(const float* samples, float progress) const
+	{
+		// interval and position within the interval
+		float x = math::clamp<float>(progress, 0.0f, 1.0f) * static_cast<float>(mResolution);
+		uint32 i = std::min(static_cast<uint32>(x), mResolution - 1);
+		float f = x - static_cast<float>(i);
+
+		const float* p = samples + i;
+		if (Interpolation == ETweenEaseTableInterpolation::LINEAR)
+			return p[0] + f * (p[1] - p[0]);
+
+		// Catmull-Rom through p[-1], p[0], p[1], p[2]
+		float a = -p[-1] + 3.0f * p[0] - 3.0f * p[1] + p[2];
+		float b = 2.0f * p[-1] - 5.0f * p[0] + 4.0f * p[1] - p[2];
+		float c = p[1] - p[-1];
+		return p[0] + 0.5f * f * (c + f * (b + f * a));
+	}
+
+
+	template<ETweenEaseTableInterpolation Interpolation>
+	void TweenEaseTable::sample(const float* samples, const float* progress, float* out, size_t count) const
+	{
+		for (size_t i = 0; i < count; i++)
+			out[i] = sample<Interpolation>(samples, progress[i]);
+	}
+}
@@ -0,0 +1,110 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// internal includes
+#include "tweeneasing.h"
+
+// external includes
+#include <mathutils.h>
+#include <vector>
+#include <string>
+
+namespace nap
+{
+	//////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * Interpolation between the samples of an ease table, scoped because the ease types already occupy LINEAR
+	 */
+	enum class ETweenEaseTableInterpolation : int
+	{
+		LINEAR	= 0,		///< Linear interpolation between two samples
+		CUBIC	= 1			///< Catmull-Rom interpolation between four samples
+	};
+
+	/**
+	 * Every ease baked into a lookup table of fixed resolution.
+	 * Sampling the table replaces the sin, pow and sqrt calls of the analytic eases with a table lookup and an interpolation,
+	 * which is cheaper on cpus with slow transcendental functions.
+	 * The maximum absolute error of every ease is measured when the table is baked, see getMaxError() and getReport().
+	 * At the default 1024 intervals with linear interpolation the quad, cubic and sine eases stay below 2e-6,
+	 * quart, quint and back below 5e-6. Eases with a kink, jump or vertical tangent are off by a lot more:
+	 * elastic about 5e-4, expo 9e-4, bounce 2e-3 and circ 1e-2. Cubic interpolation roughly halves the error of the smooth eases,
+	 * but barely helps the others. Use the analytic eases when that error is visible.
+	 * The progress is clamped to [0, 1].
+	 */
+	class NAPAPI TweenEaseTable
+	{
+	public:
+		/**
+		 * Bakes all eases
+		 * @param resolution number of intervals per ease, at least 2
+		 * @param interpolation interpolation between samples
+		 */
+		TweenEaseTable(uint32 resolution, ETweenEaseTableInterpolation interpolation);
+
+		/**
+		 * Samples an ease
+		 * @param easing the ease type
+		 * @param progress progress ( 0 - 1 )
+		 * @return eased progress
+		 */
+		float evaluate(ETweenEaseType easing, float progress) const;
+
+		/**
+		 * Samples an ease for many progress values at once: out[i] = ease(progress[i])
+		 * @param easing the ease type
+		 * @param progress progress values ( 0 - 1 )
+		 * @param out eased progress values, may alias progress
+		 * @param count number of values
+		 */
+		void evaluate(ETweenEaseType easing, const float* progress, float* out, size_t count) const;
+
+		/**
+		 * @param easing the ease type
+		 * @return maximum absolute error of the table compared to the analytic ease
+		 */
+		float getMaxError(ETweenEaseType easing) const				{ return mMaxError[easing]; }
+
+		/**
+		 * @return maximum absolute error of every ease, one line per ease
+		 */
+		std::string getReport() const;
+
+		/**
+		 * @return number of intervals per ease
+		 */
+		uint32 getResolution() const								{ return mResolution; }
+
+		/**
+		 * @return interpolation between samples
+		 */
+		ETweenEaseTableInterpolation getInterpolation() const		{ return mInterpolation; }
+
+	private:
+		/**
+		 * @return samples of the given ease, the first and last sample are extrapolated
+		 */
+		const float* getSamples(ETweenEaseType easing) const		{ return mSamples.data() + easing * (mResolution + 3) + 1; }
+
+		/**
+		 * Samples an ease with the given interpolation
+		 */
+		template<ETweenEaseTableInterpolation Interpolation>
+		float sample(const float* samples, float progress) const;
+
+		/**
+		 * Samples an ease for many progress values with the given interpolation
+		 */
+		template<ETweenEaseTableInterpolation Interpolation>
+		void sample(const float* samples, const float* progress, float* out, size_t count) const;
+
+		uint32							mResolution;			///< Number of intervals per ease
+		ETweenEaseTableInterpolation	mInterpolation;			///< Interpolation between samples
+		std::vector<float>				mSamples;				///< resolution + 1 samples per ease, padded with one sample on both sides
+		std::vector<float>				mMaxError;				///< Measured maximum error per ease
+	};
+}
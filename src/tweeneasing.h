@@ -7,7 +7,8 @@
 // external includes
 #include <mathutils.h>
 #include <math.h>
-#include <easing.h>
+#include <cmath>
+#include <cassert>
 
 namespace nap
 {
@@ -50,437 +51,697 @@ namespace nap
 	};
 
 	/**
-	 * Base class for evaluation
+	 * Number of available ease types
 	 */
-	template<typename T>
-	class TweenEaseBase
-	{
-	public:
-		/**
-		 * Constructor
-		 */
-		TweenEaseBase() = default;
+	constexpr uint32 tweenEaseCount = static_cast<uint32>(ETweenEaseType::SINE_OUT) + 1;
 
-		/**
-		 * Deconstructor
-		 */
-		virtual ~TweenEaseBase() = default;
-
-		/**
-		 * Evaluates using an easing method between start and end value
-		 * Override this method to implement your own evaluation method
-		 * @param start the start value
-		 * @param end the end value
-		 * @param progress progress between start & end ( float between 0 and 1 )
-		 * @return the value computed by easing method
-		 */
-		virtual T evaluate(T& start, T& end, float progress) = 0;
-	};
-
-	template<typename T>
-	class TweenEaseLinear : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseInCubic : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseInOutCubic : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseOutCubic : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseInBack : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseInOutBack : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseOutBack : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseInBounce : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseInOutBounce : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseOutBounce : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseInCirc : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseInOutCirc : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseOutCirc : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseInElastic : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseInOutElastic : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseOutElastic : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseInExpo : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseInOutExpo : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseOutExpo : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseInQuad : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseInOutQuad : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseOutQuad : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseInQuart : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseInOutQuart : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseOutQuart : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
-
-	template<typename T>
-	class TweenEaseInQuint : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
+	/**
+	 * Pi, used by the sine and elastic eases
+	 */
+	constexpr float tweenPi = 3.14159265358979f;
 
-	template<typename T>
-	class TweenEaseInOutQuint : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
+	/**
+	 * Natural logarithm of 2, used by the derivatives of the exponential and elastic eases
+	 */
+	constexpr float tweenLn2 = 0.693147180559945f;
 
-	template<typename T>
-	class TweenEaseOutQuint : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
 
-	template<typename T>
-	class TweenEaseInSine : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
+	//////////////////////////////////////////////////////////////////////////
+	// Ease Tags
+	//////////////////////////////////////////////////////////////////////////
 
-	template<typename T>
-	class TweenEaseInOutSine : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
+	/**
+	 * Every ease type is available as a tag: a type that exposes the ease type, a static scalar
+	 * evaluate(progress) function that maps progress ( 0 - 1 ) to eased progress and its analytic derivative(progress).
+	 * The derivative is unbounded where a circular ease is vertical, it returns infinity there.
+	 * Tags allow the ease to be selected at compile time, for example: Tween<glm::vec3, EaseOutCubic>.
+	 * Curves follow the Penner equations ( see : https://github.com/jesusgollonet/ofpennereasing )
+	 */
+	struct EaseLinear
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::LINEAR;
+		static constexpr float evaluate(float progress)
+		{
+			return progress;
+		}
+		static constexpr float derivative(float)
+		{
+			return 1.0f;
+		}
+	};
+
+	struct EaseInCubic
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::CUBIC_IN;
+		static constexpr float evaluate(float progress)
+		{
+			return progress * progress * progress;
+		}
+		static constexpr float derivative(float progress)
+		{
+			return 3.0f * progress * progress;
+		}
+	};
+
+	struct EaseInOutCubic
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::CUBIC_INOUT;
+		static constexpr float evaluate(float progress)
+		{
+			float t = progress * 2.0f;
+			if (t < 1.0f)
+				return 0.5f * t * t * t;
+			t -= 2.0f;
+			return 0.5f * (t * t * t + 2.0f);
+		}
+		static constexpr float derivative(float progress)
+		{
+			float t = progress < 0.5f ? progress * 2.0f : progress * 2.0f - 2.0f;
+			return 3.0f * t * t;
+		}
+	};
+
+	struct EaseOutCubic
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::CUBIC_OUT;
+		static constexpr float evaluate(float progress)
+		{
+			float t = progress - 1.0f;
+			return t * t * t + 1.0f;
+		}
+		static constexpr float derivative(float progress)
+		{
+			float t = progress - 1.0f;
+			return 3.0f * t * t;
+		}
+	};
+
+	struct EaseInBack
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::BACK_IN;
+		static constexpr float evaluate(float progress)
+		{
+			constexpr float s = 1.70158f;
+			return progress * progress * ((s + 1.0f) * progress - s);
+		}
+		static constexpr float derivative(float progress)
+		{
+			constexpr float s = 1.70158f;
+			return progress * (3.0f * (s + 1.0f) * progress - 2.0f * s);
+		}
+	};
+
+	struct EaseInOutBack
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::BACK_INOUT;
+		static constexpr float evaluate(float progress)
+		{
+			constexpr float s = 1.70158f * 1.525f;
+			float t = progress * 2.0f;
+			if (t < 1.0f)
+				return 0.5f * (t * t * ((s + 1.0f) * t - s));
+			t -= 2.0f;
+			return 0.5f * (t * t * ((s + 1.0f) * t + s) + 2.0f);
+		}
+		static constexpr float derivative(float progress)
+		{
+			constexpr float s = 1.70158f * 1.525f;
+			float t = progress * 2.0f;
+			if (t < 1.0f)
+				return t * (3.0f * (s + 1.0f) * t - 2.0f * s);
+			t -= 2.0f;
+			return t * (3.0f * (s + 1.0f) * t + 2.0f * s);
+		}
+	};
+
+	struct EaseOutBack
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::BACK_OUT;
+		static constexpr float evaluate(float progress)
+		{
+			constexpr float s = 1.70158f;
+			float t = progress - 1.0f;
+			return t * t * ((s + 1.0f) * t + s) + 1.0f;
+		}
+		static constexpr float derivative(float progress)
+		{
+			constexpr float s = 1.70158f;
+			float t = progress - 1.0f;
+			return t * (3.0f * (s + 1.0f) * t + 2.0f * s);
+		}
+	};
+
+	struct EaseOutBounce
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::BOUNCE_OUT;
+		static constexpr float evaluate(float progress)
+		{
+			if (progress < (1.0f / 2.75f))
+				return 7.5625f * progress * progress;
+			if (progress < (2.0f / 2.75f))
+			{
+				float t = progress - (1.5f / 2.75f);
+				return 7.5625f * t * t + 0.75f;
+			}
+			if (progress < (2.5f / 2.75f))
+			{
+				float t = progress - (2.25f / 2.75f);
+				return 7.5625f * t * t + 0.9375f;
+			}
+			float t = progress - (2.625f / 2.75f);
+			return 7.5625f * t * t + 0.984375f;
+		}
+		static constexpr float derivative(float progress)
+		{
+			if (progress < (1.0f / 2.75f))
+				return 2.0f * 7.5625f * progress;
+			if (progress < (2.0f / 2.75f))
+				return 2.0f * 7.5625f * (progress - (1.5f / 2.75f));
+			if (progress < (2.5f / 2.75f))
+				return 2.0f * 7.5625f * (progress - (2.25f / 2.75f));
+			return 2.0f * 7.5625f * (progress - (2.625f / 2.75f));
+		}
+	};
+
+	struct EaseInBounce
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::BOUNCE_IN;
+		static constexpr float evaluate(float progress)
+		{
+			return 1.0f - EaseOutBounce::evaluate(1.0f - progress);
+		}
+		static constexpr float derivative(float progress)
+		{
+			return EaseOutBounce::derivative(1.0f - progress);
+		}
+	};
+
+	struct EaseInOutBounce
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::BOUNCE_INOUT;
+		static constexpr float evaluate(float progress)
+		{
+			if (progress < 0.5f)
+				return EaseInBounce::evaluate(progress * 2.0f) * 0.5f;
+			return EaseOutBounce::evaluate(progress * 2.0f - 1.0f) * 0.5f + 0.5f;
+		}
+		static constexpr float derivative(float progress)
+		{
+			if (progress < 0.5f)
+				return EaseInBounce::derivative(progress * 2.0f);
+			return EaseOutBounce::derivative(progress * 2.0f - 1.0f);
+		}
+	};
+
+	struct EaseInCirc
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::CIRC_IN;
+		static inline float evaluate(float progress)
+		{
+			return -(std::sqrt(1.0f - progress * progress) - 1.0f);
+		}
+		static inline float derivative(float progress)
+		{
+			return progress / std::sqrt(1.0f - progress * progress);
+		}
+	};
+
+	struct EaseInOutCirc
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::CIRC_INOUT;
+		static inline float evaluate(float progress)
+		{
+			float t = progress * 2.0f;
+			if (t < 1.0f)
+				return -0.5f * (std::sqrt(1.0f - t * t) - 1.0f);
+			t -= 2.0f;
+			return 0.5f * (std::sqrt(1.0f - t * t) + 1.0f);
+		}
+		static inline float derivative(float progress)
+		{
+			float t = progress * 2.0f;
+			if (t < 1.0f)
+				return t / std::sqrt(1.0f - t * t);
+			t -= 2.0f;
+			return -t / std::sqrt(1.0f - t * t);
+		}
+	};
+
+	struct EaseOutCirc
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::CIRC_OUT;
+		static inline float evaluate(float progress)
+		{
+			float t = progress - 1.0f;
+			return std::sqrt(1.0f - t * t);
+		}
+		static inline float derivative(float progress)
+		{
+			float t = progress - 1.0f;
+			return -t / std::sqrt(1.0f - t * t);
+		}
+	};
+
+	struct EaseInElastic
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::ELASTIC_IN;
+		static inline float evaluate(float progress)
+		{
+			if (progress == 0.0f || progress == 1.0f)
+				return progress;
+			constexpr float p = 0.3f;
+			constexpr float s = p / 4.0f;
+			float t = progress - 1.0f;
+			return -(std::exp2(10.0f * t) * std::sin((t - s) * (2.0f * tweenPi) / p));
+		}
+		static inline float derivative(float progress)
+		{
+			constexpr float p = 0.3f;
+			constexpr float s = p / 4.0f;
+			constexpr float w = (2.0f * tweenPi) / p;
+			float t = progress - 1.0f;
+			float e = std::exp2(10.0f * t);
+			return -e * (10.0f * tweenLn2 * std::sin((t - s) * w) + w * std::cos((t - s) * w));
+		}
+	};
+
+	struct EaseInOutElastic
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::ELASTIC_INOUT;
+		static inline float evaluate(float progress)
+		{
+			if (progress == 0.0f || progress == 1.0f)
+				return progress;
+			constexpr float p = 0.3f * 1.5f;
+			constexpr float s = p / 4.0f;
+			float t = progress * 2.0f - 1.0f;
+			if (t < 0.0f)
+				return -0.5f * (std::exp2(10.0f * t) * std::sin((t - s) * (2.0f * tweenPi) / p));
+			return std::exp2(-10.0f * t) * std::sin((t - s) * (2.0f * tweenPi) / p) * 0.5f + 1.0f;
+		}
+		static inline float derivative(float progress)
+		{
+			constexpr float p = 0.3f * 1.5f;
+			constexpr float s = p / 4.0f;
+			constexpr float w = (2.0f * tweenPi) / p;
+			float t = progress * 2.0f - 1.0f;
+			if (t < 0.0f)
+				return -std::exp2(10.0f * t) * (10.0f * tweenLn2 * std::sin((t - s) * w) + w * std::cos((t - s) * w));
+			return std::exp2(-10.0f * t) * (w * std::cos((t - s) * w) - 10.0f * tweenLn2 * std::sin((t - s) * w));
+		}
+	};
+
+	struct EaseOutElastic
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::ELASTIC_OUT;
+		static inline float evaluate(float progress)
+		{
+			if (progress == 0.0f || progress == 1.0f)
+				return progress;
+			constexpr float p = 0.3f;
+			constexpr float s = p / 4.0f;
+			return std::exp2(-10.0f * progress) * std::sin((progress - s) * (2.0f * tweenPi) / p) + 1.0f;
+		}
+		static inline float derivative(float progress)
+		{
+			constexpr float p = 0.3f;
+			constexpr float s = p / 4.0f;
+			constexpr float w = (2.0f * tweenPi) / p;
+			return std::exp2(-10.0f * progress) * (w * std::cos((progress - s) * w) - 10.0f * tweenLn2 * std::sin((progress - s) * w));
+		}
+	};
+
+	struct EaseInExpo
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::EXPO_IN;
+		static inline float evaluate(float progress)
+		{
+			return progress == 0.0f ? 0.0f : std::exp2(10.0f * (progress - 1.0f));
+		}
+		static inline float derivative(float progress)
+		{
+			return 10.0f * tweenLn2 * std::exp2(10.0f * (progress - 1.0f));
+		}
+	};
+
+	struct EaseInOutExpo
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::EXPO_INOUT;
+		static inline float evaluate(float progress)
+		{
+			if (progress == 0.0f || progress == 1.0f)
+				return progress;
+			float t = progress * 2.0f;
+			if (t < 1.0f)
+				return 0.5f * std::exp2(10.0f * (t - 1.0f));
+			return 0.5f * (2.0f - std::exp2(-10.0f * (t - 1.0f)));
+		}
+		static inline float derivative(float progress)
+		{
+			float t = progress * 2.0f - 1.0f;
+			return 10.0f * tweenLn2 * std::exp2(t < 0.0f ? 10.0f * t : -10.0f * t);
+		}
+	};
+
+	struct EaseOutExpo
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::EXPO_OUT;
+		static inline float evaluate(float progress)
+		{
+			return progress == 1.0f ? 1.0f : 1.0f - std::exp2(-10.0f * progress);
+		}
+		static inline float derivative(float progress)
+		{
+			return 10.0f * tweenLn2 * std::exp2(-10.0f * progress);
+		}
+	};
+
+	struct EaseInQuad
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::QUAD_IN;
+		static constexpr float evaluate(float progress)
+		{
+			return progress * progress;
+		}
+		static constexpr float derivative(float progress)
+		{
+			return 2.0f * progress;
+		}
+	};
+
+	struct EaseInOutQuad
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::QUAD_INOUT;
+		static constexpr float evaluate(float progress)
+		{
+			float t = progress * 2.0f;
+			if (t < 1.0f)
+				return 0.5f * t * t;
+			t -= 1.0f;
+			return -0.5f * ((t - 2.0f) * t - 1.0f);
+		}
+		static constexpr float derivative(float progress)
+		{
+			return progress < 0.5f ? 4.0f * progress : 4.0f * (1.0f - progress);
+		}
+	};
+
+	struct EaseOutQuad
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::QUAD_OUT;
+		static constexpr float evaluate(float progress)
+		{
+			return -progress * (progress - 2.0f);
+		}
+		static constexpr float derivative(float progress)
+		{
+			return 2.0f - 2.0f * progress;
+		}
+	};
+
+	struct EaseInQuart
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::QUART_IN;
+		static constexpr float evaluate(float progress)
+		{
+			return progress * progress * progress * progress;
+		}
+		static constexpr float derivative(float progress)
+		{
+			return 4.0f * progress * progress * progress;
+		}
+	};
+
+	struct EaseInOutQuart
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::QUART_INOUT;
+		static constexpr float evaluate(float progress)
+		{
+			float t = progress * 2.0f;
+			if (t < 1.0f)
+				return 0.5f * t * t * t * t;
+			t -= 2.0f;
+			return -0.5f * (t * t * t * t - 2.0f);
+		}
+		static constexpr float derivative(float progress)
+		{
+			float t = progress < 0.5f ? progress * 2.0f : 2.0f - progress * 2.0f;
+			return 4.0f * t * t * t;
+		}
+	};
+
+	struct EaseOutQuart
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::QUART_OUT;
+		static constexpr float evaluate(float progress)
+		{
+			float t = progress - 1.0f;
+			return -(t * t * t * t - 1.0f);
+		}
+		static constexpr float derivative(float progress)
+		{
+			float t = 1.0f - progress;
+			return 4.0f * t * t * t;
+		}
+	};
+
+	struct EaseInQuint
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::QUINT_IN;
+		static constexpr float evaluate(float progress)
+		{
+			return progress * progress * progress * progress * progress;
+		}
+		static constexpr float derivative(float progress)
+		{
+			return 5.0f * progress * progress * progress * progress;
+		}
+	};
+
+	struct EaseInOutQuint
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::QUINT_INOUT;
+		static constexpr float evaluate(float progress)
+		{
+			float t = progress * 2.0f;
+			if (t < 1.0f)
+				return 0.5f * t * t * t * t * t;
+			t -= 2.0f;
+			return 0.5f * (t * t * t * t * t + 2.0f);
+		}
+		static constexpr float derivative(float progress)
+		{
+			float t = progress < 0.5f ? progress * 2.0f : progress * 2.0f - 2.0f;
+			return 5.0f * t * t * t * t;
+		}
+	};
+
+	struct EaseOutQuint
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::QUINT_OUT;
+		static constexpr float evaluate(float progress)
+		{
+			float t = progress - 1.0f;
+			return t * t * t * t * t + 1.0f;
+		}
+		static constexpr float derivative(float progress)
+		{
+			float t = progress - 1.0f;
+			return 5.0f * t * t * t * t;
+		}
+	};
+
+	struct EaseInSine
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::SINE_IN;
+		static inline float evaluate(float progress)
+		{
+			return 1.0f - std::cos(progress * (tweenPi * 0.5f));
+		}
+		static inline float derivative(float progress)
+		{
+			return (tweenPi * 0.5f) * std::sin(progress * (tweenPi * 0.5f));
+		}
+	};
+
+	struct EaseInOutSine
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::SINE_INOUT;
+		static inline float evaluate(float progress)
+		{
+			return -0.5f * (std::cos(tweenPi * progress) - 1.0f);
+		}
+		static inline float derivative(float progress)
+		{
+			return (tweenPi * 0.5f) * std::sin(tweenPi * progress);
+		}
+	};
+
+	struct EaseOutSine
+	{
+		static constexpr ETweenEaseType type = ETweenEaseType::SINE_OUT;
+		static inline float evaluate(float progress)
+		{
+			return std::sin(progress * (tweenPi * 0.5f));
+		}
+		static inline float derivative(float progress)
+		{
+			return (tweenPi * 0.5f) * std::cos(progress * (tweenPi * 0.5f));
+		}
 	};
 
-	template<typename T>
-	class TweenEaseOutSine : public TweenEaseBase<T>
-	{
-	public:
-		T evaluate(T& start, T& end, float progress) override;
-	};
 
 	//////////////////////////////////////////////////////////////////////////
-	// template definitions
+	// Dispatch
 	//////////////////////////////////////////////////////////////////////////
 
-	template<typename T>
-	T TweenEaseLinear<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Linear::easeNone<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseInCubic<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Cubic::easeIn<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseInOutCubic<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Cubic::easeInOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseOutCubic<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Cubic::easeOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseInBack<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Back::easeIn<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseInOutBack<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Back::easeInOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseOutBack<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Back::easeOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseInBounce<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Bounce::easeIn<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseInOutBounce<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Bounce::easeInOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseOutBounce<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Bounce::easeOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseInCirc<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Circ::easeIn<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseInOutCirc<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Circ::easeInOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseOutCirc<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Circ::easeOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseInElastic<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Elastic::easeIn<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseInOutElastic<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Elastic::easeInOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseOutElastic<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Elastic::easeOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseInExpo<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Expo::easeIn<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseInOutExpo<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Expo::easeInOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseOutExpo<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Expo::easeOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseInQuad<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Quad::easeIn<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseInOutQuad<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Quad::easeInOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseOutQuad<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Quad::easeOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-
-	template<typename T>
-	T TweenEaseInQuart<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Quart::easeIn<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
+	/**
+	 * Calls the given function with the ease tag that belongs to the given ease type.
+	 * The switch is resolved once, the function is instantiated for every tag,
+	 * which allows a loop inside the function to evaluate the ease without any indirect call.
+	 * @param easing the ease type
+	 * @param func function that accepts an ease tag, for example: [](auto tag) { return decltype(tag)::evaluate(0.5f); }
+	 * @return whatever the function returns
+	 */
+	template<typename Function>
+	decltype(auto) visitTweenEase(ETweenEaseType easing, Function&& func)
+	{
+		switch (easing)
+		{
+		case ETweenEaseType::LINEAR:          return func(EaseLinear());
+		case ETweenEaseType::CUBIC_IN:        return func(EaseInCubic());
+		case ETweenEaseType::CUBIC_INOUT:     return func(EaseInOutCubic());
+		case ETweenEaseType::CUBIC_OUT:       return func(EaseOutCubic());
+		case ETweenEaseType::BACK_IN:         return func(EaseInBack());
+		case ETweenEaseType::BACK_INOUT:      return func(EaseInOutBack());
+		case ETweenEaseType::BACK_OUT:        return func(EaseOutBack());
+		case ETweenEaseType::BOUNCE_IN:       return func(EaseInBounce());
+		case ETweenEaseType::BOUNCE_INOUT:    return func(EaseInOutBounce());
+		case ETweenEaseType::BOUNCE_OUT:      return func(EaseOutBounce());
+		case ETweenEaseType::CIRC_IN:         return func(EaseInCirc());
+		case ETweenEaseType::CIRC_INOUT:      return func(EaseInOutCirc());
+		case ETweenEaseType::CIRC_OUT:        return func(EaseOutCirc());
+		case ETweenEaseType::ELASTIC_IN:      return func(EaseInElastic());
+		case ETweenEaseType::ELASTIC_INOUT:   return func(EaseInOutElastic());
+		case ETweenEaseType::ELASTIC_OUT:     return func(EaseOutElastic());
+		case ETweenEaseType::EXPO_IN:         return func(EaseInExpo());
+		case ETweenEaseType::EXPO_INOUT:      return func(EaseInOutExpo());
+		case ETweenEaseType::EXPO_OUT:        return func(EaseOutExpo());
+		case ETweenEaseType::QUAD_IN:         return func(EaseInQuad());
+		case ETweenEaseType::QUAD_INOUT:      return func(EaseInOutQuad());
+		case ETweenEaseType::QUAD_OUT:        return func(EaseOutQuad());
+		case ETweenEaseType::QUART_IN:        return func(EaseInQuart());
+		case ETweenEaseType::QUART_INOUT:     return func(EaseInOutQuart());
+		case ETweenEaseType::QUART_OUT:       return func(EaseOutQuart());
+		case ETweenEaseType::QUINT_IN:        return func(EaseInQuint());
+		case ETweenEaseType::QUINT_INOUT:     return func(EaseInOutQuint());
+		case ETweenEaseType::QUINT_OUT:       return func(EaseOutQuint());
+		case ETweenEaseType::SINE_IN:         return func(EaseInSine());
+		case ETweenEaseType::SINE_INOUT:      return func(EaseInOutSine());
+		case ETweenEaseType::SINE_OUT:        return func(EaseOutSine());
+		default:
+			assert(false); // unknown ease type
+			return func(EaseLinear());
+		}
 	}
 
-	template<typename T>
-	T TweenEaseInOutQuart<T>::evaluate(T& start, T& end, float progress)
+	/**
+	 * Evaluates the ease type for the given progress, allocation free
+	 * @param easing the ease type
+	 * @param progress progress ( float between 0 and 1 )
+	 * @return the eased progress
+	 */
+	inline float evaluateTweenEase(ETweenEaseType easing, float progress)
 	{
-		return math::Quart::easeInOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
+		return visitTweenEase(easing, [progress](auto tag) { return decltype(tag)::evaluate(progress); });
 	}
 
-	template<typename T>
-	T TweenEaseOutQuart<T>::evaluate(T& start, T& end, float progress)
+	/**
+	 * Evaluates the derivative of the ease type for the given progress: the rate at which the eased progress changes
+	 * @param easing the ease type
+	 * @param progress progress ( float between 0 and 1 )
+	 * @return derivative of the eased progress with respect to the progress
+	 */
+	inline float evaluateTweenEaseDerivative(ETweenEaseType easing, float progress)
 	{
-		return math::Quart::easeOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
+		return visitTweenEase(easing, [progress](auto tag) { return decltype(tag)::derivative(progress); });
 	}
 
-	template<typename T>
-	T TweenEaseInQuint<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Quint::easeIn<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
 
-	template<typename T>
-	T TweenEaseInOutQuint<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Quint::easeInOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
+	//////////////////////////////////////////////////////////////////////////
+	// Easing methods
+	//////////////////////////////////////////////////////////////////////////
 
+	/**
+	 * Base class for evaluation
+	 * Tweens evaluate their ease through the tags above, this interface remains available for custom evaluation methods
+	 */
 	template<typename T>
-	T TweenEaseOutQuint<T>::evaluate(T& start, T& end, float progress)
+	class TweenEaseBase
 	{
-		return math::Quint::easeOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
+	public:
+		/**
+		 * Constructor
+		 */
+		TweenEaseBase() = default;
 
-	template<typename T>
-	T TweenEaseInSine<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Sine::easeIn<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
+		/**
+		 * Deconstructor
+		 */
+		virtual ~TweenEaseBase() = default;
 
-	template<typename T>
-	T TweenEaseInOutSine<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Sine::easeInOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
+		/**
+		 * Evaluates using an easing method between start and end value
+		 * Override this method to implement your own evaluation method
+		 * @param start the start value
+		 * @param end the end value
+		 * @param progress progress between start & end ( float between 0 and 1 )
+		 * @return the value computed by easing method
+		 */
+		virtual T evaluate(T& start, T& end, float progress) = 0;
+	};
 
-	template<typename T>
-	T TweenEaseOutSine<T>::evaluate(T& start, T& end, float progress)
-	{
-		return math::Sine::easeOut<float>(progress, 0.0f, 1.0f, 1.0f) * ( end - start ) + start;
-	}
-}
\ No newline at end of file
+	/**
+	 * Evaluation method that uses an ease tag
+	 * @tparam T the type of value that is tweened
+	 * @tparam Ease the ease tag
+	 */
+	template<typename T, typename Ease>
+	class TweenEase : public TweenEaseBase<T>
+	{
+	public:
+		T evaluate(T& start, T& end, float progress) override	{ return Ease::evaluate(progress) * ( end - start ) + start; }
+	};
+
+	template<typename T> using TweenEaseLinear = TweenEase<T, EaseLinear>;
+	template<typename T> using TweenEaseInCubic = TweenEase<T, EaseInCubic>;
+	template<typename T> using TweenEaseInOutCubic = TweenEase<T, EaseInOutCubic>;
+	template<typename T> using TweenEaseOutCubic = TweenEase<T, EaseOutCubic>;
+	template<typename T> using TweenEaseInBack = TweenEase<T, EaseInBack>;
+	template<typename T> using TweenEaseInOutBack = TweenEase<T, EaseInOutBack>;
+	template<typename T> using TweenEaseOutBack = TweenEase<T, EaseOutBack>;
+	template<typename T> using TweenEaseInBounce = TweenEase<T, EaseInBounce>;
+	template<typename T> using TweenEaseInOutBounce = TweenEase<T, EaseInOutBounce>;
+	template<typename T> using TweenEaseOutBounce = TweenEase<T, EaseOutBounce>;
+	template<typename T> using TweenEaseInCirc = TweenEase<T, EaseInCirc>;
+	template<typename T> using TweenEaseInOutCirc = TweenEase<T, EaseInOutCirc>;
+	template<typename T> using TweenEaseOutCirc = TweenEase<T, EaseOutCirc>;
+	template<typename T> using TweenEaseInElastic = TweenEase<T, EaseInElastic>;
+	template<typename T> using TweenEaseInOutElastic = TweenEase<T, EaseInOutElastic>;
+	template<typename T> using TweenEaseOutElastic = TweenEase<T, EaseOutElastic>;
+	template<typename T> using TweenEaseInExpo = TweenEase<T, EaseInExpo>;
+	template<typename T> using TweenEaseInOutExpo = TweenEase<T, EaseInOutExpo>;
+	template<typename T> using TweenEaseOutExpo = TweenEase<T, EaseOutExpo>;
+	template<typename T> using TweenEaseInQuad = TweenEase<T, EaseInQuad>;
+	template<typename T> using TweenEaseInOutQuad = TweenEase<T, EaseInOutQuad>;
+	template<typename T> using TweenEaseOutQuad = TweenEase<T, EaseOutQuad>;
+	template<typename T> using TweenEaseInQuart = TweenEase<T, EaseInQuart>;
+	template<typename T> using TweenEaseInOutQuart = TweenEase<T, EaseInOutQuart>;
+	template<typename T> using TweenEaseOutQuart = TweenEase<T, EaseOutQuart>;
+	template<typename T> using TweenEaseInQuint = TweenEase<T, EaseInQuint>;
+	template<typename T> using TweenEaseInOutQuint = TweenEase<T, EaseInOutQuint>;
+	template<typename T> using TweenEaseOutQuint = TweenEase<T, EaseOutQuint>;
+	template<typename T> using TweenEaseInSine = TweenEase<T, EaseInSine>;
+	template<typename T> using TweenEaseInOutSine = TweenEase<T, EaseInOutSine>;
+	template<typename T> using TweenEaseOutSine = TweenEase<T, EaseOutSine>;
+}
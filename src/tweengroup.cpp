@@ -0,0 +1,140 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "tweengroup.h"
+
+// external includes
+#include <algorithm>
+#include <cassert>
+
+namespace nap
+{
+	TweenClocks::TweenClocks()
+	{
+		mTimes.emplace_back(0.0);
+		mRunning.emplace_back(1);
+		mCancelled.emplace_back(0);
+		mGroups.emplace_back();
+	}
+
+
+	uint32 TweenClocks::create(uint32 parent)
+	{
+		assert(parent < mGroups.size() && !mGroups[parent].mReleased);
+
+		uint32 group;
+		if (!mFree.empty())
+		{
+			group = mFree.back();
+			mFree.pop_back();
+			mTimes[group] = 0.0;
+			mRunning[group] = 1;
+			mCancelled[group] = 0;
+			mGroups[group] = Group();
+		}
+		else
+		{
+			group = static_cast<uint32>(mGroups.size());
+			mTimes.emplace_back(0.0);
+			mRunning.emplace_back(1);
+			mCancelled.emplace_back(0);
+			mGroups.emplace_back();
+		}
+
+		// the parent is in use, it comes before the group in the update order
+		Group& entry = mGroups[group];
+		entry.mParent = parent;
+		entry.mEffectiveScale = mGroups[parent].mEffectiveScale;
+		mCancelled[group] = mCancelled[parent];
+		join(parent);
+		mOrder.emplace_back(group);
+		return group;
+	}
+
+
+	void TweenClocks::release(uint32 group)
+	{
+		assert(group != root && !mGroups[group].mReleased);
+		mGroups[group].mReleased = true;
+		if (mGroups[group].mMembers == 0)
+			free(group);
+	}
+
+
+	void TweenClocks::leave(uint32 group)
+	{
+		Group& entry = mGroups[group];
+		assert(entry.mMembers > 0);
+		if (--entry.mMembers == 0 && entry.mReleased)
+			free(group);
+	}
+
+
+	void TweenClocks::free(uint32 group)
+	{
+		mOrder.erase(std::find(mOrder.begin(), mOrder.end(), group));
+		mFree.emplace_back(group);
+		leave(mGroups[group].mParent);
+	}
+
+
+	void TweenClocks::setTimeScale(uint32 group, float scale)
+	{
+		assert(scale >= 0.0f); // time can't run backwards
+		mGroups[group].mScale = scale;
+	}
+
+
+	void TweenClocks::advance(double deltaTime)
+	{
+		mTimes[root] += deltaTime;
+		for (uint32 group : mOrder)
+		{
+			Group& entry = mGroups[group];
+			bool stopped = entry.mPaused || entry.mCancelled || entry.mReleased;
+			entry.mEffectiveScale = stopped ? 0.0f : entry.mScale * mGroups[entry.mParent].mEffectiveScale;
+			mRunning[group] = entry.mEffectiveScale > 0.0f ? 1 : 0;
+			mTimes[group] += deltaTime * entry.mEffectiveScale;
+
+			// the members of a group that was cancelled or released since the last update are killed
+			uint8 cancelled = entry.mCancelled || entry.mReleased || mCancelled[entry.mParent] ? 1 : 0;
+			if (cancelled > mCancelled[group])
+				queueKill(group);
+			mCancelled[group] = cancelled;
+		}
+	}
+
+
+	void TweenClocks::queueKill(uint32 group)
+	{
+		Group& entry = mGroups[group];
+		if (entry.mKillQueued)
+			return;
+		entry.mKillQueued = true;
+		mKillQueue.emplace_back(group);
+	}
+
+
+	void TweenClocks::takeKillQueue(std::vector<uint32>& groups)
+	{
+		groups.clear();
+		groups.swap(mKillQueue);
+		for (uint32 group : groups)
+			mGroups[group].mKillQueued = false;
+	}
+
+
+	TweenGroup::TweenGroup(TweenClocks& clocks, TweenGroup* parent) :
+		mClocks(clocks), mParent(parent)
+	{
+		assert(parent == nullptr || &parent->mClocks == &clocks);
+		mIndex = mClocks.create(parent != nullptr ? parent->mIndex : TweenClocks::root);
+	}
+
+
+	TweenGroup::~TweenGroup()
+	{
+		mClocks.release(mIndex);
+	}
+}
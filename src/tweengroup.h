@@ -0,0 +1,292 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// external includes
+#include <mathutils.h>
+#include <vector>
+
+namespace nap
+{
+	//////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * Clocks of all tween groups, shared by all pools of a service.
+	 * Every group has a clock that advances with the effective delta time of the group: the delta time scaled by the group and its parents,
+	 * 0 when the group or one of its parents is paused or cancelled. The effective delta time of every group is computed once per update.
+	 * Tweens store their start time on the clock of their group, pausing, scaling or cancelling a group is O(1) regardless of its size.
+	 * The members of a cancelled or released group are killed by the pools at the start of the next update, see queueKill().
+	 * Group 0 is the root group, tweens without a group follow the root clock.
+	 */
+	class NAPAPI TweenClocks
+	{
+	public:
+		/**
+		 * Index of the root group
+		 */
+		static constexpr uint32 root = 0;
+
+		/**
+		 * Constructor, creates the root group
+		 */
+		TweenClocks();
+
+		/**
+		 * Creates a group
+		 * @param parent index of the parent group
+		 * @return index of the group
+		 */
+		uint32 create(uint32 parent);
+
+		/**
+		 * Releases a group: its clock stops and its members are killed like the members of a cancelled group,
+		 * the group is reused when all its members left
+		 * @param group index of the group
+		 */
+		void release(uint32 group);
+
+		/**
+		 * Advances the clock of every group by its effective delta time
+		 * @param deltaTime time in seconds since last update
+		 */
+		void advance(double deltaTime);
+
+		/**
+		 * Adds a member to a group, a tween or child group.
+		 * A member that joins a cancelled group is killed at the start of the next update.
+		 * @param group index of the group
+		 */
+		void join(uint32 group)								{ mGroups[group].mMembers++; if (mCancelled[group]) queueKill(group); }
+
+		/**
+		 * Removes a member from a group
+		 * @param group index of the group
+		 */
+		void leave(uint32 group);
+
+		/**
+		 * @return time of the clock of every group
+		 */
+		const double* getTimes() const						{ return mTimes.data(); }
+
+		/**
+		 * @return if the clock of every group advances, 0 when the group is stopped
+		 */
+		const uint8* getRunning() const						{ return mRunning.data(); }
+
+		/**
+		 * @return if every group or one of its parents is cancelled or released, the members of these groups are killed
+		 */
+		const uint8* getCancelled() const					{ return mCancelled.data(); }
+
+		/**
+		 * Kills the members of a cancelled group at the start of the next update, once per group.
+		 * Called when the group is cancelled or released, and when a member joins or wakes up in a cancelled group.
+		 * @param group index of the cancelled group
+		 */
+		void queueKill(uint32 group);
+
+		/**
+		 * @return if the members of a cancelled group must be killed, see takeKillQueue()
+		 */
+		bool isKillPending() const							{ return !mKillQueue.empty(); }
+
+		/**
+		 * Hands the cancelled groups whose members must be killed to the caller and empties the queue.
+		 * The service passes them to TweenPoolBase::killCancelled() of every pool, groups queued in the meantime are killed next update.
+		 * @param groups receives the groups, swapped with the queue so neither allocates once both reached their peak size
+		 */
+		void takeKillQueue(std::vector<uint32>& groups);
+
+		/**
+		 * @param group index of the group
+		 * @return time of the clock of the group
+		 */
+		double getTime(uint32 group) const					{ return mTimes[group]; }
+
+		/**
+		 * @return number of groups, including the root group and released groups
+		 */
+		uint32 size() const									{ return static_cast<uint32>(mTimes.size()); }
+
+		/**
+		 * @param group index of the group
+		 * @param scale time scale of the group, 1 is real time
+		 */
+		void setTimeScale(uint32 group, float scale);
+
+		/**
+		 * @param group index of the group
+		 * @return time scale of the group
+		 */
+		float getTimeScale(uint32 group) const				{ return mGroups[group].mScale; }
+
+		/**
+		 * @param group index of the group
+		 * @return time scale of the group multiplied by the scale of its parents, 0 when stopped
+		 */
+		float getEffectiveTimeScale(uint32 group) const		{ return mGroups[group].mEffectiveScale; }
+
+		/**
+		 * @param group index of the group
+		 * @param paused if the group is paused
+		 */
+		void setPaused(uint32 group, bool paused)			{ mGroups[group].mPaused = paused; }
+
+		/**
+		 * @param group index of the group
+		 * @return if the group is paused
+		 */
+		bool isPaused(uint32 group) const					{ return mGroups[group].mPaused; }
+
+		/**
+		 * Stops the group and its child groups permanently, their members are killed at the start of the next update
+		 * @param group index of the group
+		 */
+		void cancel(uint32 group)							{ mGroups[group].mCancelled = true; }
+
+		/**
+		 * @param group index of the group
+		 * @return if the group is cancelled
+		 */
+		bool isCancelled(uint32 group) const				{ return mGroups[group].mCancelled; }
+
+		/**
+		 * @param group index of the group
+		 * @return number of tweens and child groups in the group
+		 */
+		uint32 getMemberCount(uint32 group) const			{ return mGroups[group].mMembers; }
+
+	private:
+		/**
+		 * Settings of a group
+		 */
+		struct Group
+		{
+			uint32		mParent = root;				///< Index of the parent group
+			float		mScale = 1.0f;				///< Time scale
+			float		mEffectiveScale = 1.0f;		///< Time scale including parents, 0 when stopped
+			uint32		mMembers = 0;				///< Number of tweens and child groups
+			bool		mPaused = false;			///< If the group is paused
+			bool		mCancelled = false;			///< If the group is cancelled
+			bool		mReleased = false;			///< If the group object was destroyed
+			bool		mKillQueued = false;		///< If the group is in the kill queue
+		};
+
+		/**
+		 * Makes the group available for reuse
+		 */
+		void free(uint32 group);
+
+		std::vector<double>		mTimes;			///< Clock of every group
+		std::vector<uint8>		mRunning;		///< If the clock of every group advances
+		std::vector<uint8>		mCancelled;		///< If every group or one of its parents is cancelled or released
+		std::vector<Group>		mGroups;		///< Settings of every group
+		std::vector<uint32>		mOrder;			///< Groups in use, parents before children
+		std::vector<uint32>		mFree;			///< Groups that can be reused
+		std::vector<uint32>		mKillQueue;		///< Cancelled groups whose members must be killed
+	};
+
+
+	/**
+	 * A group of tweens that shares a time scale, a paused state and a parent group.
+	 * Created by the TweenService, add a tween to a group with Tween::setGroup().
+	 * Pausing, scaling or cancelling a group applies to all its tweens and child groups in O(1).
+	 * The tweens of a paused group stay where they are, they don't dispatch signals or write their binding.
+	 * The tweens of a cancelled group are killed at the start of the next update, see cancel().
+	 * Destroying the group kills its tweens and the tweens of its child groups, like cancel().
+	 */
+	class NAPAPI TweenGroup
+	{
+	public:
+		/**
+		 * Constructor
+		 * @param clocks clocks of the service that creates the group
+		 * @param parent the parent group, nullptr for none
+		 */
+		TweenGroup(TweenClocks& clocks, TweenGroup* parent);
+
+		/**
+		 * Deconstructor, kills the tweens of the group and its child groups at the start of the next update, see cancel()
+		 */
+		~TweenGroup();
+
+		/**
+		 * Groups are not copyable
+		 */
+		TweenGroup(const TweenGroup&) = delete;
+		TweenGroup& operator=(const TweenGroup&) = delete;
+
+		/**
+		 * Changes the speed of all tweens in the group and its child groups
+		 * @param scale time scale, 1 is real time, 0 stops the group
+		 */
+		void setTimeScale(float scale)						{ mClocks.setTimeScale(mIndex, scale); }
+
+		/**
+		 * @return time scale of the group
+		 */
+		float getTimeScale() const							{ return mClocks.getTimeScale(mIndex); }
+
+		/**
+		 * @return time scale of the group multiplied by the scale of its parents during the last update, 0 when stopped
+		 */
+		float getEffectiveTimeScale() const					{ return mClocks.getEffectiveTimeScale(mIndex); }
+
+		/**
+		 * Pauses or resumes all tweens in the group and its child groups
+		 * @param paused if the group is paused
+		 */
+		void setPaused(bool paused)							{ mClocks.setPaused(mIndex, paused); }
+
+		/**
+		 * @return if the group is paused
+		 */
+		bool isPaused() const								{ return mClocks.isPaused(mIndex); }
+
+		/**
+		 * Kills all tweens in the group and its child groups, at the start of the next update.
+		 * Every tween that didn't complete dispatches its KilledSignal. Tweens started with TweenService::play() are removed,
+		 * the others complete and stay valid until their handle is destroyed. The group is stopped permanently,
+		 * tweens that join it later are killed as well.
+		 */
+		void cancel()										{ mClocks.cancel(mIndex); }
+
+		/**
+		 * @return if the group is cancelled
+		 */
+		bool isCancelled() const							{ return mClocks.isCancelled(mIndex); }
+
+		/**
+		 * @return time of the clock of the group in seconds
+		 */
+		double getTime() const								{ return mClocks.getTime(mIndex); }
+
+		/**
+		 * @return parent group, nullptr for none
+		 */
+		TweenGroup* getParent() const						{ return mParent; }
+
+		/**
+		 * @return number of tweens and child groups in the group
+		 */
+		uint32 getMemberCount() const						{ return mClocks.getMemberCount(mIndex); }
+
+		/**
+		 * @return index of the group in its clocks
+		 */
+		uint32 getIndex() const								{ return mIndex; }
+
+		/**
+		 * @return clocks the group belongs to
+		 */
+		const TweenClocks& getClocks() const				{ return mClocks; }
+
+	private:
+		TweenClocks&	mClocks;				///< Clocks of the service
+		TweenGroup*		mParent = nullptr;		///< Parent group
+		uint32			mIndex;					///< Index of the group in the clocks
+	};
+}
@@ -4,17 +4,122 @@
 
 #include "tweenhandle.h"
 #include "tweenservice.h"
+#include "tweenstorage.h"
+
+// external includes
+#include <mutex>
 
 namespace nap
 {
-	TweenHandleBase::TweenHandleBase(TweenService& tweenService)
-		: mService(tweenService)
+	/**
+	 * Shared memory of all handles, every handle type has the same size.
+	 * Handles can be destroyed on any thread, access is guarded by a mutex.
+	 */
+	struct TweenHandleStorage
+	{
+		std::mutex						mMutex;
+		TweenStorage<TweenHandleBase>	mStorage;
+	};
+
+
+	static TweenHandleStorage& getHandleStorage()
+	{
+		static TweenHandleStorage storage;
+		return storage;
+	}
+
+
+	void* TweenHandleBase::operator new(size_t size)
+	{
+		// handles that add members are allocated on the heap
+		if (size > TweenStorage<TweenHandleBase>::blockSize)
+			return ::operator new(size);
+
+		TweenHandleStorage& storage = getHandleStorage();
+		std::lock_guard<std::mutex> lock(storage.mMutex);
+		return storage.mStorage.allocate();
+	}
+
+
+	void TweenHandleBase::operator delete(void* memory, size_t size)
+	{
+		if (size > TweenStorage<TweenHandleBase>::blockSize)
+		{
+			::operator delete(memory);
+			return;
+		}
+
+		TweenHandleStorage& storage = getHandleStorage();
+		std::lock_guard<std::mutex> lock(storage.mMutex);
+		storage.mStorage.release(memory);
+	}
+
+
+	void TweenHandleBase::reserve(size_t capacity)
+	{
+		TweenHandleStorage& storage = getHandleStorage();
+		std::lock_guard<std::mutex> lock(storage.mMutex);
+		storage.mStorage.reserve(capacity);
+	}
+
+
+	size_t TweenHandleBase::getAllocationCount()
+	{
+		TweenHandleStorage& storage = getHandleStorage();
+		std::lock_guard<std::mutex> lock(storage.mMutex);
+		return storage.mStorage.getChunkCount();
+	}
+
+
+	TweenHandleBase::TweenHandleBase(TweenService& tweenService, TweenPoolBase& pool, TweenID id)
+		: mService(tweenService), mPool(pool), mID(id)
 	{
 
 	}
 
 	TweenHandleBase::~TweenHandleBase()
 	{
-		mService.removeTween(mTweenBase);
+		mService.removeTween(mPool, mID);
+	}
+
+
+	void TweenHandleBase::setLabel(const std::string& label)
+	{
+		mPool.setLabel(mID, mService.getName(label));
+	}
+
+
+	const char* TweenHandleBase::getLabel() const
+	{
+		return mPool.getLabel(mID);
+	}
+
+
+	BufferTween& BufferTweenHandle::getTween()
+	{
+		// the tween is only removed once the handle is destroyed
+		BufferTween* tween = static_cast<BufferTweenPool&>(mPool).find(mID);
+		assert(tween != nullptr);
+		return *tween;
+	}
+
+
+	TweenBatchHandleBase::TweenBatchHandleBase(TweenService& tweenService, TweenPoolBase& pool, std::vector<TweenID>&& ids)
+		: mService(tweenService), mPool(pool), mIDs(std::move(ids))
+	{
+	}
+
+
+	TweenBatchHandleBase::~TweenBatchHandleBase()
+	{
+		mService.removeTweens(mPool, mIDs);
+	}
+
+
+	void TweenBatchHandleBase::setLabel(const std::string& label)
+	{
+		const char* name = mService.getName(label);
+		for (const auto& id : mIDs)
+			mPool.setLabel(id, name);
 	}
 }
\ No newline at end of file
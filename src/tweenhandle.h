@@ -6,10 +6,13 @@
 
 // internal includes
 #include "tween.h"
+#include "tweenspring.h"
+#include "tweenbuffer.h"
 
 // external includes
 #include <mathutils.h>
 #include <nap/signalslot.h>
+#include <string>
 
 namespace nap
 {
@@ -20,53 +23,219 @@ namespace nap
 
 	/**
 	 * TweenHandle base class
-	 * Upon deconstruction, lets the service know the corresponding Tween can be deleted
+	 * Refers to the tween by its pool and id, upon deconstruction, lets the service know the corresponding Tween can be deleted
 	 */
 	class NAPAPI TweenHandleBase
 	{
 	public:
 		/**
 		 * Deconstructor
-		 * Notifies TweenService to mark mTweenBase for deletion
+		 * Notifies TweenService to mark the tween for deletion
 		 */
 		virtual ~TweenHandleBase();
+
+		/**
+		 * @return id of the tween in its pool
+		 */
+		TweenID getID() const				{ return mID; }
+
+		/**
+		 * Sets a label that identifies the tween in a trace, see TweenService::startTrace()
+		 * @param label the label, empty for none
+		 */
+		void setLabel(const std::string& label);
+
+		/**
+		 * @return label of the tween, nullptr when it has none
+		 */
+		const char* getLabel() const;
+
+		/**
+		 * Handles are allocated from a shared free list, creating and destroying handles doesn't touch the heap
+		 * once the free list has grown to its peak size
+		 */
+		static void* operator new(size_t size);
+		static void operator delete(void* memory, size_t size);
+
+		/**
+		 * Makes sure the given number of handles can be created without allocating memory
+		 * @param capacity number of handles
+		 */
+		static void reserve(size_t capacity);
+
+		/**
+		 * @return number of times the shared free list of all handles allocated memory
+		 */
+		static size_t getAllocationCount();
 	protected:
 		/**
-		 * Constructor, needs reference to the TweenService
+		 * Constructor, needs reference to the TweenService, the pool and id of the tween
 		 * @param tweenService the TweenService
+		 * @param pool the pool the tween is stored in
+		 * @param id the id of the tween in the pool
 		 */
-		TweenHandleBase(TweenService& tweenService);
+		TweenHandleBase(TweenService& tweenService, TweenPoolBase& pool, TweenID id);
 
 		// the TweenService
 		TweenService& mService;
 
-		// pointer to base class of tween
-		TweenBase* mTweenBase;
+		// pool the tween is stored in
+		TweenPoolBase& mPool;
+
+		// id of the tween in the pool
+		TweenID mID;
 	};
 
 	/**
 	 * A Handle to provide user access to create Tween functionality
 	 * @tparam T the value type to tween
+	 * @tparam Ease optional ease tag, when the ease is fixed at compile time
 	 */
-	template<typename T>
+	template<typename T, typename Ease = void>
 	class TweenHandle : public TweenHandleBase
 	{
 	public:
 		/**
-		 * Constructor, needs reference to TweenService and pointer to corresponding tween
+		 * Constructor, needs reference to TweenService and the pool and id of the corresponding tween
 		 * @param tweenService reference to the TweenService
-		 * @param tween pointer to Tween<T>
+		 * @param pool the pool the tween is stored in
+		 * @param id the id of the tween in the pool
 		 */
-		TweenHandle(TweenService& tweenService, Tween<T>* tween);
+		TweenHandle(TweenService& tweenService, TweenPool<T>& pool, TweenID id);
 	public:
 		/**
-		 * returns reference to corresponding Tween<T>
-		 * @return reference to corresponding Tween<T>
+		 * returns reference to corresponding Tween<T, Ease>
+		 * @return reference to corresponding Tween<T, Ease>
 		 */
-		Tween<T>& getTween(){ return *mTween; }
-	private:
-		// pointer to the tween
-		Tween<T>* mTween;
+		Tween<T, Ease>& getTween();
+	};
+
+
+	/**
+	 * A Handle to provide user access to a spring created by TweenService::createSpring
+	 * @tparam T the value type to tween
+	 */
+	template<typename T>
+	class SpringTweenHandle : public TweenHandleBase
+	{
+	public:
+		/**
+		 * Constructor, needs reference to TweenService and the pool and id of the corresponding spring
+		 * @param tweenService reference to the TweenService
+		 * @param pool the pool the spring is stored in
+		 * @param id the id of the spring in the pool
+		 */
+		SpringTweenHandle(TweenService& tweenService, SpringTweenPool<T>& pool, TweenID id) :
+			TweenHandleBase(tweenService, pool, id)				{ }
+
+		/**
+		 * returns reference to corresponding SpringTween<T>
+		 * @return reference to corresponding SpringTween<T>
+		 */
+		SpringTween<T>& getTween();
+	};
+
+
+	/**
+	 * A Handle to provide user access to a buffer tween created by TweenService::createBufferTween
+	 */
+	class NAPAPI BufferTweenHandle : public TweenHandleBase
+	{
+	public:
+		/**
+		 * Constructor, needs reference to TweenService and the pool and id of the corresponding tween
+		 * @param tweenService reference to the TweenService
+		 * @param pool the pool the tween is stored in
+		 * @param id the id of the tween in the pool
+		 */
+		BufferTweenHandle(TweenService& tweenService, BufferTweenPool& pool, TweenID id) :
+			TweenHandleBase(tweenService, pool, id)				{ }
+
+		/**
+		 * returns reference to corresponding BufferTween
+		 * @return reference to corresponding BufferTween
+		 */
+		BufferTween& getTween();
+	};
+
+
+	/**
+	 * Handle to a group of tweens created at once by TweenService::createTweens
+	 * Upon deconstruction, lets the service know all tweens of the group can be deleted
+	 */
+	class NAPAPI TweenBatchHandleBase
+	{
+	public:
+		/**
+		 * Deconstructor
+		 * Notifies TweenService to mark all tweens of the group for deletion
+		 */
+		virtual ~TweenBatchHandleBase();
+
+		/**
+		 * Batch handles are not copyable
+		 */
+		TweenBatchHandleBase(const TweenBatchHandleBase&) = delete;
+		TweenBatchHandleBase& operator=(const TweenBatchHandleBase&) = delete;
+
+		/**
+		 * @return number of tweens in the group
+		 */
+		size_t size() const									{ return mIDs.size(); }
+
+		/**
+		 * @param index index of the tween in the group
+		 * @return id of the tween in its pool
+		 */
+		TweenID getID(size_t index) const					{ return mIDs[index]; }
+
+		/**
+		 * Sets a label that identifies all tweens of the group in a trace, see TweenService::startTrace()
+		 * @param label the label, empty for none
+		 */
+		void setLabel(const std::string& label);
+	protected:
+		/**
+		 * Constructor, needs reference to the TweenService, the pool and ids of the tweens
+		 * @param tweenService the TweenService
+		 * @param pool the pool the tweens are stored in
+		 * @param ids the ids of the tweens in the pool
+		 */
+		TweenBatchHandleBase(TweenService& tweenService, TweenPoolBase& pool, std::vector<TweenID>&& ids);
+
+		// the TweenService
+		TweenService& mService;
+
+		// pool the tweens are stored in
+		TweenPoolBase& mPool;
+
+		// ids of the tweens in the pool, in order of creation
+		std::vector<TweenID> mIDs;
+	};
+
+
+	/**
+	 * Handle to a group of tweens of the same value type, provides access to every tween in the group
+	 * @tparam T the value type to tween
+	 */
+	template<typename T>
+	class TweenBatchHandle : public TweenBatchHandleBase
+	{
+	public:
+		/**
+		 * Constructor, needs reference to TweenService and the pool and ids of the corresponding tweens
+		 * @param tweenService reference to the TweenService
+		 * @param pool the pool the tweens are stored in
+		 * @param ids the ids of the tweens in the pool
+		 */
+		TweenBatchHandle(TweenService& tweenService, TweenPool<T>& pool, std::vector<TweenID>&& ids) :
+			TweenBatchHandleBase(tweenService, pool, std::move(ids))	{ }
+
+		/**
+		 * @param index index of the tween in the group
+		 * @return reference to the tween at the given index
+		 */
+		Tween<T>& getTween(size_t index);
 	};
 
 
@@ -78,17 +247,48 @@ namespace nap
 	using TweenHandleDouble = TweenHandle<double>;
 	using TweenHandleVec2 	= TweenHandle<glm::vec2>;
 	using TweenHandleVec3 	= TweenHandle<glm::vec3>;
+	using SpringTweenHandleFloat	= SpringTweenHandle<float>;
+	using SpringTweenHandleVec2		= SpringTweenHandle<glm::vec2>;
+	using SpringTweenHandleVec3		= SpringTweenHandle<glm::vec3>;
 
 
 	//////////////////////////////////////////////////////////////////////////
 	// Template Definitions
 	//////////////////////////////////////////////////////////////////////////
 
+	template<typename T, typename Ease>
+	TweenHandle<T, Ease>::TweenHandle(TweenService& tweenService, TweenPool<T>& pool, TweenID id)
+		: TweenHandleBase(tweenService, pool, id)
+	{ }
+
+
+	template<typename T, typename Ease>
+	Tween<T, Ease>& TweenHandle<T, Ease>::getTween()
+	{
+		// the tween is only removed once the handle is destroyed
+		Tween<T>* tween = static_cast<TweenPool<T>&>(mPool).find(mID);
+		assert(tween != nullptr);
+		return static_cast<Tween<T, Ease>&>(*tween);
+	}
+
+
+	template<typename T>
+	SpringTween<T>& SpringTweenHandle<T>::getTween()
+	{
+		// the spring is only removed once the handle is destroyed
+		SpringTween<T>* spring = static_cast<SpringTweenPool<T>&>(mPool).find(mID);
+		assert(spring != nullptr);
+		return *spring;
+	}
+
+
 	template<typename T>
-	TweenHandle<T>::TweenHandle(TweenService& tweenService, Tween<T>* tween)
-		: TweenHandleBase(tweenService), mTween(tween)
+	Tween<T>& TweenBatchHandle<T>::getTween(size_t index)
 	{
-		mTweenBase = tween;
+		// the tweens are only removed once the handle is destroyed
+		Tween<T>* tween = static_cast<TweenPool<T>&>(mPool).find(mIDs[index]);
+		assert(tween != nullptr);
+		return *tween;
 	}
 }
 
@@ -0,0 +1,44 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "tweeninstanced.h"
+
+// external includes
+#include <cassert>
+#include <cmath>
+
+namespace nap
+{
+	void staggerTweenPhases(float* phases, size_t count, float amount, ETweenStaggerFrom from, ETweenEaseType distribution)
+	{
+		assert(amount >= 0.0f); // an instance can't run ahead of the play head
+		if (count == 0)
+			return;
+
+		// distance of every instance to the origin, normalized so the furthest instance is at 1
+		float last = static_cast<float>(count - 1);
+		float center = last * 0.5f;
+		for (size_t i = 0; i < count; i++)
+		{
+			float index = static_cast<float>(i);
+			float distance = 0.0f;
+			switch (from)
+			{
+			case ETweenStaggerFrom::First:
+				distance = count > 1 ? index / last : 0.0f;
+				break;
+			case ETweenStaggerFrom::Last:
+				distance = count > 1 ? (last - index) / last : 0.0f;
+				break;
+			case ETweenStaggerFrom::Center:
+				distance = count > 2 ? std::abs(index - center) / center : 0.0f;
+				break;
+			case ETweenStaggerFrom::Edges:
+				distance = count > 2 ? 1.0f - std::abs(index - center) / center : 0.0f;
+				break;
+			}
+			phases[i] = amount * evaluateTweenEase(distribution, distance);
+		}
+	}
+}
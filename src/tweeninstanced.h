@@ -0,0 +1,370 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// internal includes
+#include "tweeneasing.h"
+#include "tweenmode.h"
+#include "tweenpool.h"
+#include "tweensimd.h"
+
+// external includes
+#include <mathutils.h>
+#include <nap/signalslot.h>
+#include <vector>
+#include <algorithm>
+
+namespace nap
+{
+	//////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * Instance the phases of a stagger grow from
+	 */
+	enum class ETweenStaggerFrom : int
+	{
+		First	= 0,		///< The first instance starts first, the last instance starts last
+		Last	= 1,		///< The last instance starts first
+		Center	= 2,		///< The center instances start first, the outer instances last
+		Edges	= 3			///< The outer instances start first, the center instances last
+	};
+
+	/**
+	 * Fills an array of phases that spread the start of the instances over time.
+	 * The instance the stagger grows from gets phase 0, the instance furthest away gets the given amount.
+	 * The distance between the two is mapped through an ease, a linear distribution gives every instance the same interval.
+	 * @param phases the phases to fill in seconds
+	 * @param count number of phases
+	 * @param amount phase of the instance furthest away from the origin in seconds, asserts when < 0
+	 * @param from instance the stagger grows from
+	 * @param distribution ease applied to the normalized distance from the origin
+	 */
+	NAPAPI void staggerTweenPhases(float* phases, size_t count, float amount, ETweenStaggerFrom from = ETweenStaggerFrom::First, ETweenEaseType distribution = ETweenEaseType::LINEAR);
+
+
+	//////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * One tween definition that drives many instances, for particle-like effects.
+	 * The duration, ease and mode are shared, every instance only stores its start value, end value and phase.
+	 * The phase is the time in seconds an instance lags behind the play head, an instance holds its start value until its phase is reached.
+	 * Instances are stored as separate arrays and evaluated with the batch ease and lerp kernels,
+	 * the values of all instances end up in one contiguous array that can be uploaded as instance data as is.
+	 * Call update() to advance the play head, or seek() to evaluate the instances at any time.
+	 * @tparam T the type of value that is tweened
+	 */
+	template<typename T>
+	class InstancedTween
+	{
+	public:
+		/**
+		 * Constructor
+		 * @param duration duration of every instance in seconds
+		 * @param easing the ease type shared by all instances
+		 * @param mode the tween mode shared by all instances
+		 */
+		InstancedTween(float duration, ETweenEaseType easing = ETweenEaseType::LINEAR, ETweenMode mode = ETweenMode::NORMAL);
+
+		/**
+		 * Adds an instance, its value is evaluated at the current play head
+		 * @param start start value
+		 * @param end end value
+		 * @param phase time the instance lags behind the play head in seconds
+		 * @return index of the instance
+		 */
+		uint32 add(const T& start, const T& end, float phase = 0.0f);
+
+		/**
+		 * Reserves memory for the given number of instances
+		 * @param count number of instances
+		 */
+		void reserve(uint32 count);
+
+		/**
+		 * Removes all instances, doesn't move the play head
+		 */
+		void clear();
+
+		/**
+		 * @return number of instances
+		 */
+		uint32 getCount() const										{ return static_cast<uint32>(mValues.size()); }
+
+		/**
+		 * Sets the start value of an instance, applied at the next update or seek
+		 * @param index index of the instance
+		 * @param start start value
+		 */
+		void setStart(uint32 index, const T& start)					{ assert(index < getCount()); mStart[index] = start; }
+
+		/**
+		 * Sets the end value of an instance, applied at the next update or seek
+		 * @param index index of the instance
+		 * @param end end value
+		 */
+		void setEnd(uint32 index, const T& end)						{ assert(index < getCount()); mEnd[index] = end; }
+
+		/**
+		 * Sets the phase of an instance, applied at the next update or seek
+		 * @param index index of the instance
+		 * @param phase time the instance lags behind the play head in seconds
+		 */
+		void setPhase(uint32 index, float phase);
+
+		/**
+		 * Spreads the phases of all instances over time, see staggerTweenPhases()
+		 * @param amount phase of the instance furthest away from the origin in seconds, asserts when < 0
+		 * @param from instance the stagger grows from
+		 * @param distribution ease applied to the normalized distance from the origin
+		 */
+		void stagger(float amount, ETweenStaggerFrom from = ETweenStaggerFrom::First, ETweenEaseType distribution = ETweenEaseType::LINEAR);
+
+		/**
+		 * @return start values of all instances, can be written to change many instances at once
+		 */
+		T* getStartValues()											{ return mStart.data(); }
+
+		/**
+		 * @return end values of all instances, can be written to change many instances at once
+		 */
+		T* getEndValues()											{ return mEnd.data(); }
+
+		/**
+		 * @return phases of all instances in seconds
+		 */
+		const float* getPhases() const								{ return mPhase.data(); }
+
+		/**
+		 * @return values of all instances at the play head, contiguous
+		 */
+		const T* getValues() const									{ return mValues.data(); }
+
+		/**
+		 * @param index index of the instance
+		 * @return value of the instance at the play head
+		 */
+		const T& getValue(uint32 index) const						{ return mValues[index]; }
+
+		/**
+		 * @param duration duration of every instance in seconds
+		 */
+		void setDuration(float duration)							{ mDuration = duration; }
+
+		/**
+		 * @return duration of every instance in seconds
+		 */
+		float getDuration() const									{ return mDuration; }
+
+		/**
+		 * @param easing the ease type shared by all instances
+		 */
+		void setEasing(ETweenEaseType easing)						{ mEasing = easing; }
+
+		/**
+		 * @return the ease type shared by all instances
+		 */
+		ETweenEaseType getEasing() const							{ return mEasing; }
+
+		/**
+		 * @param mode the tween mode shared by all instances
+		 */
+		void setMode(ETweenMode mode)								{ mMode = mode; }
+
+		/**
+		 * @return the tween mode shared by all instances
+		 */
+		ETweenMode getMode() const									{ return mMode; }
+
+		/**
+		 * Advances the play head and evaluates all instances, dispatches the CompleteSignal when the last instance completes.
+		 * Looping and ping pong instances never complete.
+		 * @param deltaTime time in seconds since last update
+		 */
+		void update(double deltaTime);
+
+		/**
+		 * Moves the play head and evaluates all instances, doesn't dispatch any signal
+		 * @param time time in seconds
+		 */
+		void seek(double time);
+
+		/**
+		 * @return current time of the play head in seconds
+		 */
+		double getTime() const										{ return mTime; }
+
+		/**
+		 * @return time at which the last instance completes, the duration plus the largest phase
+		 */
+		double getEndTime() const									{ return static_cast<double>(mDuration) + mMaxPhase; }
+
+		/**
+		 * @return if all instances are at their end value, always false for looping and ping pong instances
+		 */
+		bool isComplete() const;
+
+		/**
+		 * Complete signal dispatched when the last instance completes
+		 */
+		Signal<> CompleteSignal;
+
+	private:
+		/**
+		 * @return linear progress of a single instance at the play head, evaluate() computes it for all instances at once
+		 */
+		float getProgress(float phase) const;
+
+		/**
+		 * Computes the progress of every instance at the play head and interpolates their values
+		 */
+		void evaluate();
+
+		std::vector<T>			mStart;								///< Start value of every instance
+		std::vector<T>			mEnd;								///< End value of every instance
+		std::vector<float>		mPhase;								///< Phase of every instance in seconds
+		std::vector<float>		mProgress;							///< Eased progress of every instance, scratch space of evaluate()
+		std::vector<T>			mValues;							///< Value of every instance at the play head
+		float					mDuration = 0.0f;					///< Duration of every instance
+		ETweenEaseType			mEasing = ETweenEaseType::LINEAR;	///< Shared ease type
+		ETweenMode				mMode = ETweenMode::NORMAL;			///< Shared tween mode
+		float					mMaxPhase = 0.0f;					///< Largest phase, phases are never negative
+		double					mTime = 0.0;						///< Play head
+	};
+
+
+	//////////////////////////////////////////////////////////////////////////
+	// Template Definitions
+	//////////////////////////////////////////////////////////////////////////
+
+	template<typename T>
+	InstancedTween<T>::InstancedTween(float duration, ETweenEaseType easing, ETweenMode mode) :
+		mDuration(duration), mEasing(easing), mMode(mode)
+	{ }
+
+
+	template<typename T>
+	uint32 InstancedTween<T>::add(const T& start, const T& end, float phase)
+	{
+		assert(phase >= 0.0f); // an instance can't run ahead of the play head
+		mStart.emplace_back(start);
+		mEnd.emplace_back(end);
+		mPhase.emplace_back(phase);
+		mProgress.emplace_back(0.0f);
+		mValues.emplace_back(start);
+		mMaxPhase = std::max(mMaxPhase, phase);
+
+		uint32 index = getCount() - 1;
+		mProgress[index] = evaluateTweenEase(mEasing, getProgress(phase));
+		mValues[index] = mProgress[index] * (end - start) + start;
+		return index;
+	}
+
+
+	template<typename T>
+	void InstancedTween<T>::reserve(uint32 count)
+	{
+		mStart.reserve(count);
+		mEnd.reserve(count);
+		mPhase.reserve(count);
+		mProgress.reserve(count);
+		mValues.reserve(count);
+	}
+
+
+	template<typename T>
+	void InstancedTween<T>::clear()
+	{
+		mStart.clear();
+		mEnd.clear();
+		mPhase.clear();
+		mProgress.clear();
+		mValues.clear();
+		mMaxPhase = 0.0f;
+	}
+
+
+	template<typename T>
+	void InstancedTween<T>::setPhase(uint32 index, float phase)
+	{
+		assert(index < getCount());
+		assert(phase >= 0.0f); // an instance can't run ahead of the play head
+
+		// only search for the largest phase when the largest one shrinks
+		bool largest = mPhase[index] >= mMaxPhase;
+		mPhase[index] = phase;
+		if (phase >= mMaxPhase)
+			mMaxPhase = phase;
+		else if (largest)
+			mMaxPhase = *std::max_element(mPhase.begin(), mPhase.end());
+	}
+
+
+	template<typename T>
+	void InstancedTween<T>::stagger(float amount, ETweenStaggerFrom from, ETweenEaseType distribution)
+	{
+		staggerTweenPhases(mPhase.data(), mPhase.size(), amount, from, distribution);
+		mMaxPhase = mPhase.empty() ? 0.0f : *std::max_element(mPhase.begin(), mPhase.end());
+	}
+
+
+	template<typename T>
+	bool InstancedTween<T>::isComplete() const
+	{
+		return (mMode == ETweenMode::NORMAL || mMode == ETweenMode::REVERSE) && mTime >= getEndTime();
+	}
+
+
+	template<typename T>
+	void InstancedTween<T>::update(double deltaTime)
+	{
+		bool complete = isComplete();
+		seek(mTime + deltaTime);
+		if (!complete && isComplete())
+			CompleteSignal();
+	}
+
+
+	template<typename T>
+	void InstancedTween<T>::seek(double time)
+	{
+		mTime = std::max(time, 0.0);
+		evaluate();
+	}
+
+
+	template<typename T>
+	float InstancedTween<T>::getProgress(float phase) const
+	{
+		// same progress as a regular tween that started phase seconds after the play head
+		double cycle = TweenPool<float>::getCycleTime(mMode, mTime - phase, mDuration);
+		return TweenPool<float>::getProgress(mMode, cycle, mDuration);
+	}
+
+
+	template<typename T>
+	void InstancedTween<T>::evaluate()
+	{
+		size_t count = mValues.size();
+		if (count == 0)
+			return;
+
+		// linear progress of every instance, eased and interpolated in batches afterwards
+		const float* phase = mPhase.data();
+		float* progress = mProgress.data();
+		for (size_t i = 0; i < count; i++)
+			progress[i] = getProgress(phase[i]);
+
+		evaluateEaseBatch(mEasing, progress, progress, count);
+		if constexpr (hasTweenLerpBatch<T>)
+		{
+			lerpBatch(mStart.data(), mEnd.data(), progress, mValues.data(), count);
+		}
+		else
+		{
+			for (size_t i = 0; i < count; i++)
+				mValues[i] = progress[i] * (mEnd[i] - mStart[i]) + mStart[i];
+		}
+	}
+}
@@ -0,0 +1,2230 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// internal includes
+#include "tweeneasing.h"
+#include "tweenmode.h"
+#include "tweensimd.h"
+#include "tweenstorage.h"
+#include "tweeneasetable.h"
+#include "tweengroup.h"
+#include "tweentrace.h"
+
+// external includes
+#include <mathutils.h>
+#include <vector>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <new>
+#include <cmath>
+
+namespace nap
+{
+	//////////////////////////////////////////////////////////////////////////
+
+	// forward declares
+	template<typename T, typename Ease = void>
+	class Tween;
+
+	/**
+	 * Number of available tween modes, used to compute the bucket of a tween
+	 */
+	constexpr uint32 tweenModeCount = static_cast<uint32>(ETweenMode::REVERSE) + 1;
+
+	/**
+	 * Number of tweens advanced before they are eased and interpolated in one batch
+	 */
+	constexpr uint32 tweenBatchSize = 256;
+
+	/**
+	 * Identifies a tween in its pool by slot and generation.
+	 * The generation of a slot is incremented every time its tween is removed,
+	 * which invalidates all ids that still refer to the removed tween.
+	 */
+	struct NAPAPI TweenID
+	{
+		uint32 mSlot = std::numeric_limits<uint32>::max();			///< Slot in the pool
+		uint32 mGeneration = 0;										///< Generation of the slot when the tween was added
+
+		bool operator==(const TweenID& other) const		{ return mSlot == other.mSlot && mGeneration == other.mGeneration; }
+		bool operator!=(const TweenID& other) const		{ return !(*this == other); }
+	};
+
+
+	// forward declares
+	class TweenPoolBase;
+
+	/**
+	 * Signals raised by a tween during evaluation, dispatched afterwards on the main thread
+	 */
+	struct TweenEvent
+	{
+		uint32 	mSlot;			///< Slot of the tween
+		uint8	mEvents;		///< Raised events
+	};
+
+	/**
+	 * A range of tweens in one bucket of a pool that is evaluated as a single unit of work.
+	 * Ranges never overlap, different ranges can be evaluated on different threads at the same time.
+	 */
+	struct TweenRange
+	{
+		TweenPoolBase*	mPool = nullptr;	///< Pool that holds the tweens
+		uint32			mBucket = 0;		///< Bucket in the pool
+		uint32			mBegin = 0;			///< First tween in the bucket
+		uint32			mEnd = 0;			///< One past the last tween in the bucket
+	};
+
+	/**
+	 * Output binding of a tween: a memory location or an accessor that receives the value of the tween every update.
+	 * Bindings are applied while the tweens are evaluated, without dispatching a signal.
+	 * @tparam T the type of value that is tweened
+	 */
+	template<typename T>
+	struct TweenBinding
+	{
+		/**
+		 * Accessor that writes a value into the target object
+		 */
+		using Setter = void(*)(void* target, const T& value);
+
+		void*	mTarget = nullptr;		///< Bound memory or object, nullptr when not bound
+		Setter	mSetter = nullptr;		///< Accessor, nullptr when the value is copied into mTarget
+
+		/**
+		 * Writes the value into the bound memory or object
+		 * @param value the value to write
+		 */
+		void apply(const T& value) const
+		{
+			if (mSetter != nullptr)
+				mSetter(mTarget, value);
+			else
+				*static_cast<T*>(mTarget) = value;
+		}
+	};
+
+
+	/**
+	 * Type independent interface of a tween pool
+	 */
+	class NAPAPI TweenPoolBase
+	{
+	public:
+		/**
+		 * Invalid slot or index value
+		 */
+		static constexpr uint32 invalid = std::numeric_limits<uint32>::max();
+
+		/**
+		 * Default deconstructor
+		 */
+		virtual ~TweenPoolBase() = default;
+
+		/**
+		 * Advances and evaluates all tweens in the pool, dispatches signals afterwards
+		 * @param deltaTime time in seconds since last update
+		 */
+		virtual void update(double deltaTime) = 0;
+
+		/**
+		 * Advances and evaluates all tweens in the pool, the raised signals are dispatched by dispatch()
+		 * @param deltaTime time in seconds since last update
+		 */
+		virtual void evaluate(double deltaTime) = 0;
+
+		/**
+		 * Dispatches the signals raised by the last call to evaluate(), must be called on the main thread
+		 */
+		virtual void dispatch() = 0;
+
+		/**
+		 * Advances the clocks of the pool when it owns them and wakes tweens whose delay expired, call before evaluating any range.
+		 * Tweens are evaluated at the new clock, a large delta time jumps straight to the correct phase of every tween.
+		 * @param deltaTime time in seconds since last update
+		 */
+		virtual void beginUpdate(double deltaTime) = 0;
+
+		/**
+		 * Makes the pool follow the given group clocks instead of its own, call before any tween is added
+		 * @param clocks the clocks, advanced by their owner
+		 */
+		virtual void setClocks(TweenClocks& clocks) = 0;
+
+		/**
+		 * Moves tweens that completed during the update to the dormant set, call after all ranges are evaluated
+		 */
+		virtual void endUpdate() = 0;
+
+		/**
+		 * Splits all active tweens in the pool into ranges that can be evaluated independently
+		 * @param maxSize maximum number of tweens in a range
+		 * @param ranges the ranges to append to
+		 */
+		virtual void getRanges(uint32 maxSize, std::vector<TweenRange>& ranges) = 0;
+
+		/**
+		 * Evaluates the tweens in a range at the clock of the pool without dispatching signals.
+		 * Safe to call from any thread, as long as no other thread touches the same range and the pool isn't modified.
+		 * @param range the range to evaluate, obtained from getRanges()
+		 * @param events receives the raised signals, in order
+		 */
+		virtual void updateRange(const TweenRange& range, std::vector<TweenEvent>& events) = 0;
+
+		/**
+		 * Dispatches signals raised by updateRange(), must be called on the main thread
+		 * @param events the events to dispatch
+		 */
+		virtual void dispatch(const std::vector<TweenEvent>& events) = 0;
+
+		/**
+		 * Stages the tweens added from now on: they stay dormant until they are merged, call before an update evaluates any tween.
+		 * Tweens created by signal handlers during the update start at the same point in the update, regardless of the order of the pools.
+		 */
+		virtual void beginStaging() = 0;
+
+		/**
+		 * Moves the tweens that were added since beginStaging() into the active set in one pass, call once all signals of the update are dispatched
+		 * @param evaluate if the merged tweens are evaluated right away: their binding and update signal receive the start value in this update
+		 * @return number of merged tweens
+		 */
+		virtual uint32 merge(bool evaluate) = 0;
+
+		/**
+		 * Removes the recycled tweens that completed during the last update, call after their signals are dispatched.
+		 * A tween that was restarted by a handler of its complete signal keeps playing.
+		 */
+		virtual void recycle() = 0;
+
+		/**
+		 * Kills every tween that didn't complete yet in the given cancelled groups, see TweenClocks::takeKillQueue().
+		 * Only the members of these groups are visited. Dispatches the KilledSignal of these tweens, recycled tweens are removed, the others complete.
+		 * @param groups indices of the cancelled groups
+		 */
+		virtual void killCancelled(const std::vector<uint32>& groups) = 0;
+
+		/**
+		 * Removes the output binding of a tween, ignored when the id is no longer valid
+		 * @param id the id of the tween
+		 */
+		virtual void unbind(TweenID id) = 0;
+
+		/**
+		 * Removes the tween with the given id in O(1), ignored when the id is no longer valid.
+		 * Dispatches the KilledSignal of the tween when it isn't completed yet
+		 * @param id the id of the tween to remove
+		 */
+		virtual void remove(TweenID id) = 0;
+
+		/**
+		 * @param id the id to validate
+		 * @return if the id refers to a tween in this pool
+		 */
+		virtual bool isValid(TweenID id) const = 0;
+
+		/**
+		 * @return number of tweens in the pool
+		 */
+		virtual size_t size() const = 0;
+
+		/**
+		 * @return number of tweens that are evaluated every update
+		 */
+		virtual size_t getActiveCount() const = 0;
+
+		/**
+		 * @return number of completed, paused or delayed tweens, these cost nothing to update
+		 */
+		size_t getDormantCount() const				{ return size() - getActiveCount(); }
+
+		/**
+		 * @return number of memory allocations made by the pool since it was created
+		 */
+		virtual size_t getAllocationCount() const = 0;
+
+		/**
+		 * Records the lifecycle events of all tweens in the pool into the given trace
+		 * @param trace the trace to record into, nullptr stops recording
+		 * @param type name of the tweened value type, must outlive the trace
+		 */
+		virtual void setTrace(TweenTrace* trace, const char* type) = 0;
+
+		/**
+		 * Sets the label that identifies the tween in a trace, ignored when the id is no longer valid
+		 * @param id the id of the tween
+		 * @param label the label, nullptr for none, must outlive the trace
+		 */
+		virtual void setLabel(TweenID id, const char* label) = 0;
+
+		/**
+		 * @param id the id of the tween
+		 * @return label of the tween, nullptr when it has none or the id is no longer valid
+		 */
+		virtual const char* getLabel(TweenID id) const = 0;
+	};
+
+
+	/**
+	 * Stable slots that map the id of a tween to where its pool currently stores it, shared by all pools.
+	 * Released slots are reused through a free list, the generation of a slot is incremented every time it's released,
+	 * which invalidates all ids that still refer to it.
+	 * The slots of every group other than the root are linked into a list, which lets a pool kill the members of a cancelled group
+	 * without looking at any other tween.
+	 * @tparam Slot the slot of a pool, has an mIndex and mGeneration member, mIndex is invalid while the slot is free
+	 */
+	template<typename Slot>
+	class TweenSlots
+	{
+	public:
+		/**
+		 * @return a free slot, reused when possible
+		 */
+		uint32 allocate();
+
+		/**
+		 * Frees a slot, invalidates all ids that refer to it
+		 * @param slot the slot to release
+		 */
+		void release(uint32 slot);
+
+		/**
+		 * Dispatches the KilledSignal of a tween that is about to be removed, when it isn't completed.
+		 * Handlers can create tweens, which grows the slots, or change and remove the tween:
+		 * references into the slots or the state of the tween must be looked up again afterwards.
+		 * @param id the id of the tween
+		 * @param tween the tween in the slot of the id
+		 * @param completed if the tween completed, completed tweens aren't killed
+		 * @return if the id is still valid, false when a handler removed the tween
+		 */
+		template<typename Tween>
+		bool kill(TweenID id, Tween& tween, bool completed);
+
+		/**
+		 * Adds a slot to the member list of a group in O(1), members of the root group aren't listed
+		 * @param slot the slot of the tween
+		 * @param group index of the group
+		 */
+		void join(uint32 slot, uint32 group);
+
+		/**
+		 * Removes a slot from the member list of a group in O(1)
+		 * @param slot the slot of the tween
+		 * @param group index of the group the slot joined
+		 */
+		void leave(uint32 slot, uint32 group);
+
+		/**
+		 * @param group index of the group
+		 * @return first slot in the member list of the group, invalid when the list is empty
+		 */
+		uint32 getFirstMember(uint32 group) const	{ return group < mFirstMembers.size() ? mFirstMembers[group] : TweenPoolBase::invalid; }
+
+		/**
+		 * @param slot a slot in the member list of a group
+		 * @return next slot in the member list of the group, invalid at the end of the list
+		 */
+		uint32 getNextMember(uint32 slot) const		{ return mMembers[slot].mNext; }
+
+		/**
+		 * @param id the id to validate
+		 * @return if the id refers to a slot in use
+		 */
+		bool isValid(TweenID id) const		{ return id.mSlot < mSlots.size() && mSlots[id.mSlot].mGeneration == id.mGeneration && mSlots[id.mSlot].mIndex != TweenPoolBase::invalid; }
+
+		/**
+		 * Makes sure the given number of slots can be allocated without allocating memory
+		 * @param capacity number of slots
+		 */
+		void reserve(size_t capacity);
+
+		/**
+		 * @return number of slots in use
+		 */
+		size_t size() const					{ return mSlots.size() - mFree.size(); }
+
+		/**
+		 * @return number of memory allocations made since the slots were created
+		 */
+		size_t getAllocationCount() const	{ return mAllocations; }
+
+		Slot& operator[](uint32 slot)					{ return mSlots[slot]; }
+		const Slot& operator[](uint32 slot) const		{ return mSlots[slot]; }
+		typename std::vector<Slot>::iterator begin()	{ return mSlots.begin(); }
+		typename std::vector<Slot>::iterator end()		{ return mSlots.end(); }
+
+	private:
+		/**
+		 * Links a slot into the member list of its group
+		 */
+		struct Member
+		{
+			uint32			mPrevious = TweenPoolBase::invalid;	///< Previous slot in the list, invalid for the first
+			uint32			mNext = TweenPoolBase::invalid;		///< Next slot in the list, invalid for the last
+		};
+
+		std::vector<Slot>	mSlots;				///< All slots, used and free
+		std::vector<Member>	mMembers;			///< Member list links of every slot
+		std::vector<uint32>	mFirstMembers;		///< First slot in the member list of every group
+		std::vector<uint32>	mFree;				///< Slots that can be reused
+		size_t				mAllocations = 0;	///< Number of times the arrays allocated memory
+	};
+
+
+	/**
+	 * Stores all tweens of type T in contiguous per (mode, ease) buckets.
+	 * Every bucket holds the start time, duration, start, end and current value of its tweens in separate arrays,
+	 * which allows the pool to update a whole bucket in one tight loop.
+	 * A tween doesn't accumulate time: it stores the clock of the pool at which it started, in double precision,
+	 * and is evaluated as a function of that timestamp and the clock. Seeking and evaluating at any time is O(1) for every mode.
+	 * Every tween follows the clock of its group, see TweenGroup. A pool owns a clock with only the root group,
+	 * unless it follows the clocks of a service.
+	 * Lazy tweens are stored in separate buckets that only check for completion every update,
+	 * their value is computed when it's read, at most once per update.
+	 * A Tween<T> is a view onto a slot in the pool, the slot points to the bucket and index the tween is currently stored at.
+	 * Slots are reused, a generation counter per slot makes sure a stale TweenID never resolves to a newer tween.
+	 * Removing a tween is O(1): the last tween of its bucket is moved into its place.
+	 * Signals are dispatched after all buckets are evaluated, so handlers can safely change or create tweens.
+	 * @tparam T the type of value that is tweened
+	 */
+	template<typename T>
+	class TweenPool : public TweenPoolBase
+	{
+		template<typename, typename> friend class Tween;
+	public:
+		/**
+		 * Constructor
+		 */
+		TweenPool() = default;
+
+		/**
+		 * Deconstructor, deletes all tweens owned by the pool
+		 */
+		~TweenPool() override;
+
+		/**
+		 * Makes sure the given number of tweens can be created without allocating memory
+		 * @param capacity number of tweens
+		 */
+		void reserve(size_t capacity);
+
+		/**
+		 * Evaluates all eases by sampling the given table instead of the analytic ease
+		 * @param table the ease table, nullptr to evaluate the analytic eases
+		 */
+		void setEaseTable(const TweenEaseTable* table)		{ mEaseTable = table; }
+
+		/**
+		 * Sets if tweens added from now on are lazy, see Tween::setLazy()
+		 * @param lazy if new tweens are lazy
+		 */
+		void setLazy(bool lazy)								{ mLazy = lazy; }
+
+		/**
+		 * Constructs a new tween owned by the pool
+		 * @param start start value of the tween
+		 * @param end end value of the tween
+		 * @param duration duration of the tween
+		 * @param easing the ease type
+		 * @param mode the tween mode
+		 * @return the new tween
+		 */
+		Tween<T>& create(const T& start, const T& end, float duration, ETweenEaseType easing, ETweenMode mode);
+
+		/**
+		 * Constructs a new tween owned by the pool, with an ease that is fixed at compile time
+		 * @param start start value of the tween
+		 * @param end end value of the tween
+		 * @param duration duration of the tween
+		 * @param mode the tween mode
+		 * @tparam Ease the ease tag
+		 * @return the new tween
+		 */
+		template<typename Ease>
+		Tween<T, Ease>& create(const T& start, const T& end, float duration, ETweenMode mode);
+
+		/**
+		 * Adds a tween that is owned by someone else to the pool
+		 * @param tween the tween to add
+		 * @param start start value of the tween
+		 * @param end end value of the tween
+		 * @param duration duration of the tween
+		 * @param easing the ease type
+		 * @param mode the tween mode
+		 * @param fixedEase if the ease of the tween can't be changed
+		 * @return the id of the tween
+		 */
+		TweenID add(Tween<T>* tween, const T& start, const T& end, float duration, ETweenEaseType easing, ETweenMode mode, bool fixedEase = false);
+
+		/**
+		 * Advances and evaluates all tweens in the pool, dispatches signals afterwards
+		 * @param deltaTime time in seconds since last update
+		 */
+		void update(double deltaTime) override;
+
+		/**
+		 * Advances and evaluates all tweens in the pool, the raised signals are dispatched by dispatch()
+		 * @param deltaTime time in seconds since last update
+		 */
+		void evaluate(double deltaTime) override;
+
+		/**
+		 * Dispatches the signals raised by the last call to evaluate()
+		 */
+		void dispatch() override					{ dispatch(mEvents); }
+
+		/**
+		 * Advances the clocks of the pool when it owns them and wakes tweens whose delay expired
+		 * @param deltaTime time in seconds since last update
+		 */
+		void beginUpdate(double deltaTime) override;
+
+		/**
+		 * Makes the pool follow the given group clocks instead of its own
+		 * @param clocks the clocks, advanced by their owner
+		 */
+		void setClocks(TweenClocks& clocks) override;
+
+		/**
+		 * Moves tweens that completed during the update to the dormant set
+		 */
+		void endUpdate() override;
+
+		/**
+		 * Splits all active tweens in the pool into ranges that can be evaluated independently
+		 * @param maxSize maximum number of tweens in a range
+		 * @param ranges the ranges to append to
+		 */
+		void getRanges(uint32 maxSize, std::vector<TweenRange>& ranges) override;
+
+		/**
+		 * Evaluates the tweens in a range at the clock of the pool without dispatching signals
+		 * @param range the range to evaluate
+		 * @param events receives the raised signals, in order
+		 */
+		void updateRange(const TweenRange& range, std::vector<TweenEvent>& events) override;
+
+		/**
+		 * Dispatches signals raised by updateRange()
+		 * @param events the events to dispatch
+		 */
+		void dispatch(const std::vector<TweenEvent>& events) override;
+
+		/**
+		 * Stages the tweens added from now on, see TweenPoolBase::beginStaging()
+		 */
+		void beginStaging() override								{ mStaging = true; }
+
+		/**
+		 * Merges the staged tweens into the active set, see TweenPoolBase::merge()
+		 */
+		uint32 merge(bool evaluate) override;
+
+		/**
+		 * Removes the recycled tweens that completed during the last update, call after their signals are dispatched
+		 */
+		void recycle() override;
+
+		/**
+		 * Kills every tween that didn't complete yet in the given cancelled groups.
+		 * Dispatches the KilledSignal of these tweens, recycled tweens are removed, the others complete.
+		 * @param groups indices of the cancelled groups
+		 */
+		void killCancelled(const std::vector<uint32>& groups) override;
+
+		/**
+		 * Removes the tween from the pool as soon as it completed and its signals are dispatched, see TweenService::play()
+		 * @param id the id of the tween
+		 */
+		void setRecycled(TweenID id);
+
+		/**
+		 * Binds the output of a tween, replaces the current binding
+		 * @param id the id of the tween
+		 * @param binding the memory or accessor that receives the value
+		 */
+		void bind(TweenID id, const TweenBinding<T>& binding);
+
+		/**
+		 * Removes the output binding of a tween, ignored when the id is no longer valid
+		 * @param id the id of the tween
+		 */
+		void unbind(TweenID id) override;
+
+		/**
+		 * Removes the tween with the given id in O(1), ignored when the id is no longer valid
+		 * @param id the id of the tween to remove
+		 */
+		void remove(TweenID id) override;
+
+		/**
+		 * @param id the id to validate
+		 * @return if the id refers to a tween in this pool
+		 */
+		bool isValid(TweenID id) const override;
+
+		/**
+		 * @param id the id of the tween
+		 * @return the tween with the given id, nullptr if the id is no longer valid
+		 */
+		Tween<T>* find(TweenID id) const;
+
+		/**
+		 * @return number of tweens in the pool
+		 */
+		size_t size() const override				{ return mSlots.size(); }
+
+		/**
+		 * @return number of tweens that are evaluated every update
+		 */
+		size_t getActiveCount() const override		{ return mActiveCount; }
+
+		/**
+		 * @return number of memory allocations made by the pool since it was created
+		 */
+		size_t getAllocationCount() const override	{ return mAllocations + mSlots.getAllocationCount() + mTweenStorage.getChunkCount(); }
+
+		/**
+		 * Records the lifecycle events of all tweens in the pool into the given trace
+		 * @param trace the trace to record into, nullptr stops recording
+		 * @param type name of the tweened value type, must outlive the trace
+		 */
+		void setTrace(TweenTrace* trace, const char* type) override	{ mTrace = trace; mTraceType = type; }
+
+		/**
+		 * Sets the label that identifies the tween in a trace, ignored when the id is no longer valid
+		 * @param id the id of the tween
+		 * @param label the label, nullptr for none, must outlive the trace
+		 */
+		void setLabel(TweenID id, const char* label) override;
+
+		/**
+		 * @param id the id of the tween
+		 * @return label of the tween, nullptr when it has none or the id is no longer valid
+		 */
+		const char* getLabel(TweenID id) const override		{ return isValid(id) ? mSlots[id.mSlot].mLabel : nullptr; }
+
+		/**
+		 * @return time of the root clock in seconds
+		 */
+		double getClock() const						{ return mClocks->getTime(TweenClocks::root); }
+
+		/**
+		 * Wraps the time since the start of a tween into its current cycle:
+		 * NORMAL and REVERSE tweens are clamped to their duration, LOOP tweens wrap at their duration
+		 * and PING_PONG tweens wrap at twice their duration.
+		 * @param mode the tween mode
+		 * @param time time since the start of the tween in seconds
+		 * @param duration duration of the tween
+		 * @return time since the start of the current cycle
+		 */
+		static double getCycleTime(ETweenMode mode, double time, float duration);
+
+		/**
+		 * @param mode the tween mode
+		 * @param cycleTime time since the start of the current cycle, see getCycleTime()
+		 * @param duration duration of the tween
+		 * @return linear progress of the tween ( 0 - 1 )
+		 */
+		static float getProgress(ETweenMode mode, double cycleTime, float duration);
+
+	private:
+		/**
+		 * Tween state flags
+		 */
+		enum EFlags : uint8
+		{
+			Complete	= 1 << 0,		///< Tween completed
+			Listening	= 1 << 1,		///< A handler is connected to the update or complete signal
+			Paused		= 1 << 2,		///< Tween is paused
+			Delayed		= 1 << 3,		///< Tween waits for its delay to expire
+			Retargeted	= 1 << 4,		///< Tween carries a velocity correction, see retarget()
+			Staged		= 1 << 5,		///< Tween was added during an update and waits to be merged, see beginStaging()
+
+			Dormant		= Complete | Paused | Delayed | Staged		///< Tween isn't evaluated when any of these is set
+		};
+
+		/**
+		 * Events raised during evaluation
+		 */
+		enum EEvents : uint8
+		{
+			Updated		= 1 << 0,		///< Value changed, UpdateSignal
+			Completed	= 1 << 1		///< Tween completed, CompleteSignal
+		};
+
+		/**
+		 * All tweens that share the same mode and ease type.
+		 * Active tweens are stored in front [0, mActive), dormant tweens after them.
+		 */
+		struct Bucket
+		{
+			/**
+			 * Number of arrays that hold the state of the tweens, they grow at the same time
+			 */
+			static constexpr size_t arrayCount = 9;
+
+			Bucket(ETweenMode mode, ETweenEaseType easing, bool lazy) :
+				mMode(mode), mEasing(easing), mLazy(lazy) { }
+
+			/**
+			 * Adds a tween to the end of the bucket
+			 * @return index of the tween in the bucket
+			 */
+			uint32 push(uint32 slot, const T& start, const T& end, const T& current, double startTime, float duration, uint8 flags, uint32 group, const TweenBinding<T>& binding);
+
+			/**
+			 * Removes the tween at the given index by moving the last tween into its place
+			 * @return slot of the tween that moved into the index, invalid if no tween moved
+			 */
+			uint32 erase(uint32 index);
+
+			/**
+			 * Swaps the tweens at the given indices
+			 */
+			void swap(uint32 a, uint32 b);
+
+			/**
+			 * @return number of tweens in this bucket
+			 */
+			uint32 size() const						{ return static_cast<uint32>(mSlots.size()); }
+
+			/**
+			 * @return if the active tweens in this bucket have to be updated, lazy looping tweens never complete
+			 */
+			bool isUpdated() const					{ return mActive > 0 && (!mLazy || mMode == ETweenMode::NORMAL || mMode == ETweenMode::REVERSE); }
+
+			ETweenMode 							mMode;			///< Mode of all tweens in this bucket
+			ETweenEaseType						mEasing;		///< Ease type of all tweens in this bucket
+			bool								mLazy;			///< If the value of the tweens is computed when read
+			std::vector<double>					mStartTime;		///< Clock of the group at which the tween started
+			std::vector<uint32>					mGroup;			///< Group the tween follows the clock of
+			std::vector<float>					mDuration;		///< Duration
+			std::vector<T>						mStart;			///< Start values
+			std::vector<T>						mEnd;			///< End values
+			std::vector<T>						mCurrent;		///< Current values
+			std::vector<uint8>					mFlags;			///< State flags
+			std::vector<uint32>					mSlots;			///< Slot that points to the tween at the same index
+			std::vector<TweenBinding<T>>		mBindings;		///< Output bindings
+			uint32								mBoundCount = 0;	///< Number of tweens with an output binding
+			uint32								mRetargetedCount = 0;	///< Number of tweens with a velocity correction
+			uint32								mActive = 0;		///< Number of active tweens, stored in front
+		};
+
+		/**
+		 * Maps a stable slot to the bucket and index a tween is stored at
+		 */
+		struct Slot
+		{
+			uint32						mBucket = invalid;		///< Bucket the tween is stored in
+			uint32						mIndex = invalid;		///< Index of the tween in the bucket
+			uint32						mGeneration = 0;		///< Incremented every time the slot is released
+			Tween<T>*					mTween = nullptr;		///< The tween that occupies this slot, receives signals
+			bool						mOwned = false;			///< If the tween is owned by the pool, stored in mTweenStorage
+			bool						mFixedEase = false;		///< If the ease is fixed at compile time
+			float						mDelay = 0.0f;			///< Time to wait before the tween starts
+			double						mWakeTime = 0.0;		///< Pool time at which the delay expires
+			double						mPauseTime = 0.0;		///< Pool time at which the tween was paused
+			bool						mLazy = false;			///< If the tween is lazy when nothing observes its value
+			bool						mObserved = false;		///< If a handler is connected to the update signal
+			uint32						mEvaluated = invalid;	///< Update the lazy value was last computed in
+			const char*					mLabel = nullptr;		///< Label that identifies the tween in a trace
+			bool						mRecycled = false;		///< If the tween is removed as soon as it completed
+			T							mCorrection = T();		///< Velocity correction of a retargeted tween, see retarget()
+		};
+
+		/**
+		 * Scheduled end of a delay
+		 */
+		struct Wake
+		{
+			double		mTime;		///< Pool time at which the tween wakes
+			TweenID		mID;		///< The tween to wake
+
+			bool operator>(const Wake& other) const				{ return mTime > other.mTime; }
+		};
+
+		/**
+		 * @return bucket index for the given mode, ease and evaluation
+		 */
+		static uint32 getBucketIndex(ETweenMode mode, ETweenEaseType easing, bool lazy)
+		{
+			return ((lazy ? tweenModeCount : 0) + static_cast<uint32>(mode)) * tweenEaseCount + static_cast<uint32>(easing);
+		}
+
+		/**
+		 * @return bucket for the given mode, ease and evaluation, created on first use
+		 */
+		Bucket& getBucket(ETweenMode mode, ETweenEaseType easing, bool lazy);
+
+		/**
+		 * Moves the tween in the given slot to the bucket with the given mode and ease,
+		 * the tween is stored lazily when it's lazy and nothing observes its value
+		 */
+		void move(uint32 slot, ETweenMode mode, ETweenEaseType easing);
+
+		/**
+		 * Moves the tween in the given slot to a lazy or eager bucket, after its lazy state, listeners or binding changed
+		 */
+		void relocate(uint32 slot);
+
+		/**
+		 * Makes the tween in the given slot lazy or eager, see Tween::setLazy()
+		 */
+		void setLazy(uint32 slot, bool lazy);
+
+		/**
+		 * Called when a handler connects to a signal of the tween in the given slot, from now on the pool records its events
+		 * @param update if the handler is connected to the update signal, which makes the tween eager
+		 */
+		void listen(uint32 slot, bool update);
+
+		/**
+		 * @return current value of the tween in the given slot, computed when the tween is lazy
+		 */
+		const T& getCurrentValue(uint32 slot);
+
+		/**
+		 * Records a lifecycle event of the tween in the given slot, costs a single branch when the pool isn't traced
+		 * @param event the event to record
+		 * @param slot slot of the tween
+		 * @param completed if a killed tween completed before it was removed
+		 */
+		void trace(ETweenTraceEvent event, uint32 slot, bool completed = false)
+		{
+			if (mTrace != nullptr)
+				mTrace->record(event, mTraceType, mSlots[slot].mLabel, slot, mSlots[slot].mGeneration, completed);
+		}
+
+		/**
+		 * Counts the allocations made when an element is appended to the given array
+		 * @param array the array that is appended to
+		 * @param count number of arrays that grow along with it
+		 */
+		template<typename Array>
+		void track(const Array& array, size_t count = 1)		{ mAllocations += array.size() == array.capacity() ? count : 0; }
+
+		/**
+		 * Reserves memory in the given array, counts the allocation
+		 */
+		template<typename Array>
+		void reserve(Array& array, size_t capacity);
+
+		/**
+		 * Removes the tween at the given index from its bucket, keeps the active and dormant set intact
+		 */
+		void erase(Bucket& bucket, uint32 index);
+
+		/**
+		 * Swaps two tweens in a bucket and updates their slots
+		 */
+		void swap(Bucket& bucket, uint32 a, uint32 b);
+
+		/**
+		 * Moves the tween in the given slot to the active or dormant set, based on its flags
+		 */
+		void refresh(uint32 slot);
+
+		/**
+		 * Starts the delay of the tween in the given slot, the tween is dormant until the delay expires
+		 */
+		void schedule(uint32 slot);
+
+		/**
+		 * Adds the wake time of the tween in the given slot to the wake queue of its group
+		 */
+		void enqueue(uint32 slot);
+
+		/**
+		 * Moves the tween in the given slot to a group, the tween continues at the same time on the clock of that group
+		 */
+		void setGroup(uint32 slot, const TweenGroup* group);
+
+		/**
+		 * @return clock of the group the tween in the given slot belongs to
+		 */
+		double getGroupTime(uint32 slot) const;
+		/**
+		 * @return time since the start of the tween in the given slot, measured at the moment it was paused when paused.
+		 * Negative while the tween waits for its delay.
+		 */
+		double getElapsed(uint32 slot) const;
+
+		/**
+		 * Moves the start of the tween in the given slot so that the given time has passed since
+		 */
+		void setElapsed(uint32 slot, double time);
+
+		/**
+		 * @return time of the tween in the given slot within its current cycle, 0 - duration
+		 */
+		float getTime(uint32 slot) const;
+
+		/**
+		 * Pauses or resumes the tween in the given slot, resuming continues at the time it was paused
+		 */
+		void setPaused(uint32 slot, bool paused);
+
+		/**
+		 * Moves the tween in the given slot to the given time since its start, evaluates and writes its value
+		 */
+		void seek(uint32 slot, double time);
+
+		/**
+		 * @return value of the tween in the given slot at the given time since its start
+		 */
+		T evaluateAt(uint32 slot, double time) const;
+
+		/**
+		 * @return rate of change of the tween in the given slot per second, zero when the tween isn't moving
+		 */
+		T getVelocity(uint32 slot) const;
+
+		/**
+		 * Moves the tween in the given slot from its current value to a new end value, keeping its velocity.
+		 * The tween starts over in NORMAL mode with its ease, a correction that vanishes at both ends of the tween
+		 * makes up for the difference between the current velocity and the velocity at the start of the ease:
+		 * value = start + ease(p) * (end - start) + p * (1 - p)^2 * correction
+		 */
+		void retarget(uint32 slot, const T& end, float duration);
+
+		/**
+		 * Sets the velocity correction of the tween in the given slot, see retarget()
+		 */
+		void setCorrection(uint32 slot, const T& correction);
+
+		/**
+		 * Removes the velocity correction of the tween in the given slot
+		 */
+		void clearCorrection(uint32 slot);
+
+		/**
+		 * @return weight of the velocity correction at the given linear progress, 0 at both ends with a slope of 1 at the start
+		 */
+		static float getCorrectionWeight(float progress)		{ float rest = 1.0f - progress; return progress * rest * rest; }
+
+		/**
+		 * Evaluates tweens [begin, end) of a bucket at the clock of the pool, appends raised events
+		 */
+		void updateRange(Bucket& bucket, uint32 begin, uint32 end, std::vector<TweenEvent>& events);
+
+		/**
+		 * Evaluates tweens [begin, end) of a bucket at the clock of the pool using the given ease tag
+		 */
+		template<typename Ease>
+		void updateRange(Bucket& bucket, uint32 begin, uint32 end, std::vector<TweenEvent>& events);
+
+		/**
+		 * Computes the progress of tweens [begin, end) of a bucket at the clock of the pool, appends raised events.
+		 * Looping tweens move their start time forward by whole cycles, which keeps the time since their start small.
+		 * @param progress receives the linear progress of every tween in the range
+		 * @param changed receives if the tween advanced
+		 */
+		void advance(Bucket& bucket, uint32 begin, uint32 end, float* progress, uint8* changed, std::vector<TweenEvent>& events);
+
+		/**
+		 * Eases the progress of tweens [begin, end) of a bucket, interpolates their current value and applies output bindings.
+		 * Uses the batch kernels for value types that have one.
+		 * @param progress linear progress of every tween in the range, overwritten
+		 * @param changed if the tween advanced, bindings of tweens that didn't advance aren't written
+		 */
+		template<typename Ease>
+		void evaluate(Bucket& bucket, uint32 begin, uint32 end, float* progress, const uint8* changed);
+
+		/**
+		 * Checks lazy tweens [begin, end) of a bucket for completion, without evaluating them.
+		 * Only the value of tweens that complete is computed, for the complete signal.
+		 */
+		void complete(Bucket& bucket, uint32 begin, uint32 end, std::vector<TweenEvent>& events);
+
+		/**
+		 * Destroys the tween owned by the pool in the given slot and releases its memory
+		 */
+		void destroy(Slot& slot);
+
+		std::vector<std::unique_ptr<Bucket>> 	mBuckets;		///< All buckets, indexed by mode and ease
+		TweenStorage<Tween<T>>					mTweenStorage;	///< Memory of tweens owned by the pool
+		const TweenEaseTable*					mEaseTable = nullptr;	///< Sampled instead of the analytic eases when set
+		TweenSlots<Slot>						mSlots;			///< All slots
+		std::vector<std::vector<Wake>>			mWakeQueues;	///< Pending delays per group, min heap on wake time
+		TweenClocks								mOwnClocks;		///< Clocks of the pool when it isn't managed by a service
+		TweenClocks*							mClocks = &mOwnClocks;	///< Clocks the tweens follow
+		size_t									mActiveCount = 0;	///< Number of active tweens in all buckets
+		uint32									mFrame = 0;		///< Number of updates, stamps the values of lazy tweens
+		bool									mLazy = false;	///< If new tweens are lazy
+		std::vector<TweenEvent>					mEvents;		///< Events raised during last update
+		size_t									mAllocations = 0;	///< Number of times the arrays of the pool allocated memory
+		std::vector<TweenID>					mCompleted;		///< Recycled tweens that completed during the last update
+		std::vector<TweenID>					mKilled;		///< Tweens in cancelled groups, killed by killCancelled()
+		std::vector<TweenID>					mStaged;		///< Tweens added since staging began, merged once per update
+		bool									mStaging = false;	///< If added tweens are staged, see beginStaging()
+		TweenTrace*								mTrace = nullptr;	///< Records lifecycle events, nullptr when not traced
+		const char*								mTraceType = nullptr;	///< Name of the tweened value type in the trace
+	};
+
+
+	//////////////////////////////////////////////////////////////////////////
+	// Template Definitions
+	//////////////////////////////////////////////////////////////////////////
+
+	template<typename Slot>
+	uint32 TweenSlots<Slot>::allocate()
+	{
+		if (!mFree.empty())
+		{
+			uint32 slot = mFree.back();
+			mFree.pop_back();
+			return slot;
+		}
+		mAllocations += mSlots.size() == mSlots.capacity() ? 2 : 0;
+		mSlots.emplace_back();
+		mMembers.emplace_back();
+		return static_cast<uint32>(mSlots.size() - 1);
+	}
+
+
+	template<typename Slot>
+	void TweenSlots<Slot>::release(uint32 slot)
+	{
+		Slot& entry = mSlots[slot];
+		entry.mIndex = TweenPoolBase::invalid;
+		entry.mGeneration++;
+		mAllocations += mFree.size() == mFree.capacity() ? 1 : 0;
+		mFree.emplace_back(slot);
+	}
+
+
+	template<typename Slot>
+	template<typename Tween>
+	bool TweenSlots<Slot>::kill(TweenID id, Tween& tween, bool completed)
+	{
+		if (completed)
+			return true;
+		tween.KilledSignal();
+		return isValid(id);
+	}
+
+
+	template<typename Slot>
+	void TweenSlots<Slot>::join(uint32 slot, uint32 group)
+	{
+		if (group == TweenClocks::root)
+			return;
+
+		// the first member of a new group grows the list heads of all groups
+		if (group >= mFirstMembers.size())
+		{
+			mAllocations += group >= mFirstMembers.capacity() ? 1 : 0;
+			mFirstMembers.resize(group + 1, TweenPoolBase::invalid);
+		}
+
+		uint32& first = mFirstMembers[group];
+		mMembers[slot] = { TweenPoolBase::invalid, first };
+		if (first != TweenPoolBase::invalid)
+			mMembers[first].mPrevious = slot;
+		first = slot;
+	}
+
+
+	template<typename Slot>
+	void TweenSlots<Slot>::leave(uint32 slot, uint32 group)
+	{
+		if (group == TweenClocks::root)
+			return;
+
+		Member& member = mMembers[slot];
+		if (member.mPrevious != TweenPoolBase::invalid)
+			mMembers[member.mPrevious].mNext = member.mNext;
+		else
+			mFirstMembers[group] = member.mNext;
+		if (member.mNext != TweenPoolBase::invalid)
+			mMembers[member.mNext].mPrevious = member.mPrevious;
+		member = Member();
+	}
+
+
+	template<typename Slot>
+	void TweenSlots<Slot>::reserve(size_t capacity)
+	{
+		if (capacity > mSlots.capacity())
+		{
+			mSlots.reserve(capacity);
+			mMembers.reserve(capacity);
+			mAllocations += 2;
+		}
+		if (capacity > mFree.capacity())
+		{
+			mFree.reserve(capacity);
+			mAllocations++;
+		}
+	}
+
+
+	template<typename T>
+	uint32 TweenPool<T>::Bucket::push(uint32 slot, const T& start, const T& end, const T& current, double startTime, float duration, uint8 flags, uint32 group, const TweenBinding<T>& binding)
+	{
+		mStartTime.emplace_back(startTime);
+		mGroup.emplace_back(group);
+		mDuration.emplace_back(duration);
+		mStart.emplace_back(start);
+		mEnd.emplace_back(end);
+		mCurrent.emplace_back(current);
+		mFlags.emplace_back(flags);
+		mSlots.emplace_back(slot);
+		mBindings.emplace_back(binding);
+		if (binding.mTarget != nullptr)
+			mBoundCount++;
+		if (flags & EFlags::Retargeted)
+			mRetargetedCount++;
+		return size() - 1;
+	}
+
+
+	template<typename T>
+	uint32 TweenPool<T>::Bucket::erase(uint32 index)
+	{
+		uint32 last = size() - 1;
+		uint32 moved = invalid;
+		if (mBindings[index].mTarget != nullptr)
+			mBoundCount--;
+		if (mFlags[index] & EFlags::Retargeted)
+			mRetargetedCount--;
+
+		if (index != last)
+		{
+			mStartTime[index] 	= mStartTime[last];
+			mGroup[index] 		= mGroup[last];
+			mDuration[index] 	= mDuration[last];
+			mStart[index] 		= mStart[last];
+			mEnd[index] 		= mEnd[last];
+			mCurrent[index] 	= mCurrent[last];
+			mFlags[index] 		= mFlags[last];
+			mSlots[index] 		= mSlots[last];
+			mBindings[index] 	= mBindings[last];
+			moved = mSlots[index];
+		}
+
+		mStartTime.pop_back();
+		mGroup.pop_back();
+		mDuration.pop_back();
+		mStart.pop_back();
+		mEnd.pop_back();
+		mCurrent.pop_back();
+		mFlags.pop_back();
+		mSlots.pop_back();
+		mBindings.pop_back();
+		return moved;
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::Bucket::swap(uint32 a, uint32 b)
+	{
+		std::swap(mStartTime[a], mStartTime[b]);
+		std::swap(mGroup[a], mGroup[b]);
+		std::swap(mDuration[a], mDuration[b]);
+		std::swap(mStart[a], mStart[b]);
+		std::swap(mEnd[a], mEnd[b]);
+		std::swap(mCurrent[a], mCurrent[b]);
+		std::swap(mFlags[a], mFlags[b]);
+		std::swap(mSlots[a], mSlots[b]);
+		std::swap(mBindings[a], mBindings[b]);
+	}
+
+
+	template<typename T>
+	Tween<T>& TweenPool<T>::create(const T& start, const T& end, float duration, ETweenEaseType easing, ETweenMode mode)
+	{
+		Tween<T>& ref = *new (mTweenStorage.allocate()) Tween<T>(*this);
+		ref.mID = add(&ref, start, end, duration, easing, mode);
+		mSlots[ref.mID.mSlot].mOwned = true;
+		return ref;
+	}
+
+
+	template<typename T>
+	template<typename Ease>
+	Tween<T, Ease>& TweenPool<T>::create(const T& start, const T& end, float duration, ETweenMode mode)
+	{
+		// fixed ease tweens add no state, they share the storage of all tweens
+		static_assert(sizeof(Tween<T, Ease>) == sizeof(Tween<T>) && alignof(Tween<T, Ease>) == alignof(Tween<T>), "fixed ease tween can't add members");
+		Tween<T, Ease>& ref = *new (mTweenStorage.allocate()) Tween<T, Ease>(*this);
+		ref.mID = add(&ref, start, end, duration, Ease::type, mode, true);
+		mSlots[ref.mID.mSlot].mOwned = true;
+		return ref;
+	}
+
+
+	template<typename T>
+	TweenID TweenPool<T>::add(Tween<T>* tween, const T& start, const T& end, float duration, ETweenEaseType easing, ETweenMode mode, bool fixedEase)
+	{
+		uint32 slot_index = mSlots.allocate();
+		Slot& slot = mSlots[slot_index];
+		slot.mBucket = getBucketIndex(mode, easing, mLazy);
+		Bucket& bucket = getBucket(mode, easing, mLazy);
+		track(bucket.mSlots, Bucket::arrayCount);
+		uint8 flags = mStaging ? EFlags::Staged : 0;
+		slot.mIndex = bucket.push(slot_index, start, end, start, mClocks->getTime(TweenClocks::root), duration, flags, TweenClocks::root, {});
+		mClocks->join(TweenClocks::root);
+		slot.mTween = tween;
+		slot.mFixedEase = fixedEase;
+		slot.mDelay = 0.0f;
+		slot.mLazy = mLazy;
+		slot.mObserved = false;
+		slot.mLabel = nullptr;
+		slot.mRecycled = false;
+		refresh(slot_index);
+		trace(ETweenTraceEvent::Create, slot_index);
+		if (mStaging)
+		{
+			track(mStaged);
+			mStaged.push_back({ slot_index, slot.mGeneration });
+		}
+		return { slot_index, slot.mGeneration };
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::remove(TweenID id)
+	{
+		if (!isValid(id))
+			return;
+
+		// notify listeners the tween is killed before completion, handlers can move the tween to another bucket
+		const Slot& killed = mSlots[id.mSlot];
+		bool completed = (mBuckets[killed.mBucket]->mFlags[killed.mIndex] & EFlags::Complete) != 0;
+		if (!mSlots.kill(id, *killed.mTween, completed))
+			return;
+		trace(ETweenTraceEvent::Kill, id.mSlot, completed);
+
+		// swap and pop, update the slot of the tween that took its place
+		Slot& entry = mSlots[id.mSlot];
+		Bucket& bucket = *mBuckets[entry.mBucket];
+		mSlots.leave(id.mSlot, bucket.mGroup[entry.mIndex]);
+		mClocks->leave(bucket.mGroup[entry.mIndex]);
+		erase(bucket, entry.mIndex);
+
+		// release slot, invalidates all ids that refer to it
+		entry.mBucket = invalid;
+		mSlots.release(id.mSlot);
+		destroy(entry);
+	}
+
+
+	template<typename T>
+	TweenPool<T>::~TweenPool()
+	{
+		for (auto& slot : mSlots)
+			destroy(slot);
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::reserve(size_t capacity)
+	{
+		mSlots.reserve(capacity);
+		reserve(mEvents, capacity);
+		reserve(mStaged, capacity);
+		if (mWakeQueues.empty())
+		{
+			mWakeQueues.resize(1);
+			mAllocations++;
+		}
+		reserve(mWakeQueues[TweenClocks::root], capacity);
+		mTweenStorage.reserve(capacity);
+	}
+
+
+	template<typename T>
+	template<typename Array>
+	void TweenPool<T>::reserve(Array& array, size_t capacity)
+	{
+		if (capacity <= array.capacity())
+			return;
+		array.reserve(capacity);
+		mAllocations++;
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::destroy(Slot& slot)
+	{
+		Tween<T>* tween = slot.mTween;
+		bool owned = slot.mOwned;
+		slot.mTween = nullptr;
+		slot.mOwned = false;
+		if (owned)
+		{
+			// the destructor is virtual, fixed ease tweens are destroyed as their own type
+			tween->~Tween();
+			mTweenStorage.release(tween);
+		}
+	}
+
+
+	template<typename T>
+	bool TweenPool<T>::isValid(TweenID id) const
+	{
+		return mSlots.isValid(id);
+	}
+
+
+	template<typename T>
+	Tween<T>* TweenPool<T>::find(TweenID id) const
+	{
+		return isValid(id) ? mSlots[id.mSlot].mTween : nullptr;
+	}
+
+
+	template<typename T>
+	typename TweenPool<T>::Bucket& TweenPool<T>::getBucket(ETweenMode mode, ETweenEaseType easing, bool lazy)
+	{
+		assert(static_cast<uint32>(mode) < tweenModeCount && static_cast<uint32>(easing) < tweenEaseCount);
+		if (mBuckets.empty())
+		{
+			mBuckets.resize(2 * tweenModeCount * tweenEaseCount);
+			mAllocations++;
+		}
+
+		auto& bucket = mBuckets[getBucketIndex(mode, easing, lazy)];
+		if (bucket == nullptr)
+		{
+			bucket = std::make_unique<Bucket>(mode, easing, lazy);
+			mAllocations++;
+		}
+		return *bucket;
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::move(uint32 slot, ETweenMode mode, ETweenEaseType easing)
+	{
+		// a tween is only lazy when nothing observes its value every update
+		Slot& entry = mSlots[slot];
+		Bucket& source = *mBuckets[entry.mBucket];
+		uint32 index = entry.mIndex;
+		bool lazy = entry.mLazy && !entry.mObserved && source.mBindings[index].mTarget == nullptr;
+		uint32 target_index = getBucketIndex(mode, easing, lazy);
+		if (entry.mBucket == target_index)
+			return;
+
+		// the value of a lazy tween is only current when it was computed this update
+		if (source.mLazy)
+			getCurrentValue(slot);
+
+		// copy state into target bucket, remove from source bucket
+		Bucket& target = getBucket(mode, easing, lazy);
+		track(target.mSlots, Bucket::arrayCount);
+		uint32 new_index = target.push(slot, source.mStart[index], source.mEnd[index], source.mCurrent[index],
+			source.mStartTime[index], source.mDuration[index], source.mFlags[index], source.mGroup[index], source.mBindings[index]);
+
+		erase(source, index);
+		entry.mBucket = target_index;
+		entry.mIndex = new_index;
+		refresh(slot);
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::relocate(uint32 slot)
+	{
+		const Bucket& bucket = *mBuckets[mSlots[slot].mBucket];
+		move(slot, bucket.mMode, bucket.mEasing);
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::setLazy(uint32 slot, bool lazy)
+	{
+		mSlots[slot].mLazy = lazy;
+		relocate(slot);
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::listen(uint32 slot, bool update)
+	{
+		Slot& entry = mSlots[slot];
+		mBuckets[entry.mBucket]->mFlags[entry.mIndex] |= EFlags::Listening;
+		if (update && !entry.mObserved)
+		{
+			entry.mObserved = true;
+			relocate(slot);
+		}
+	}
+
+
+	template<typename T>
+	const T& TweenPool<T>::getCurrentValue(uint32 slot)
+	{
+		Slot& entry = mSlots[slot];
+		Bucket& bucket = *mBuckets[entry.mBucket];
+		uint32 index = entry.mIndex;
+		if (!bucket.mLazy)
+			return bucket.mCurrent[index];
+
+		// the value of a dormant tween doesn't change until it is refreshed
+		bool cached = index < bucket.mActive ? entry.mEvaluated == mFrame : entry.mEvaluated != invalid;
+		if (!cached)
+		{
+			bucket.mCurrent[index] = evaluateAt(slot, getElapsed(slot));
+			entry.mEvaluated = mFrame;
+		}
+		return bucket.mCurrent[index];
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::erase(Bucket& bucket, uint32 index)
+	{
+		// move an active tween to the front of the dormant set first
+		if (index < bucket.mActive)
+		{
+			bucket.mActive--;
+			mActiveCount--;
+			swap(bucket, index, bucket.mActive);
+			index = bucket.mActive;
+		}
+
+		uint32 moved = bucket.erase(index);
+		if (moved != invalid)
+			mSlots[moved].mIndex = index;
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::swap(Bucket& bucket, uint32 a, uint32 b)
+	{
+		if (a == b)
+			return;
+
+		bucket.swap(a, b);
+		mSlots[bucket.mSlots[a]].mIndex = a;
+		mSlots[bucket.mSlots[b]].mIndex = b;
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::refresh(uint32 slot)
+	{
+		// the state of the tween changed, a lazy value has to be computed again
+		Slot& entry = mSlots[slot];
+		entry.mEvaluated = invalid;
+		Bucket& bucket = *mBuckets[entry.mBucket];
+		uint32 index = entry.mIndex;
+
+		bool active = index < bucket.mActive;
+		bool wake = (bucket.mFlags[index] & EFlags::Dormant) == 0;
+
+		// a killed member of a cancelled group that is restarted is killed again
+		if (!(bucket.mFlags[index] & EFlags::Complete) && mClocks->getCancelled()[bucket.mGroup[index]])
+			mClocks->queueKill(bucket.mGroup[index]);
+
+		if (wake && !active)
+		{
+			swap(bucket, index, bucket.mActive);
+			bucket.mActive++;
+			mActiveCount++;
+		}
+		else if (!wake && active)
+		{
+			bucket.mActive--;
+			mActiveCount--;
+			swap(bucket, index, bucket.mActive);
+		}
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::schedule(uint32 slot)
+	{
+		// the tween starts when the delay expires
+		Slot& entry = mSlots[slot];
+		Bucket& bucket = *mBuckets[entry.mBucket];
+		bucket.mFlags[entry.mIndex] |= EFlags::Delayed;
+		setElapsed(slot, -entry.mDelay);
+		enqueue(slot);
+		refresh(slot);
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::enqueue(uint32 slot)
+	{
+		Slot& entry = mSlots[slot];
+		const Bucket& bucket = *mBuckets[entry.mBucket];
+		uint32 group = bucket.mGroup[entry.mIndex];
+		entry.mWakeTime = bucket.mStartTime[entry.mIndex];
+		if (group >= mWakeQueues.size())
+		{
+			mWakeQueues.resize(mClocks->size());
+			mAllocations++;
+		}
+
+		auto& queue = mWakeQueues[group];
+		track(queue);
+		queue.push_back({ entry.mWakeTime, { slot, entry.mGeneration } });
+		std::push_heap(queue.begin(), queue.end(), std::greater<Wake>());
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::setGroup(uint32 slot, const TweenGroup* group)
+	{
+		assert(group == nullptr || &group->getClocks() == mClocks); // group belongs to another service
+		uint32 index = group != nullptr ? group->getIndex() : TweenClocks::root;
+		Slot& entry = mSlots[slot];
+		Bucket& bucket = *mBuckets[entry.mBucket];
+		uint32& current = bucket.mGroup[entry.mIndex];
+		if (current == index)
+			return;
+
+		// continue at the same time on the clock of the new group
+		double elapsed = getElapsed(slot);
+		mSlots.leave(slot, current);
+		mClocks->leave(current);
+		mSlots.join(slot, index);
+		mClocks->join(index);
+		current = index;
+		if (bucket.mFlags[entry.mIndex] & EFlags::Paused)
+			entry.mPauseTime = mClocks->getTime(index);
+		setElapsed(slot, elapsed);
+
+		// the delay expires on the clock of the new group
+		if (bucket.mFlags[entry.mIndex] & EFlags::Delayed)
+			enqueue(slot);
+		refresh(slot);
+	}
+
+
+	template<typename T>
+	double TweenPool<T>::getGroupTime(uint32 slot) const
+	{
+		const Slot& entry = mSlots[slot];
+		return mClocks->getTime(mBuckets[entry.mBucket]->mGroup[entry.mIndex]);
+	}
+
+
+	template<typename T>
+	double TweenPool<T>::getCycleTime(ETweenMode mode, double time, float duration)
+	{
+		if (time <= 0.0 || duration <= 0.0f)
+			return 0.0;
+
+		switch (mode)
+		{
+		case ETweenMode::LOOP:
+			return std::fmod(time, static_cast<double>(duration));
+		case ETweenMode::PING_PONG:
+			return std::fmod(time, 2.0 * duration);
+		default:
+			return std::min(time, static_cast<double>(duration));
+		}
+	}
+
+
+	template<typename T>
+	float TweenPool<T>::getProgress(ETweenMode mode, double cycleTime, float duration)
+	{
+		// a tween without duration is always at its end
+		float progress = duration > 0.0f ? static_cast<float>(cycleTime / duration) : 1.0f;
+		if (mode == ETweenMode::PING_PONG && progress > 1.0f)
+			progress = 2.0f - progress;
+		progress = math::clamp<float>(progress, 0.0f, 1.0f);
+		return mode == ETweenMode::REVERSE ? 1.0f - progress : progress;
+	}
+
+
+	template<typename T>
+	double TweenPool<T>::getElapsed(uint32 slot) const
+	{
+		const Slot& entry = mSlots[slot];
+		const Bucket& bucket = *mBuckets[entry.mBucket];
+		double clock = (bucket.mFlags[entry.mIndex] & EFlags::Paused) ? entry.mPauseTime : mClocks->getTime(bucket.mGroup[entry.mIndex]);
+		return clock - bucket.mStartTime[entry.mIndex];
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::setElapsed(uint32 slot, double time)
+	{
+		const Slot& entry = mSlots[slot];
+		Bucket& bucket = *mBuckets[entry.mBucket];
+		double clock = (bucket.mFlags[entry.mIndex] & EFlags::Paused) ? entry.mPauseTime : mClocks->getTime(bucket.mGroup[entry.mIndex]);
+		bucket.mStartTime[entry.mIndex] = clock - time;
+	}
+
+
+	template<typename T>
+	float TweenPool<T>::getTime(uint32 slot) const
+	{
+		const Slot& entry = mSlots[slot];
+		const Bucket& bucket = *mBuckets[entry.mBucket];
+		float duration = bucket.mDuration[entry.mIndex];
+		double time = getCycleTime(bucket.mMode, getElapsed(slot), duration);
+		if (bucket.mMode == ETweenMode::PING_PONG && time > duration)
+			time = 2.0 * duration - time;
+		return static_cast<float>(time);
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::setPaused(uint32 slot, bool paused)
+	{
+		Slot& entry = mSlots[slot];
+		Bucket& bucket = *mBuckets[entry.mBucket];
+		uint8& flags = bucket.mFlags[entry.mIndex];
+		if (paused == ((flags & EFlags::Paused) != 0))
+			return;
+
+		if (paused)
+		{
+			flags |= EFlags::Paused;
+			entry.mPauseTime = getGroupTime(slot);
+		}
+		else
+		{
+			// continue where the tween was paused, a pending delay is postponed as well
+			flags &= ~EFlags::Paused;
+			bucket.mStartTime[entry.mIndex] += getGroupTime(slot) - entry.mPauseTime;
+			if (flags & EFlags::Delayed)
+				enqueue(slot);
+		}
+		refresh(slot);
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::seek(uint32 slot, double time)
+	{
+		const Slot& entry = mSlots[slot];
+		Bucket& bucket = *mBuckets[entry.mBucket];
+		uint32 index = entry.mIndex;
+
+		// a tween past its end completes on the next update
+		time = std::max(time, 0.0);
+		bucket.mFlags[index] &= ~(EFlags::Delayed | EFlags::Complete);
+		setElapsed(slot, time);
+		bucket.mCurrent[index] = evaluateAt(slot, time);
+		if (bucket.mBindings[index].mTarget != nullptr)
+			bucket.mBindings[index].apply(bucket.mCurrent[index]);
+		refresh(slot);
+	}
+
+
+	template<typename T>
+	T TweenPool<T>::evaluateAt(uint32 slot, double time) const
+	{
+		const Slot& entry = mSlots[slot];
+		const Bucket& bucket = *mBuckets[entry.mBucket];
+		uint32 index = entry.mIndex;
+		float duration = bucket.mDuration[index];
+		float linear = getProgress(bucket.mMode, getCycleTime(bucket.mMode, time, duration), duration);
+		float progress = mEaseTable != nullptr ? mEaseTable->evaluate(bucket.mEasing, linear) : evaluateTweenEase(bucket.mEasing, linear);
+		T value = progress * (bucket.mEnd[index] - bucket.mStart[index]) + bucket.mStart[index];
+		if (bucket.mFlags[index] & EFlags::Retargeted)
+			value = value + getCorrectionWeight(linear) * entry.mCorrection;
+		return value;
+	}
+
+
+	template<typename T>
+	T TweenPool<T>::getVelocity(uint32 slot) const
+	{
+		const Slot& entry = mSlots[slot];
+		const Bucket& bucket = *mBuckets[entry.mBucket];
+		uint32 index = entry.mIndex;
+		float duration = bucket.mDuration[index];
+		double elapsed = getElapsed(slot);
+		T zero = 0.0f * bucket.mStart[index];
+
+		// a tween that didn't start, has no duration or reached its end doesn't move
+		bool finite = bucket.mMode == ETweenMode::NORMAL || bucket.mMode == ETweenMode::REVERSE;
+		if ((bucket.mFlags[index] & (EFlags::Complete | EFlags::Delayed)) || elapsed < 0.0 || duration <= 0.0f || (finite && elapsed >= duration))
+			return zero;
+
+		// progress runs back when reversed and in the second half of a ping pong cycle
+		float linear = static_cast<float>(getCycleTime(bucket.mMode, elapsed, duration) / duration);
+		float rate = 1.0f / duration;
+		if (bucket.mMode == ETweenMode::PING_PONG && linear > 1.0f)
+		{
+			linear = 2.0f - linear;
+			rate = -rate;
+		}
+		float progress = linear;
+		if (bucket.mMode == ETweenMode::REVERSE)
+		{
+			progress = 1.0f - linear;
+			rate = -rate;
+		}
+
+		// the velocity is undefined where a circular ease is vertical
+		float slope = evaluateTweenEaseDerivative(bucket.mEasing, progress);
+		if (!std::isfinite(slope))
+			return zero;
+
+		T velocity = (slope * rate) * (bucket.mEnd[index] - bucket.mStart[index]);
+		if (bucket.mFlags[index] & EFlags::Retargeted)
+			velocity = velocity + ((1.0f - linear) * (1.0f - 3.0f * linear) * rate) * entry.mCorrection;
+		return velocity;
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::retarget(uint32 slot, const T& end, float duration)
+	{
+		assert(duration >= 0.0f); // invalid duration
+
+		// sample the motion before the tween changes
+		T current = evaluateAt(slot, std::max(getElapsed(slot), 0.0));
+		T velocity = getVelocity(slot);
+
+		// the tween travels forward from its current value, with the same ease
+		const Bucket& source = *mBuckets[mSlots[slot].mBucket];
+		if (source.mMode != ETweenMode::NORMAL)
+			move(slot, ETweenMode::NORMAL, source.mEasing);
+
+		const Slot& entry = mSlots[slot];
+		Bucket& bucket = *mBuckets[entry.mBucket];
+		uint32 index = entry.mIndex;
+		bucket.mStart[index] = current;
+		bucket.mEnd[index] = end;
+		bucket.mDuration[index] = duration;
+		bucket.mCurrent[index] = current;
+		bucket.mFlags[index] &= ~(EFlags::Complete | EFlags::Delayed);
+		setElapsed(slot, 0.0);
+
+		// an ease that starts vertically can't be corrected, it jumps away from the current value anyway
+		float slope = evaluateTweenEaseDerivative(bucket.mEasing, 0.0f);
+		if (duration > 0.0f && std::isfinite(slope))
+			setCorrection(slot, duration * velocity - slope * (end - current));
+		else
+			clearCorrection(slot);
+
+		if (bucket.mBindings[index].mTarget != nullptr)
+			bucket.mBindings[index].apply(current);
+		trace(ETweenTraceEvent::Restart, slot);
+		refresh(slot);
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::setCorrection(uint32 slot, const T& correction)
+	{
+		Slot& entry = mSlots[slot];
+		Bucket& bucket = *mBuckets[entry.mBucket];
+		uint8& flags = bucket.mFlags[entry.mIndex];
+		entry.mCorrection = correction;
+		if (!(flags & EFlags::Retargeted))
+		{
+			flags |= EFlags::Retargeted;
+			bucket.mRetargetedCount++;
+		}
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::clearCorrection(uint32 slot)
+	{
+		const Slot& entry = mSlots[slot];
+		Bucket& bucket = *mBuckets[entry.mBucket];
+		uint8& flags = bucket.mFlags[entry.mIndex];
+		if (flags & EFlags::Retargeted)
+		{
+			flags &= ~EFlags::Retargeted;
+			bucket.mRetargetedCount--;
+		}
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::update(double deltaTime)
+	{
+		evaluate(deltaTime);
+		dispatch();
+		recycle();
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::recycle()
+	{
+		// handlers might have removed or restarted the tween since it completed
+		for (const auto& id : mCompleted)
+		{
+			if (!isValid(id))
+				continue;
+
+			const Slot& entry = mSlots[id.mSlot];
+			if (mBuckets[entry.mBucket]->mFlags[entry.mIndex] & EFlags::Complete)
+				remove(id);
+		}
+		mCompleted.clear();
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::killCancelled(const std::vector<uint32>& groups)
+	{
+		// collect first, handlers of the killed signal can create, move or remove tweens
+		const uint8* cancelled = mClocks->getCancelled();
+		for (uint32 group : groups)
+		{
+			if (!cancelled[group])
+				continue;
+
+			for (uint32 slot = mSlots.getFirstMember(group); slot != invalid; slot = mSlots.getNextMember(slot))
+			{
+				const Slot& entry = mSlots[slot];
+				if (!(mBuckets[entry.mBucket]->mFlags[entry.mIndex] & EFlags::Complete))
+				{
+					track(mKilled);
+					mKilled.push_back({ slot, entry.mGeneration });
+				}
+			}
+		}
+
+		// handlers might have completed, moved or removed the tween since it was collected
+		for (const auto& id : mKilled)
+		{
+			if (!isValid(id))
+				continue;
+
+			Slot& entry = mSlots[id.mSlot];
+			Bucket& bucket = *mBuckets[entry.mBucket];
+			if (!mClocks->getCancelled()[bucket.mGroup[entry.mIndex]] || (bucket.mFlags[entry.mIndex] & EFlags::Complete))
+				continue;
+
+			if (entry.mRecycled)
+			{
+				remove(id);
+				continue;
+			}
+
+			// the tween stays where it is and completes, the kill is traced when its handle removes it
+			bucket.mFlags[entry.mIndex] |= EFlags::Complete;
+			refresh(id.mSlot);
+			trace(ETweenTraceEvent::Complete, id.mSlot);
+			entry.mTween->KilledSignal();
+		}
+		mKilled.clear();
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::setRecycled(TweenID id)
+	{
+		assert(isValid(id));
+		mSlots[id.mSlot].mRecycled = true;
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::evaluate(double deltaTime)
+	{
+		beginUpdate(deltaTime);
+		mEvents.clear();
+		size_t capacity = mEvents.capacity();
+		for (auto& bucket : mBuckets)
+		{
+			if (bucket != nullptr && bucket->isUpdated())
+				updateRange(*bucket, 0, bucket->mActive, mEvents);
+		}
+		mAllocations += mEvents.capacity() != capacity ? 1 : 0;
+		endUpdate();
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::beginUpdate(double deltaTime)
+	{
+		// the clocks of a service are advanced by the service
+		if (mClocks == &mOwnClocks)
+			mOwnClocks.advance(deltaTime);
+
+		mFrame = mFrame + 1 != invalid ? mFrame + 1 : 0;
+		const double* clocks = mClocks->getTimes();
+		for (uint32 group = 0; group < mWakeQueues.size(); group++)
+		{
+			auto& queue = mWakeQueues[group];
+			while (!queue.empty() && queue.front().mTime <= clocks[group])
+			{
+				std::pop_heap(queue.begin(), queue.end(), std::greater<Wake>());
+				Wake wake = queue.back();
+				queue.pop_back();
+
+				// skip delays of removed tweens and delays that were restarted or moved to another group since
+				if (!isValid(wake.mID) || mSlots[wake.mID.mSlot].mWakeTime != wake.mTime)
+					continue;
+
+				// a paused tween is queued again when it resumes
+				const Slot& entry = mSlots[wake.mID.mSlot];
+				Bucket& bucket = *mBuckets[entry.mBucket];
+				uint8& flags = bucket.mFlags[entry.mIndex];
+				if (!(flags & EFlags::Delayed) || (flags & EFlags::Paused) || bucket.mGroup[entry.mIndex] != group)
+					continue;
+
+				// the tween started at the wake time, in between updates
+				flags &= ~EFlags::Delayed;
+				refresh(wake.mID.mSlot);
+			}
+		}
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::setClocks(TweenClocks& clocks)
+	{
+		assert(size() == 0); // tweens follow the clocks they were added with
+		mClocks = &clocks;
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::endUpdate()
+	{
+		// only normal and reverse tweens complete during an update
+		for (auto& bucket : mBuckets)
+		{
+			if (bucket == nullptr || bucket->mActive == 0)
+				continue;
+
+			if (bucket->mMode != ETweenMode::NORMAL && bucket->mMode != ETweenMode::REVERSE)
+				continue;
+
+			const uint8* flags = bucket->mFlags.data();
+			for (uint32 i = 0; i < bucket->mActive;)
+			{
+				if (flags[i] & EFlags::Dormant)
+				{
+					if (flags[i] & EFlags::Complete)
+					{
+						// recycled tweens are removed after their complete signal is dispatched
+						uint32 slot = bucket->mSlots[i];
+						trace(ETweenTraceEvent::Complete, slot);
+						if (mSlots[slot].mRecycled)
+						{
+							track(mCompleted);
+							mCompleted.push_back({ slot, mSlots[slot].mGeneration });
+						}
+					}
+					bucket->mActive--;
+					mActiveCount--;
+					swap(*bucket, i, bucket->mActive);
+				}
+				else
+				{
+					i++;
+				}
+			}
+		}
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::getRanges(uint32 maxSize, std::vector<TweenRange>& ranges)
+	{
+		assert(maxSize > 0);
+		for (uint32 i = 0; i < mBuckets.size(); i++)
+		{
+			if (mBuckets[i] == nullptr || !mBuckets[i]->isUpdated())
+				continue;
+
+			uint32 size = mBuckets[i]->mActive;
+			for (uint32 begin = 0; begin < size; begin += maxSize)
+				ranges.push_back({ this, i, begin, std::min(begin + maxSize, size) });
+		}
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::updateRange(const TweenRange& range, std::vector<TweenEvent>& events)
+	{
+		assert(range.mPool == this && mBuckets[range.mBucket] != nullptr);
+		updateRange(*mBuckets[range.mBucket], range.mBegin, range.mEnd, events);
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::updateRange(Bucket& bucket, uint32 begin, uint32 end, std::vector<TweenEvent>& events)
+	{
+		if (bucket.mLazy)
+		{
+			complete(bucket, begin, end, events);
+			return;
+		}
+
+		// resolve the ease once for the whole range
+		visitTweenEase(bucket.mEasing, [&](auto ease)
+		{
+			updateRange<decltype(ease)>(bucket, begin, end, events);
+		});
+	}
+
+
+	template<typename T>
+	template<typename Ease>
+	void TweenPool<T>::updateRange(Bucket& bucket, uint32 begin, uint32 end, std::vector<TweenEvent>& events)
+	{
+		float progress[tweenBatchSize];
+		uint8 changed[tweenBatchSize];
+		for (uint32 first = begin; first < end; first += tweenBatchSize)
+		{
+			uint32 last = std::min(first + tweenBatchSize, end);
+			advance(bucket, first, last, progress, changed, events);
+			evaluate<Ease>(bucket, first, last, progress, changed);
+		}
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::advance(Bucket& bucket, uint32 begin, uint32 end, float* progress, uint8* changed, std::vector<TweenEvent>& events)
+	{
+		const double* clocks 	= mClocks->getTimes();
+		const uint8* running 	= mClocks->getRunning();
+		const uint32* group 	= bucket.mGroup.data();
+		double* start 			= bucket.mStartTime.data();
+		const float* dur 		= bucket.mDuration.data();
+		uint8* flags 			= bucket.mFlags.data();
+
+		// events are only raised for tweens that have a handler connected
+		switch (bucket.mMode)
+		{
+		default:
+		case ETweenMode::NORMAL:
+		case ETweenMode::REVERSE:
+		{
+			for (uint32 i = begin; i < end; i++)
+			{
+				// tweens of a stopped group don't change
+				double time = std::max(clocks[group[i]] - start[i], 0.0);
+				changed[i - begin] = !(flags[i] & EFlags::Complete) && running[group[i]];
+				if (changed[i - begin])
+				{
+					uint8 raised = EEvents::Updated;
+					if (time >= dur[i])
+					{
+						flags[i] |= EFlags::Complete;
+						raised |= EEvents::Completed;
+					}
+					if (flags[i] & EFlags::Listening)
+						events.push_back({ bucket.mSlots[i], raised });
+				}
+				float linear = dur[i] > 0.0f ? std::min(static_cast<float>(time / dur[i]), 1.0f) : 1.0f;
+				progress[i - begin] = bucket.mMode == ETweenMode::REVERSE ? 1.0f - linear : linear;
+			}
+			break;
+		}
+		case ETweenMode::PING_PONG:
+		case ETweenMode::LOOP:
+		{
+			// a cycle of a ping pong tween is twice its duration, forward and back
+			bool ping_pong = bucket.mMode == ETweenMode::PING_PONG;
+			for (uint32 i = begin; i < end; i++)
+			{
+				double clock = clocks[group[i]];
+				double cycle = ping_pong ? 2.0 * dur[i] : dur[i];
+				double time = std::max(clock - start[i], 0.0);
+				if (time >= cycle && cycle > 0.0)
+				{
+					start[i] += std::floor(time / cycle) * cycle;
+					time = math::clamp<double>(clock - start[i], 0.0, cycle);
+				}
+
+				changed[i - begin] = !(flags[i] & EFlags::Complete) && running[group[i]];
+				if (changed[i - begin] && (flags[i] & EFlags::Listening))
+					events.push_back({ bucket.mSlots[i], EEvents::Updated });
+
+				float linear = dur[i] > 0.0f ? static_cast<float>(time / dur[i]) : 1.0f;
+				progress[i - begin] = math::clamp<float>(linear > 1.0f ? 2.0f - linear : linear, 0.0f, 1.0f);
+			}
+			break;
+		}
+		}
+	}
+
+
+	template<typename T>
+	template<typename Ease>
+	void TweenPool<T>::evaluate(Bucket& bucket, uint32 begin, uint32 end, float* progress, const uint8* changed)
+	{
+		const T* start 		= bucket.mStart.data() + begin;
+		const T* target 	= bucket.mEnd.data() + begin;
+		T* current 			= bucket.mCurrent.data() + begin;
+		uint32 count 		= end - begin;
+
+		// the correction of retargeted tweens is weighted by their linear progress
+		float linear[tweenBatchSize];
+		bool corrected = bucket.mRetargetedCount > 0;
+		if (corrected)
+			std::copy(progress, progress + count, linear);
+
+		if (mEaseTable != nullptr)
+		{
+			// ease table, values are interpolated below
+			mEaseTable->evaluate(Ease::type, progress, progress, count);
+		}
+		else if constexpr (hasTweenLerpBatch<T>)
+		{
+			evaluateEaseBatch(Ease::type, progress, progress, count);
+		}
+		else
+		{
+			for (uint32 i = 0; i < count; i++)
+				progress[i] = Ease::evaluate(progress[i]);
+		}
+
+		if constexpr (hasTweenLerpBatch<T>)
+		{
+			lerpBatch(start, target, progress, current, count);
+		}
+		else
+		{
+			for (uint32 i = 0; i < count; i++)
+				current[i] = progress[i] * (target[i] - start[i]) + start[i];
+		}
+
+		if (corrected)
+		{
+			const uint8* flags = bucket.mFlags.data() + begin;
+			const uint32* slots = bucket.mSlots.data() + begin;
+			for (uint32 i = 0; i < count; i++)
+			{
+				if (flags[i] & EFlags::Retargeted)
+					current[i] = current[i] + getCorrectionWeight(linear[i]) * mSlots[slots[i]].mCorrection;
+			}
+		}
+
+		// write values into bound outputs
+		if (bucket.mBoundCount == 0)
+			return;
+
+		const TweenBinding<T>* bindings = bucket.mBindings.data() + begin;
+		for (uint32 i = 0; i < count; i++)
+		{
+			if (changed[i] && bindings[i].mTarget != nullptr)
+				bindings[i].apply(current[i]);
+		}
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::complete(Bucket& bucket, uint32 begin, uint32 end, std::vector<TweenEvent>& events)
+	{
+		const double* clocks 	= mClocks->getTimes();
+		const uint32* group 	= bucket.mGroup.data();
+		const double* start 	= bucket.mStartTime.data();
+		const float* dur 		= bucket.mDuration.data();
+		uint8* flags 			= bucket.mFlags.data();
+		for (uint32 i = begin; i < end; i++)
+		{
+			if ((flags[i] & EFlags::Complete) || clocks[group[i]] - start[i] < dur[i])
+				continue;
+
+			// only the slot of this tween is touched, safe while other ranges are evaluated
+			uint32 slot = bucket.mSlots[i];
+			flags[i] |= EFlags::Complete;
+			bucket.mCurrent[i] = evaluateAt(slot, dur[i]);
+			mSlots[slot].mEvaluated = mFrame;
+			if (flags[i] & EFlags::Listening)
+				events.push_back({ slot, EEvents::Completed });
+		}
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::bind(TweenID id, const TweenBinding<T>& binding)
+	{
+		assert(isValid(id));
+		const Slot& entry = mSlots[id.mSlot];
+		Bucket& bucket = *mBuckets[entry.mBucket];
+		TweenBinding<T>& current = bucket.mBindings[entry.mIndex];
+		bucket.mBoundCount += (binding.mTarget != nullptr ? 1 : 0) - (current.mTarget != nullptr ? 1 : 0);
+		current = binding;
+
+		// a bound tween is written every update
+		relocate(id.mSlot);
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::setLabel(TweenID id, const char* label)
+	{
+		if (isValid(id))
+			mSlots[id.mSlot].mLabel = label;
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::unbind(TweenID id)
+	{
+		if (isValid(id))
+			bind(id, {});
+	}
+
+
+	template<typename T>
+	uint32 TweenPool<T>::merge(bool evaluate)
+	{
+		// tweens removed before the merge are skipped, the others start at the clock they were created at
+		mStaging = false;
+		mEvents.clear();
+		size_t capacity = mEvents.capacity();
+		uint32 count = 0;
+		for (const auto& id : mStaged)
+		{
+			if (!isValid(id))
+				continue;
+
+			Slot& entry = mSlots[id.mSlot];
+			mBuckets[entry.mBucket]->mFlags[entry.mIndex] &= ~EFlags::Staged;
+			refresh(id.mSlot);
+			count++;
+
+			// delayed and paused tweens stay dormant
+			Bucket& bucket = *mBuckets[entry.mBucket];
+			uint32 index = entry.mIndex;
+			if (!evaluate || index >= bucket.mActive)
+				continue;
+
+			bucket.mCurrent[index] = evaluateAt(id.mSlot, getElapsed(id.mSlot));
+			entry.mEvaluated = mFrame;
+			if (bucket.mBindings[index].mTarget != nullptr)
+				bucket.mBindings[index].apply(bucket.mCurrent[index]);
+			if (bucket.mFlags[index] & EFlags::Listening)
+				mEvents.push_back({ id.mSlot, EEvents::Updated });
+		}
+		mStaged.clear();
+		mAllocations += mEvents.capacity() != capacity ? 1 : 0;
+
+		// tweens created by these handlers are no longer staged, they start during the next update
+		if (!mEvents.empty())
+			dispatch(mEvents);
+		return count;
+	}
+
+
+	template<typename T>
+	void TweenPool<T>::dispatch(const std::vector<TweenEvent>& events)
+	{
+		// handlers are allowed to create, change or move tweens: resolve every event through its slot
+		// and copy the value, buckets might grow while a signal is dispatched
+		for (const auto& event : events)
+		{
+			const Slot& entry = mSlots[event.mSlot];
+			if (entry.mTween == nullptr)
+				continue;
+
+			T value = mBuckets[entry.mBucket]->mCurrent[entry.mIndex];
+			Tween<T>& tween = *entry.mTween;
+			if (event.mEvents & EEvents::Updated)
+				tween.UpdateSignal.trigger(value);
+			if (event.mEvents & EEvents::Completed)
+				tween.CompleteSignal.trigger(value);
+		}
+	}
+}
@@ -0,0 +1,300 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// internal includes
+#include "tweeneasing.h"
+
+// external includes
+#include <mathutils.h>
+#include <nap/signalslot.h>
+#include <vector>
+#include <algorithm>
+
+namespace nap
+{
+	//////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * A timeline of tweened values, made of one or more parallel tracks.
+	 * Every track is an ordered list of segments that tween from the end value of the previous segment to a new value.
+	 * A delay holds the value of a track for some time before the next segment starts.
+	 * Every track stores its segments in contiguous arrays sorted by start time, appending a segment is amortized O(1).
+	 * Evaluating a track finds its segment with a binary search, a cursor per track makes playback in order amortized O(1).
+	 * Chaining tweens this way doesn't require any allocation, signal or extra frame at a segment boundary.
+	 * The play head and start times are stored in double precision, like the clocks of the tween groups,
+	 * so long sequences don't lose precision.
+	 * Call update() to advance the sequence, or evaluate() to sample it at any time.
+	 * @tparam T the type of value that is tweened
+	 */
+	template<typename T>
+	class TweenSequence
+	{
+	public:
+		/**
+		 * Constructor
+		 */
+		TweenSequence() = default;
+
+		/**
+		 * Adds a parallel track
+		 * @param startValue value of the track before its first segment
+		 * @return index of the track
+		 */
+		uint32 addTrack(const T& startValue);
+
+		/**
+		 * Appends a segment to a track that tweens from the end value of the track to the given value
+		 * @param track index of the track
+		 * @param value end value of the segment
+		 * @param duration duration of the segment in seconds
+		 * @param easing the ease type
+		 */
+		void append(uint32 track, const T& value, float duration, ETweenEaseType easing = ETweenEaseType::LINEAR);
+
+		/**
+		 * Holds the end value of a track for the given time before the next segment starts
+		 * @param track index of the track
+		 * @param duration time to wait in seconds
+		 */
+		void delay(uint32 track, float duration);
+
+		/**
+		 * Removes all tracks and segments
+		 */
+		void clear();
+
+		/**
+		 * @return number of tracks
+		 */
+		uint32 getTrackCount() const								{ return static_cast<uint32>(mTracks.size()); }
+
+		/**
+		 * @return number of segments of all tracks
+		 */
+		uint32 getSegmentCount() const								{ return mSegmentCount; }
+
+		/**
+		 * @param track index of the track
+		 * @return end time of the track in seconds, including trailing delays
+		 */
+		double getTrackDuration(uint32 track) const					{ return mTracks[track].mDuration; }
+
+		/**
+		 * @return end time of the longest track in seconds
+		 */
+		double getDuration() const									{ return mDuration; }
+
+		/**
+		 * Samples a track at the given time
+		 * @param track index of the track
+		 * @param time time in seconds
+		 * @return value of the track at the given time
+		 */
+		T evaluate(uint32 track, double time) const;
+
+		/**
+		 * Advances the sequence and evaluates all tracks.
+		 * The update that reaches the end of the sequence dispatches the CompleteSignal, also when the sequence is empty.
+		 * @param deltaTime time in seconds since last update
+		 */
+		void update(double deltaTime);
+
+		/**
+		 * Moves the play head of the sequence and evaluates all tracks, doesn't dispatch any signal.
+		 * Seeking before the end makes the sequence incomplete, the next update that reaches the end dispatches the CompleteSignal again.
+		 * @param time time in seconds
+		 */
+		void seek(double time);
+
+		/**
+		 * @return current time of the play head in seconds
+		 */
+		double getTime() const										{ return mTime; }
+
+		/**
+		 * @param track index of the track
+		 * @return value of the track at the play head
+		 */
+		const T& getValue(uint32 track) const						{ return mValues[track]; }
+
+		/**
+		 * @return if an update reached the end of the sequence
+		 */
+		bool isComplete() const										{ return mComplete; }
+
+		/**
+		 * Complete signal dispatched when the play head reaches the end of the sequence
+		 */
+		Signal<> CompleteSignal;
+
+	private:
+		/**
+		 * Tweens from a value to another value, starting at a fixed time in its track
+		 */
+		struct Segment
+		{
+			T 				mFrom;			///< Start value
+			T 				mTo;			///< End value
+			float			mDuration;		///< Duration in seconds
+			ETweenEaseType	mEasing;		///< Ease type
+		};
+
+		/**
+		 * Ordered segments of a parallel track
+		 */
+		struct Track
+		{
+			std::vector<double>		mStarts;				///< Start time of every segment, searched for the active segment
+			std::vector<Segment>	mSegments;				///< Segments of the track
+			T 						mStartValue;			///< Value before the first segment
+			T 						mEndValue;				///< Value after the last segment
+			double					mDuration = 0.0;		///< End time of the track, including trailing delays
+			mutable uint32			mCursor = 0;			///< Last segment found
+		};
+
+		/**
+		 * @return the last segment of the track that starts at or before the given time, number of segments when none
+		 */
+		uint32 find(const Track& track, double time) const;
+
+		std::vector<Track>			mTracks;				///< All tracks
+		std::vector<T>				mValues;				///< Value of every track at the play head
+		uint32						mSegmentCount = 0;		///< Number of segments of all tracks
+		double						mDuration = 0.0;		///< End time of the longest track
+		double						mTime = 0.0;			///< Play head
+		bool						mComplete = false;		///< If an update reached the end, reset when the play head moves before the end
+	};
+
+
+	//////////////////////////////////////////////////////////////////////////
+	// Template Definitions
+	//////////////////////////////////////////////////////////////////////////
+
+	template<typename T>
+	uint32 TweenSequence<T>::addTrack(const T& startValue)
+	{
+		Track& track = mTracks.emplace_back();
+		track.mStartValue = startValue;
+		track.mEndValue = startValue;
+		mValues.emplace_back(startValue);
+		return static_cast<uint32>(mTracks.size() - 1);
+	}
+
+
+	template<typename T>
+	void TweenSequence<T>::append(uint32 track, const T& value, float duration, ETweenEaseType easing)
+	{
+		assert(track < mTracks.size());
+		assert(duration > 0.0f); // invalid duration
+
+		// segments are appended in order, the arrays of the track stay sorted
+		Track& target = mTracks[track];
+		target.mStarts.emplace_back(target.mDuration);
+		target.mSegments.push_back({ target.mEndValue, value, duration, easing });
+		target.mEndValue = value;
+		target.mDuration += duration;
+		mDuration = std::max(mDuration, target.mDuration);
+		mComplete = mComplete && mTime >= mDuration;
+		mSegmentCount++;
+	}
+
+
+	template<typename T>
+	void TweenSequence<T>::delay(uint32 track, float duration)
+	{
+		assert(track < mTracks.size());
+		assert(duration >= 0.0f); // invalid delay
+
+		Track& target = mTracks[track];
+		target.mDuration += duration;
+		mDuration = std::max(mDuration, target.mDuration);
+		mComplete = mComplete && mTime >= mDuration;
+	}
+
+
+	template<typename T>
+	void TweenSequence<T>::clear()
+	{
+		mTracks.clear();
+		mValues.clear();
+		mSegmentCount = 0;
+		mDuration = 0.0;
+		mTime = 0.0;
+		mComplete = false;
+	}
+
+
+	template<typename T>
+	uint32 TweenSequence<T>::find(const Track& track, double time) const
+	{
+		// playing forward the time is usually in the cached or the next segment
+		const std::vector<double>& starts = track.mStarts;
+		uint32 end = static_cast<uint32>(starts.size());
+		uint32& cursor = track.mCursor;
+		if (cursor < end && starts[cursor] <= time)
+		{
+			uint32 next = cursor + 1;
+			if (next == end || starts[next] > time)
+				return cursor;
+			if (next + 1 == end || starts[next + 1] > time)
+				return cursor = next;
+		}
+
+		// binary search for the last segment that starts at or before the time
+		auto it = std::upper_bound(starts.begin(), starts.end(), time);
+		if (it == starts.begin())
+			return end;
+
+		cursor = static_cast<uint32>(it - starts.begin()) - 1;
+		return cursor;
+	}
+
+
+	template<typename T>
+	T TweenSequence<T>::evaluate(uint32 index, double time) const
+	{
+		assert(index < mTracks.size());
+		const Track& track = mTracks[index];
+
+		// before the first segment
+		uint32 found = find(track, time);
+		if (found == track.mSegments.size())
+			return track.mStartValue;
+
+		// in a delay after the segment
+		const Segment& segment = track.mSegments[found];
+		double local = time - track.mStarts[found];
+		if (local >= segment.mDuration)
+			return segment.mTo;
+
+		float progress = evaluateTweenEase(segment.mEasing, static_cast<float>(local / segment.mDuration));
+		return progress * (segment.mTo - segment.mFrom) + segment.mFrom;
+	}
+
+
+	template<typename T>
+	void TweenSequence<T>::update(double deltaTime)
+	{
+		bool complete = mComplete;
+		seek(std::min(mTime + deltaTime, mDuration));
+		if (!complete && mTime >= mDuration)
+		{
+			mComplete = true;
+			CompleteSignal();
+		}
+	}
+
+
+	template<typename T>
+	void TweenSequence<T>::seek(double time)
+	{
+		mTime = math::clamp<double>(time, 0.0, mDuration);
+		if (mTime < mDuration)
+			mComplete = false;
+		for (uint32 i = 0; i < mTracks.size(); i++)
+			mValues[i] = evaluate(i, mTime);
+	}
+}
@@ -6,18 +6,46 @@
 #include <nap/core.h>
 #include <nap/logger.h>
 #include <iostream>
+#include <thread>
+#include <chrono>
+#include <algorithm>
 #include <utility/stringutils.h>
 
 // Local Includes
 #include "tweenservice.h"
 #include "tween.h"
 
+RTTI_BEGIN_CLASS(nap::TweenServiceConfiguration)
+	RTTI_PROPERTY("Parallel",		&nap::TweenServiceConfiguration::mParallel,		nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("ThreadCount",	&nap::TweenServiceConfiguration::mThreadCount,	nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("ChunkSize",		&nap::TweenServiceConfiguration::mChunkSize,	nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("InitialCapacity",	&nap::TweenServiceConfiguration::mInitialCapacity,	nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("EaseTable",			&nap::TweenServiceConfiguration::mEaseTable,		nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("EaseTableResolution",	&nap::TweenServiceConfiguration::mEaseTableResolution,	nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("EaseTableInterpolation",	&nap::TweenServiceConfiguration::mEaseTableInterpolation,	nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Lazy",				&nap::TweenServiceConfiguration::mLazy,				nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Trace",				&nap::TweenServiceConfiguration::mTrace,			nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("TraceCapacity",		&nap::TweenServiceConfiguration::mTraceCapacity,	nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("StartStagedSameFrame",	&nap::TweenServiceConfiguration::mStartStagedSameFrame,	nap::rtti::EPropertyMetaData::Default)
+RTTI_END_CLASS
+
 RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::TweenService)
 RTTI_CONSTRUCTOR(nap::ServiceConfiguration*)
 RTTI_END_CLASS
 
 namespace nap
 {
+	using StatsClock = TweenTrace::Clock;
+
+	/**
+	 * @return seconds between the given time points
+	 */
+	static double getSeconds(StatsClock::time_point begin, StatsClock::time_point end)
+	{
+		return std::chrono::duration<double>(end - begin).count();
+	}
+
+
 	static std::vector<std::unique_ptr<rtti::IObjectCreator>(*)(TweenService*)>& getObjectCreators()
 	{
 		static std::vector<std::unique_ptr<rtti::IObjectCreator>(*)(TweenService* service)> vector;
@@ -26,13 +54,16 @@ namespace nap
 
 
 	TweenService::TweenService(ServiceConfiguration* configuration) :
-		Service(configuration)
+		Service(configuration), mMainThread(std::this_thread::get_id())
 	{
 	}
 
 
 	TweenService::~TweenService()
-	{ }
+	{
+		// the worker loops wait on members of the service
+		stopWorkers();
+	}
 
 
 	void TweenService::registerObjectCreators(rtti::Factory& factory)
@@ -46,56 +77,520 @@ namespace nap
 
 	bool TweenService::init(nap::utility::ErrorState& errorState)
 	{
+		TweenServiceConfiguration* config = getConfiguration<TweenServiceConfiguration>();
+		mMainThread = std::this_thread::get_id();
+		if (config == nullptr)
+			return true;
+
+		if (!errorState.check(config->mInitialCapacity >= 0, "InitialCapacity can't be negative"))
+			return false;
+		mInitialCapacity = static_cast<size_t>(config->mInitialCapacity);
+		mTweensToRemove.reserve(mInitialCapacity);
+		mTweensRemoving.reserve(mInitialCapacity);
+		mLazy = config->mLazy;
+		mStartStagedSameFrame = config->mStartStagedSameFrame;
+
+		if (!errorState.check(config->mTraceCapacity > 0, "TraceCapacity must be greater than 0"))
+			return false;
+		mTraceCapacity = static_cast<uint32>(config->mTraceCapacity);
+		if (config->mTrace)
+			startTrace();
+
+		// bake the ease table and report its accuracy
+		if (config->mEaseTable)
+		{
+			if (!errorState.check(config->mEaseTableResolution >= 2, "EaseTableResolution must be at least 2"))
+				return false;
+
+			mEaseTable = std::make_unique<TweenEaseTable>(static_cast<uint32>(config->mEaseTableResolution), config->mEaseTableInterpolation);
+			nap::Logger::info(mEaseTable->getReport());
+		}
+
+		if (!config->mParallel)
+			return true;
+
+		if (!errorState.check(config->mChunkSize > 0, "ChunkSize must be greater than 0"))
+			return false;
+		mChunkSize = static_cast<uint32>(config->mChunkSize);
+
+		// the main thread evaluates chunks as well, spawn one worker less than there are cores
+		int thread_count = config->mThreadCount;
+		if (thread_count <= 0)
+			thread_count = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+
+		if (thread_count > 0)
+		{
+			// every thread runs a worker loop until shutdown, an update only wakes them
+			mThreadPool = std::make_unique<ThreadPool>(thread_count);
+			mStopWorkers = false;
+			for (int i = 0; i < thread_count; i++)
+				mThreadPool->execute([this]() { runWorker(); });
+		}
 		return true;
 	}
 
 
 	void TweenService::update(double deltaTime)
 	{
-		// update tweens
-		auto itr = mTweens.begin();
-		while (itr!=mTweens.end())
+		// create, change and destroy the tweens requested by other threads since the last update
+		auto update_begin = StatsClock::now();
+		mStats.mCommandCount = mCommands.execute();
+
+		// tweens created from now on by signal handlers and tasks are staged, they start at the end of the update
+		mUpdating = true;
+		for (auto& pool : mPools)
+			pool->beginStaging();
+
+		// compute the effective delta time of every group once
+		mClocks.advance(deltaTime);
+
+		// members of cancelled groups are killed before they are evaluated
+		if (mClocks.isKillPending())
 		{
-			(*itr)->update(deltaTime);
-			++itr;
+			mClocks.takeKillQueue(mKilledGroups);
+			for (auto& pool : mPools)
+				pool->killCancelled(mKilledGroups);
 		}
 
-		// remove any killed tweens
-		std::vector<TweenBase*> tweens_to_remove;
-		mTweensToRemove.swap(tweens_to_remove);
-		for(auto* tween : tweens_to_remove)
+		// update tweens, a parallel update evaluates all pools before dispatching any signal
+		if (mThreadPool != nullptr)
+		{
+			updateParallel(deltaTime);
+		}
+		else
 		{
-			itr = mTweens.begin();
-			while (itr!=mTweens.end())
+			// signals of a pool are dispatched before the next pool is evaluated
+			mStats.mEvaluationTime = 0.0;
+			mStats.mDispatchTime = 0.0;
+			for (uint32 i = 0; i < mPools.size(); i++)
 			{
-				if(itr->get() == tween)
+				auto begin = StatsClock::now();
+				mPools[i]->evaluate(deltaTime);
+				auto evaluated = StatsClock::now();
+				mPools[i]->dispatch();
+				auto dispatched = StatsClock::now();
+				mStats.mEvaluationTime += getSeconds(begin, evaluated);
+				mStats.mDispatchTime += getSeconds(evaluated, dispatched);
+				if (mActiveTrace != nullptr)
 				{
-					if( !tween->mComplete )
-					{
-						tween->mKilled = true;
-						tween->KilledSignal();
-					}
-
-					mTweens.erase(itr);
-					break;
-				}else
-				{
-					++itr;
+					mActiveTrace->recordSpan(ETweenTraceEvent::Evaluate, mTypeNames[i], begin, evaluated);
+					mActiveTrace->recordSpan(ETweenTraceEvent::Dispatch, mTypeNames[i], evaluated, dispatched);
 				}
 			}
 		}
+
+		// every tween that is about to be removed still counts towards the peak
+		for (uint32 i = 0; i < mPools.size(); i++)
+		{
+			TweenTypeStats& stats = mStats.mTypes[i];
+			stats.mPeakCount = std::max(stats.mPeakCount, mPools[i]->size());
+			stats.mPendingRemovalCount = 0;
+		}
+
+		// remove any killed tweens and the played tweens that completed, every removal is O(1)
+		auto begin = StatsClock::now();
+		for (auto& pool : mPools)
+			pool->recycle();
+		mTweensToRemove.swap(mTweensRemoving);
+		TweenPoolBase* pool = nullptr;
+		TweenTypeStats* stats = nullptr;
+		for(auto& entry : mTweensRemoving)
+		{
+			// removals of the same handle are stored together
+			if (entry.first != pool)
+			{
+				pool = entry.first;
+				stats = &getStats(*pool);
+			}
+			stats->mPendingRemovalCount++;
+			entry.first->remove(entry.second);
+		}
+		mTweensRemoving.clear();
+		auto removed = StatsClock::now();
+		mStats.mRemovalTime = getSeconds(begin, removed);
+
+		// resume the tasks whose tween completed, delay passed or that started since the last update, all at once
+		mTasks.update(mClocks.getTime(0));
+		auto resumed = StatsClock::now();
+		mStats.mTaskTime = getSeconds(removed, resumed);
+
+		// merge the staged tweens in bulk, in the same order as a serial update
+		mUpdating = false;
+		mStats.mStagedCount = 0;
+		for (auto& pool : mPools)
+			mStats.mStagedCount += pool->merge(mStartStagedSameFrame);
+		auto end = StatsClock::now();
+		mStats.mDispatchTime += getSeconds(resumed, end);
+		updateStats();
+
+		if (mActiveTrace != nullptr)
+		{
+			mActiveTrace->recordSpan(ETweenTraceEvent::Remove, nullptr, begin, removed);
+			mActiveTrace->recordSpan(ETweenTraceEvent::Resume, nullptr, removed, end);
+			mActiveTrace->recordSpan(ETweenTraceEvent::Update, nullptr, update_begin, end);
+		}
+	}
+
+
+	void TweenService::updateStats()
+	{
+		mStats.mFrame++;
+		mStats.mActiveCount = 0;
+		mStats.mDormantCount = 0;
+		mStats.mPendingRemovalCount = 0;
+		size_t allocation_count = mAllocations + TweenHandleBase::getAllocationCount() + mTasks.getAllocationCount();
+		mStats.mTaskCount = mTasks.getTaskCount();
+		for (uint32 i = 0; i < mPools.size(); i++)
+		{
+			TweenTypeStats& stats = mStats.mTypes[i];
+			stats.mActiveCount = mPools[i]->getActiveCount();
+			stats.mDormantCount = mPools[i]->getDormantCount();
+			mStats.mActiveCount += stats.mActiveCount;
+			mStats.mDormantCount += stats.mDormantCount;
+			mStats.mPendingRemovalCount += stats.mPendingRemovalCount;
+			allocation_count += mPools[i]->getAllocationCount();
+		}
+
+		// the peaks of the types don't have to coincide, the total is tracked separately
+		mStats.mPeakCount = std::max(mStats.mPeakCount, mStats.mActiveCount + mStats.mDormantCount + mStats.mPendingRemovalCount);
+		mStats.mAllocationCount = allocation_count - mLastAllocationCount;
+		mLastAllocationCount = allocation_count;
+	}
+
+
+	TweenTypeStats& TweenService::getStats(const TweenPoolBase& pool)
+	{
+		auto it = std::find_if(mPools.begin(), mPools.end(), [&pool](const auto& entry) { return entry.get() == &pool; });
+		assert(it != mPools.end());
+		return mStats.mTypes[it - mPools.begin()];
+	}
+
+
+	void TweenService::startTrace()
+	{
+		mTrace = std::make_unique<TweenTrace>(mTraceCapacity);
+		mActiveTrace = mTrace.get();
+		for (uint32 i = 0; i < mPools.size(); i++)
+			mPools[i]->setTrace(mActiveTrace, mTypeNames[i]);
+	}
+
+
+	void TweenService::stopTrace()
+	{
+		mActiveTrace = nullptr;
+		for (uint32 i = 0; i < mPools.size(); i++)
+			mPools[i]->setTrace(nullptr, mTypeNames[i]);
+	}
+
+
+	bool TweenService::writeTrace(const std::string& path, utility::ErrorState& error) const
+	{
+		if (!error.check(mTrace != nullptr, "No trace was started"))
+			return false;
+		return mTrace->write(path, error);
+	}
+
+
+	void TweenService::addPool(std::unique_ptr<TweenPoolBase> pool, std::type_index type, const std::string& name)
+	{
+		pool->setClocks(mClocks);
+		mPoolMap.emplace(type, pool.get());
+		mStats.mTypes.emplace_back();
+		mStats.mTypes.back().mName = name;
+		mTypeNames.emplace_back(getName(name));
+		pool->setTrace(mActiveTrace, mTypeNames.back());
+		if (mUpdating)
+			pool->beginStaging();
+		mPools.emplace_back(std::move(pool));
+
+		// all handle types share the same memory
+		TweenHandleBase::reserve(mInitialCapacity * mPools.size());
+	}
+
+
+	const char* TweenService::getName(const std::string& name)
+	{
+		if (name.empty())
+			return nullptr;
+		return mNames.emplace(name).first->c_str();
+	}
+
+
+	void TweenService::resetPeakCount()
+	{
+		mStats.mPeakCount = 0;
+		for (uint32 i = 0; i < mPools.size(); i++)
+		{
+			mStats.mTypes[i].mPeakCount = mPools[i]->size();
+			mStats.mPeakCount += mPools[i]->size();
+		}
+	}
+
+
+	void TweenService::updateParallel(double deltaTime)
+	{
+		// split all active tweens into ranges, in the order of a serial update
+		auto begin = StatsClock::now();
+		size_t capacity = mRanges.capacity();
+		mRanges.clear();
+		for (auto& pool : mPools)
+		{
+			pool->beginUpdate(deltaTime);
+			pool->getRanges(mChunkSize, mRanges);
+		}
+		mAllocations += mRanges.capacity() != capacity ? 1 : 0;
+
+		// the event buffers keep their memory, they only allocate when a range raises more events than before
+		if (mRangeEvents.size() < mRanges.size())
+		{
+			mRangeEvents.resize(mRanges.size());
+			mAllocations++;
+		}
+		capacity = 0;
+		for (uint32 i = 0; i < mRanges.size(); i++)
+		{
+			mRangeEvents[i].clear();
+			capacity += mRangeEvents[i].capacity();
+		}
+
+		// wake the workers when there is more than one range, the main thread takes part
+		mNextRange = 0;
+		bool wake = mRanges.size() > 1;
+		if (wake)
+		{
+			std::lock_guard<std::mutex> lock(mWorkerMutex);
+			mActiveWorkers = static_cast<uint32>(mThreadPool->getThreadCount());
+			mWorkerFrame++;
+			mWakeCondition.notify_all();
+		}
+		processRanges();
+
+		// wait for all workers to finish
+		if (wake)
+		{
+			std::unique_lock<std::mutex> lock(mWorkerMutex);
+			mWorkerCondition.wait(lock, [this]() { return mActiveWorkers == 0; });
+		}
+
+		// move completed tweens to the dormant set
+		for (auto& pool : mPools)
+			pool->endUpdate();
+		auto evaluated = StatsClock::now();
+
+		// dispatch signals on the main thread after all pools are evaluated, range order equals serial update order
+		for (uint32 i = 0; i < mRanges.size(); i++)
+		{
+			capacity -= mRangeEvents[i].capacity();
+			mRanges[i].mPool->dispatch(mRangeEvents[i]);
+		}
+		mAllocations += capacity != 0 ? 1 : 0;
+		auto dispatched = StatsClock::now();
+		mStats.mEvaluationTime = getSeconds(begin, evaluated);
+		mStats.mDispatchTime = getSeconds(evaluated, dispatched);
+		if (mActiveTrace != nullptr)
+		{
+			mActiveTrace->recordSpan(ETweenTraceEvent::Evaluate, nullptr, begin, evaluated);
+			mActiveTrace->recordSpan(ETweenTraceEvent::Dispatch, nullptr, evaluated, dispatched);
+		}
+	}
+
+
+	void TweenService::processRanges()
+	{
+		// every range shows up on the timeline of the thread that evaluated it
+		uint32 count = static_cast<uint32>(mRanges.size());
+		for (uint32 i = mNextRange++; i < count; i = mNextRange++)
+		{
+			auto begin = mActiveTrace != nullptr ? StatsClock::now() : StatsClock::time_point();
+			mRanges[i].mPool->updateRange(mRanges[i], mRangeEvents[i]);
+			if (mActiveTrace != nullptr)
+				mActiveTrace->recordSpan(ETweenTraceEvent::Evaluate, nullptr, begin, StatsClock::now());
+		}
+	}
+
+
+	void TweenService::runWorker()
+	{
+		uint64 frame = 0;
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mWorkerMutex);
+				mWakeCondition.wait(lock, [this, frame]() { return mStopWorkers || mWorkerFrame != frame; });
+				if (mStopWorkers)
+					return;
+				frame = mWorkerFrame;
+			}
+
+			processRanges();
+			std::lock_guard<std::mutex> lock(mWorkerMutex);
+			if (--mActiveWorkers == 0)
+				mWorkerCondition.notify_one();
+		}
+	}
+
+
+	void TweenService::stopWorkers()
+	{
+		if (mThreadPool == nullptr)
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(mWorkerMutex);
+			mStopWorkers = true;
+			mWakeCondition.notify_all();
+		}
+		mThreadPool->shutdown();
+		mThreadPool = nullptr;
 	}
 
 
 	void TweenService::shutdown()
 	{
+		stopWorkers();
+
+		// stopping a task kills its tweens, the pools must still exist
+		mTasks.clear();
+		mCommands.execute();
 		mTweensToRemove.clear();
-		mTweens.clear();
+		mTweensRemoving.clear();
+		mPoolMap.clear();
+		mPools.clear();
+		mStats.mTypes.clear();
+		mTypeNames.clear();
+		mActiveTrace = nullptr;
+		mEaseTable = nullptr;
 	}
 
 
-	void TweenService::removeTween(TweenBase* tween)
+	std::unique_ptr<BufferTweenHandle> TweenService::createBufferTween(const float* start, const float* end, float* output, size_t count, float duration, utility::ErrorState& error, ETweenEaseType easeType, ETweenMode mode)
 	{
-		mTweensToRemove.emplace_back(tween);
+		if (!error.check(duration > 0.0f, "Tween duration must be greater than 0.0f"))
+			return nullptr;
+		if (!error.check(count == 0 || (start != nullptr && end != nullptr && output != nullptr), "Buffer tween requires a start, end and output buffer"))
+			return nullptr;
+		if (!error.check(count == 0 || (output != start && output != end), "Buffer tween output can't alias its start or end buffer"))
+			return nullptr;
+		if (!error.check(count <= std::numeric_limits<uint32>::max(), "Buffer tween can't hold more than 2^32 - 1 floats"))
+			return nullptr;
+
+		// construct tween in pool, writes the start of the tween into the output
+		BufferTweenPool& pool = getBufferPool();
+		BufferTween& tween = pool.create(start, end, output, static_cast<uint32>(count), duration, easeType, mode);
+
+		// construct handle
+		return std::make_unique<BufferTweenHandle>(*this, pool, tween.getID());
+	}
+
+
+	BufferTweenPool& TweenService::getBufferPool()
+	{
+		auto it = mPoolMap.find(std::type_index(typeid(BufferTween)));
+		if (it != mPoolMap.end())
+			return static_cast<BufferTweenPool&>(*it->second);
+
+		auto pool = std::make_unique<BufferTweenPool>();
+		pool->reserve(mInitialCapacity);
+		BufferTweenPool& ref = *pool;
+		addPool(std::move(pool), std::type_index(typeid(BufferTween)), "buffer");
+		return ref;
+	}
+
+
+	std::unique_ptr<TweenGroup> TweenService::createGroup(TweenGroup* parent)
+	{
+		return std::make_unique<TweenGroup>(mClocks, parent);
+	}
+
+
+	void TweenService::removeTweens(TweenPoolBase& pool, const std::vector<TweenID>& ids)
+	{
+		// handles destroyed on other threads remove their tweens at the start of the next update
+		if (!isMainThread())
+		{
+			mCommands.post([this, &pool, ids]() { removeTweens(pool, ids); });
+			return;
+		}
+
+		if (mTweensToRemove.size() + ids.size() > mTweensToRemove.capacity())
+		{
+			mTweensToRemove.reserve(mTweensToRemove.size() + ids.size());
+			mAllocations++;
+		}
+		for (const auto& id : ids)
+			removeTween(pool, id);
+	}
+
+
+	size_t TweenService::getActiveTweenCount() const
+	{
+		size_t count = 0;
+		for (const auto& pool : mPools)
+			count += pool->getActiveCount();
+		return count;
+	}
+
+
+	size_t TweenService::getDormantTweenCount() const
+	{
+		size_t count = 0;
+		for (const auto& pool : mPools)
+			count += pool->getDormantCount();
+		return count;
+	}
+
+
+	bool TweenService::isPlaying(TweenPlayID id) const
+	{
+		return id.mPool != nullptr && !mPools.empty() && id.mPool->isValid(id.mID);
+	}
+
+
+	void TweenService::kill(TweenPlayID id)
+	{
+		if (isPlaying(id))
+			removeTween(*id.mPool, id.mID);
+	}
+
+
+	void TweenService::stop(TweenTaskID id)
+	{
+		mTasks.stop(id);
+	}
+
+
+	bool TweenService::isRunning(TweenTaskID id) const
+	{
+		return mTasks.isRunning(id);
+	}
+
+
+	TweenTaskArena& getTweenTaskArena(TweenService& service)
+	{
+		return service.mTasks.getArena();
+	}
+
+
+	void TweenService::setLabel(TweenPlayID id, const std::string& label)
+	{
+		if (isPlaying(id))
+			id.mPool->setLabel(id.mID, getName(label));
+	}
+
+
+	void TweenService::removeTween(TweenPoolBase& pool, TweenID id)
+	{
+		if (!isMainThread())
+		{
+			mCommands.post([this, &pool, id]() { removeTween(pool, id); });
+			return;
+		}
+
+		// the owner of the handle might delete the bound output, stop writing to it right away.
+		// handles can outlive the pools when they are destroyed after shutdown
+		if (!mPools.empty())
+			pool.unbind(id);
+		mAllocations += mTweensToRemove.size() == mTweensToRemove.capacity() ? 1 : 0;
+		mTweensToRemove.emplace_back(&pool, id);
 	}
 }
\ No newline at end of file
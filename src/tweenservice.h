@@ -7,20 +7,135 @@
 // External Includes
 #include <nap/service.h>
 #include <rtti/factory.h>
+#include <utility/threading.h>
 
 // local includes
 #include "tweeneasing.h"
 #include "tween.h"
+#include "tweenspring.h"
+#include "tweenbuffer.h"
 #include "tweenhandle.h"
 #include "tweenmode.h"
+#include "tweenpool.h"
+#include "tweengroup.h"
+#include "tweentrace.h"
+#include "tweentask.h"
+#include "tweencommand.h"
+
+// std includes
+#include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <string>
 
 namespace nap
 {
 	//////////////////////////////////////////////////////////////////////////
 
+	// forward declares
+	class TweenService;
+
+	/**
+	 * Lightweight id of a tween started with TweenService::play(), kill the tween with TweenService::kill().
+	 * The id stays safe to use after the tween completed, it no longer resolves to a tween once the tween is recycled.
+	 */
+	struct NAPAPI TweenPlayID
+	{
+		TweenPoolBase*	mPool = nullptr;		///< Pool the tween is stored in, nullptr when the tween couldn't be created
+		TweenID			mID;					///< Id of the tween in its pool
+	};
+
+	// forward declares
+	template<typename T>
+	class TweenAsyncHandle;
+
+#ifdef NAP_TWEEN_COROUTINES
+	template<typename T>
+	class TweenTaskTween;
+#endif
+
+
+	/**
+	 * Tween statistics of one tweened value type, see TweenServiceStats
+	 */
+	struct NAPAPI TweenTypeStats
+	{
+		std::string		mName;							///< Name of the tweened value type
+		size_t			mActiveCount = 0;				///< Tweens that are evaluated every update
+		size_t			mDormantCount = 0;				///< Completed, paused or delayed tweens, these cost nothing to update
+		size_t			mPendingRemovalCount = 0;		///< Tweens whose handle was destroyed before the update, removed during the update
+		size_t			mPeakCount = 0;					///< Highest number of tweens since the statistics were reset
+	};
+
+
+	/**
+	 * Statistics of the last TweenService update, refreshed every update.
+	 * Collecting them costs a few clock reads per pool and no allocations, they are always available.
+	 */
+	struct NAPAPI TweenServiceStats
+	{
+		uint64						mFrame = 0;					///< Number of updates
+		std::vector<TweenTypeStats>	mTypes;						///< Statistics per tweened value type, in order of first use
+		size_t						mActiveCount = 0;			///< Tweens that are evaluated every update, all types
+		size_t						mDormantCount = 0;			///< Completed, paused or delayed tweens, all types
+		size_t						mPendingRemovalCount = 0;	///< Tweens removed during the update, all types
+		size_t						mPeakCount = 0;				///< Highest number of tweens since the statistics were reset, all types
+		size_t						mAllocationCount = 0;		///< Memory allocations made by the tween service and its pools since the previous update
+		double						mEvaluationTime = 0.0;		///< Seconds spent evaluating tweens
+		double						mDispatchTime = 0.0;		///< Seconds spent dispatching signals
+		double						mRemovalTime = 0.0;			///< Seconds spent removing tweens, includes dispatching their killed signal
+		double						mTaskTime = 0.0;			///< Seconds spent resuming tween tasks
+		size_t						mTaskCount = 0;				///< Running tween tasks
+		size_t						mCommandCount = 0;			///< Commands posted by other threads, executed at the start of the update
+		size_t						mStagedCount = 0;			///< Tweens created by handlers and tasks during the update, merged at the end of the update
+
+		/**
+		 * @return seconds spent updating tweens
+		 */
+		double getUpdateTime() const		{ return mEvaluationTime + mDispatchTime + mRemovalTime + mTaskTime; }
+	};
+
+
+	/**
+	 * TweenService configuration
+	 * When Parallel is enabled, the tweens are split into chunks that are evaluated on a pool of worker threads.
+	 * Signals are always dispatched on the main thread, in the same order as a serial update. A serial update dispatches
+	 * the signals of a pool before the next pool is evaluated, a parallel update evaluates all pools before any signal is
+	 * dispatched. In parallel mode a handler therefore sees the tweens of every pool already advanced, and a change it makes
+	 * to a tween of a later pool takes effect in the next update.
+	 * When Trace is enabled, tween lifecycle events are recorded from the start, see TweenService::startTrace().
+	 */
+	class NAPAPI TweenServiceConfiguration : public ServiceConfiguration
+	{
+		RTTI_ENABLE(ServiceConfiguration)
+	public:
+		bool mParallel = false;				///< Property: 'Parallel' evaluate tweens on worker threads
+		int mThreadCount = 0;				///< Property: 'ThreadCount' number of worker threads, 0 uses all available cores
+		int mChunkSize = 4096;				///< Property: 'ChunkSize' maximum number of tweens evaluated by a worker at once
+		int mInitialCapacity = 256;			///< Property: 'InitialCapacity' number of tweens and handles preallocated per tweened value type
+		bool mEaseTable = false;			///< Property: 'EaseTable' sample eases from a precomputed table instead of evaluating them, see TweenEaseTable for the error
+		int mEaseTableResolution = 1024;	///< Property: 'EaseTableResolution' number of intervals per ease in the table
+		ETweenEaseTableInterpolation mEaseTableInterpolation = ETweenEaseTableInterpolation::LINEAR;	///< Property: 'EaseTableInterpolation' interpolation between table samples
+		bool mLazy = false;					///< Property: 'Lazy' tweens compute their value when read, unless bound or observed by an update handler
+		bool mTrace = false;				///< Property: 'Trace' record tween lifecycle events and update spans from the start
+		int mTraceCapacity = 65536;			///< Property: 'TraceCapacity' number of trace events kept, older events are overwritten
+		bool mStartStagedSameFrame = false;	///< Property: 'StartStagedSameFrame' tweens created during an update receive their start value in that update, otherwise they start in the next update
+
+		/**
+		 * @return the service type this configuration belongs to
+		 */
+		virtual rtti::TypeInfo getServiceType() const override		{ return RTTI_OF(TweenService); }
+	};
+
+
 	/**
 	 * The TweenService is responsible for creating, updating and retaining Tweens created by the TweenService
-	 * Once you call createTween<T> on the TweenService. It will construct a new Tween and keep the unique_ptr to the Tween stored internally.
+	 * Once you call createTween<T> on the TweenService. It will construct a new Tween in the TweenPool of type T.
+	 * Every pool stores its tweens in contiguous arrays, grouped by mode and ease, and updates them in one tight loop per group.
 	 * Then, the TweenService will make a handle to that tween and return a unique_ptr to the TweenHandle which needs to be managed outside the TweenService ( typically, by the class from where you call the createTween<T> method )
 	 * The function of the Handle is to provide the user access to the Tween without having to worry about memory managament. Once the unique_ptr of the handle is out of scope, the created handle will be deconstructed and notify the TweenService to mark the Tween for deletion
 	 * This is to prevent memory access violations that can occur when you dispose a Tween during a call to its Update, Killed or Complete signal
@@ -28,6 +143,7 @@ namespace nap
 	class NAPAPI TweenService : public Service
 	{
 		friend class TweenHandleBase;
+		friend class TweenBatchHandleBase;
 
 		RTTI_ENABLE(Service)
 	public:
@@ -50,6 +166,255 @@ namespace nap
 		 */
 		template<typename T>
 		std::unique_ptr<TweenHandle<T>> createTween(T startValue, T endValue, float duration, utility::ErrorState& error, ETweenEaseType easeType = ETweenEaseType::LINEAR, ETweenMode mode = ETweenMode::NORMAL);
+
+		/**
+		 * creates a Tween with an ease that is fixed at compile time, for example: createTween<glm::vec3, EaseOutCubic>(...)
+		 * Return nullptr upon failure in that case error contains error message
+		 * @tparam T the value type to tween
+		 * @tparam Ease the ease tag, see tweeneasing.h
+		 */
+		template<typename T, typename Ease>
+		std::unique_ptr<TweenHandle<T, Ease>> createTween(T startValue, T endValue, float duration, utility::ErrorState& error, ETweenMode mode = ETweenMode::NORMAL);
+
+		/**
+		 * creates a SpringTween that rests at the given value, call SpringTween::setTarget() to move it.
+		 * The spring follows its target with the motion of a damped spring, see SpringTween.
+		 * Once the handle is deconstructed, the spring is deleted during the next update
+		 * Return nullptr upon failure in that case error contains error message
+		 * @param value the initial value and target
+		 * @param frequency natural frequency in Hz, how fast the spring responds
+		 * @param damping damping ratio, 1 is critically damped, below 1 overshoots, above 1 approaches the target slower
+		 * @param error contains the error when creation fails
+		 * @tparam T the value type to tween, float, double or a glm vector
+		 */
+		template<typename T>
+		std::unique_ptr<SpringTweenHandle<T>> createSpring(T value, float frequency, float damping, utility::ErrorState& error);
+
+		/**
+		 * creates a BufferTween that interpolates a whole buffer of floats in place, see BufferTween.
+		 * The buffers are owned by the caller and must outlive the handle, the output is written right away.
+		 * Once the handle is deconstructed, the tween is deleted during the next update
+		 * Return nullptr upon failure in that case error contains error message
+		 * @param start values at the start of the tween
+		 * @param end values at the end of the tween
+		 * @param output receives the interpolated values every update, must not alias start or end: both are read every update
+		 * @param count number of floats in every buffer
+		 * @param duration the duration in seconds
+		 * @param error contains the error when creation fails
+		 * @param easeType the ease type
+		 * @param mode the tween mode
+		 */
+		std::unique_ptr<BufferTweenHandle> createBufferTween(const float* start, const float* end, float* output, size_t count, float duration, utility::ErrorState& error, ETweenEaseType easeType = ETweenEaseType::LINEAR, ETweenMode mode = ETweenMode::NORMAL);
+
+		/**
+		 * creates a BufferTween over buffers of glm vectors, every component is tweened as a separate float
+		 * Return nullptr upon failure in that case error contains error message
+		 * @tparam T glm::vec2, glm::vec3 or glm::vec4
+		 */
+		template<typename T>
+		std::unique_ptr<BufferTweenHandle> createBufferTween(const T* start, const T* end, T* output, size_t count, float duration, utility::ErrorState& error, ETweenEaseType easeType = ETweenEaseType::LINEAR, ETweenMode mode = ETweenMode::NORMAL);
+
+		/**
+		 * creates a tween from any thread, the tween is added to the service at the start of the next update.
+		 * The returned handle can be used right away on the calling thread, its requests are executed in order on the main thread.
+		 * Once the handle is deconstructed, the tween is deleted at the start of the next update,
+		 * until then the tween keeps writing to its bound memory, see TweenAsyncHandle::bind().
+		 * Return nullptr upon failure in that case error contains error message
+		 * @param startValue the start value
+		 * @param endValue the end value
+		 * @param duration the duration in seconds
+		 * @param error contains the error when creation fails
+		 * @param easeType the ease type
+		 * @param mode the tween mode
+		 * @tparam T the value type to tween
+		 */
+		template<typename T>
+		std::unique_ptr<TweenAsyncHandle<T>> createTweenAsync(T startValue, T endValue, float duration, utility::ErrorState& error, ETweenEaseType easeType = ETweenEaseType::LINEAR, ETweenMode mode = ETweenMode::NORMAL);
+
+		/**
+		 * Calls a function on the main thread at the start of the next update, can be called from any thread.
+		 * Functions of the same thread are called in the order in which they were posted.
+		 * Posting never blocks, it allocates the command that holds the function.
+		 * @param function the function to call, without arguments
+		 */
+		template<typename Function>
+		void post(Function&& function)									{ mCommands.post(std::forward<Function>(function)); }
+
+		/**
+		 * @return if the calling thread is the thread that created the service, which updates the tweens
+		 */
+		bool isMainThread() const										{ return std::this_thread::get_id() == mMainThread; }
+
+		/**
+		 * plays a tween without a handle: the tween is recycled into its pool right after its CompleteSignal is dispatched.
+		 * Set up the tween right away with getTween(), for example to bind its output or connect to its signals.
+		 * LOOP and PING_PONG tweens never complete, they play until they are killed or the service shuts down.
+		 * Returns an id without pool upon failure, in that case error contains error message
+		 * @param startValue the start value
+		 * @param endValue the end value
+		 * @param duration the duration in seconds
+		 * @param error contains the error when creation fails
+		 * @param easeType the ease type
+		 * @param mode the tween mode
+		 * @tparam T the value type to tween
+		 * @return id of the tween, kills the tween with kill()
+		 */
+		template<typename T>
+		TweenPlayID play(T startValue, T endValue, float duration, utility::ErrorState& error, ETweenEaseType easeType = ETweenEaseType::LINEAR, ETweenMode mode = ETweenMode::NORMAL);
+
+		/**
+		 * @param id id of a tween started with play()
+		 * @tparam T the value type of the tween
+		 * @return the tween while it plays, nullptr once it is recycled or killed
+		 */
+		template<typename T>
+		Tween<T>* getTween(TweenPlayID id);
+
+		/**
+		 * @param id id of a tween started with play()
+		 * @return if the tween plays, false once it is recycled or killed
+		 */
+		bool isPlaying(TweenPlayID id) const;
+
+		/**
+		 * kills a tween started with play(), the tween is removed during the next update.
+		 * The output binding of the tween is removed right away, nothing happens when the tween was already recycled.
+		 * @param id id of the tween
+		 */
+		void kill(TweenPlayID id);
+
+		/**
+		 * Sets a label that identifies a tween started with play() in a trace, see startTrace()
+		 * @param id id of the tween
+		 * @param label the label, empty for none
+		 */
+		void setLabel(TweenPlayID id, const std::string& label);
+
+		/**
+		 * stops a task started with start(), destroys its coroutine and kills the tweens it waits for.
+		 * A task that stops itself is destroyed when it suspends, nothing happens when the task already finished.
+		 * @param id id of the task
+		 */
+		void stop(TweenTaskID id);
+
+		/**
+		 * @param id id of a task started with start()
+		 * @return if the task is running, false once it finished or is stopped
+		 */
+		bool isRunning(TweenTaskID id) const;
+
+		/**
+		 * @return number of running tasks
+		 */
+		size_t getTaskCount() const										{ return mTasks.getTaskCount(); }
+
+#ifdef NAP_TWEEN_COROUTINES
+		/**
+		 * starts a task, the task is resumed for the first time during the next update.
+		 * Suspended tasks are resumed once per update, after all tweens are updated and the completed tweens are recycled.
+		 * @param task the task to start, see TweenTask
+		 * @return id of the task, stop the task with stop()
+		 */
+		TweenTaskID start(TweenTask task)								{ return task.start(mTasks); }
+
+		/**
+		 * plays a tween that a task awaits: co_await service.tween(0.0f, 1.0f, 0.5f).bind(&value)
+		 * The task continues once the tween completed, the tween is killed when the task is stopped.
+		 * A tween without duration completes right away, its bound output receives the end value.
+		 * @param startValue the start value
+		 * @param endValue the end value
+		 * @param duration the duration in seconds
+		 * @param easeType the ease type
+		 * @tparam T the value type to tween
+		 * @return the tween to await
+		 */
+		template<typename T>
+		TweenTaskTween<T> tween(T startValue, T endValue, float duration, ETweenEaseType easeType = ETweenEaseType::LINEAR);
+#endif
+
+		/**
+		 * creates a group of tweens at once, validates and reserves memory once for the whole group
+		 * returns a single handle that owns all tweens, destroying the handle removes the whole group
+		 * Return nullptr upon failure in that case error contains error message
+		 * @param count number of tweens to create
+		 * @param startValues start value of every tween, count values
+		 * @param endValues end value of every tween, count values
+		 * @param durations duration of every tween, count values
+		 * @param error contains the error when creation fails
+		 * @param easeTypes ease of every tween, count values, nullptr creates LINEAR tweens
+		 * @param modes mode of every tween, count values, nullptr creates NORMAL tweens
+		 * @tparam T the value type to tween
+		 */
+		template<typename T>
+		std::unique_ptr<TweenBatchHandle<T>> createTweens(size_t count, const T* startValues, const T* endValues, const float* durations, utility::ErrorState& error, const ETweenEaseType* easeTypes = nullptr, const ETweenMode* modes = nullptr);
+
+		/**
+		 * creates a tween group with its own time scale and paused state, add tweens to it with Tween::setGroup()
+		 * the effective time scale of every group is computed once per update, changing a group is O(1)
+		 * @param parent the parent group, nullptr for none
+		 * @return the group, destroying it kills the tweens in the group, see TweenGroup::cancel()
+		 */
+		std::unique_ptr<TweenGroup> createGroup(TweenGroup* parent = nullptr);
+
+		/**
+		 * @return if tweens are evaluated on worker threads
+		 */
+		bool isParallel() const											{ return mThreadPool != nullptr; }
+
+		/**
+		 * @return the ease table sampled by all tweens, nullptr when the eases are evaluated analytically
+		 */
+		const TweenEaseTable* getEaseTable() const						{ return mEaseTable.get(); }
+
+		/**
+		 * @return number of tweens that are evaluated every update
+		 */
+		size_t getActiveTweenCount() const;
+
+		/**
+		 * @return number of completed, paused or delayed tweens, these cost nothing to update
+		 */
+		size_t getDormantTweenCount() const;
+
+		/**
+		 * @return statistics of the last update: tween counts per value type, time spent per phase and allocations
+		 */
+		const TweenServiceStats& getStats() const						{ return mStats; }
+
+		/**
+		 * Restarts tracking the peak tween counts from the current number of tweens
+		 */
+		void resetPeakCount();
+
+		/**
+		 * Starts recording the creation, completion, restart and removal of every tween, and the spans of every update,
+		 * into a new ring buffer of 'TraceCapacity' events. Label tweens with TweenHandleBase::setLabel() to recognize them.
+		 * Recording never blocks or allocates, when not tracing every event costs a single branch.
+		 */
+		void startTrace();
+
+		/**
+		 * Stops recording, the recorded events can still be written
+		 */
+		void stopTrace();
+
+		/**
+		 * @return if tween events are recorded
+		 */
+		bool isTracing() const											{ return mActiveTrace != nullptr; }
+
+		/**
+		 * @return the last started trace, nullptr when no trace was started
+		 */
+		const TweenTrace* getTrace() const								{ return mTrace.get(); }
+
+		/**
+		 * Writes the events of the last started trace as Chrome trace event JSON, open the file in chrome://tracing or ui.perfetto.dev
+		 * @param path the file to write
+		 * @param error contains the error when no trace was started or the file can't be written
+		 * @return if the file was written
+		 */
+		bool writeTrace(const std::string& path, utility::ErrorState& error) const;
 	protected:
 
 		/**
@@ -77,16 +442,164 @@ namespace nap
 		void shutdown() override;
 	private:
 		/**
-		 * removes a tween, called by tween handle
-		 * @param pointer to tween
+		 * Returns the pool that holds all tweens of type T, created on first use
+		 * @tparam T the value type to tween
+		 * @return the pool of type T
+		 */
+		template<typename T>
+		TweenPool<T>& getPool();
+
+		/**
+		 * Returns the pool that holds all springs of type T, created on first use
+		 * @tparam T the value type to tween
+		 * @return the spring pool of type T
+		 */
+		template<typename T>
+		SpringTweenPool<T>& getSpringPool();
+
+		/**
+		 * Returns the pool that holds all buffer tweens, created on first use
+		 * @return the buffer tween pool
+		 */
+		BufferTweenPool& getBufferPool();
+
+		/**
+		 * Takes ownership of a new pool: the pool follows the clocks of the service, is traced and reported in the statistics
+		 * @param pool the pool
+		 * @param type key of the pool in the pool map
+		 * @param name name of the tweened value type, as shown in the statistics and traces
+		 */
+		void addPool(std::unique_ptr<TweenPoolBase> pool, std::type_index type, const std::string& name);
+
+		/**
+		 * marks a tween for removal, called by tween handle
+		 * @param pool the pool the tween is stored in
+		 * @param id the id of the tween in the pool
+		 */
+		void removeTween(TweenPoolBase& pool, TweenID id);
+
+		/**
+		 * marks a group of tweens for removal, called by batch handle
+		 * @param pool the pool the tweens are stored in
+		 * @param ids the ids of the tweens in the pool
+		 */
+		void removeTweens(TweenPoolBase& pool, const std::vector<TweenID>& ids);
+
+		/**
+		 * Evaluates all tweens in chunks on the worker threads and the calling thread, dispatches signals afterwards
+		 * @param deltaTime deltaTime
+		 */
+		void updateParallel(double deltaTime);
+
+		/**
+		 * Evaluates ranges until none are left, called by workers and the main thread
+		 */
+		void processRanges();
+
+		/**
+		 * Worker loop, started once when the service is initialized.
+		 * Waits for the next parallel update, evaluates ranges and reports back, until the workers are stopped.
+		 * Waking the workers doesn't hand a task to the thread pool, so a parallel update doesn't allocate memory.
 		 */
-		void removeTween(TweenBase* tween);
+		void runWorker();
 
-		// vector holding the tweens
-		std::vector<std::unique_ptr<TweenBase>> mTweens;
+		/**
+		 * Stops the worker loops and the thread pool
+		 */
+		void stopWorkers();
+
+		/**
+		 * Refreshes the tween counts and allocations of the statistics, called after every update
+		 */
+		void updateStats();
+
+		/**
+		 * @return the statistics of the given pool
+		 */
+		TweenTypeStats& getStats(const TweenPoolBase& pool);
+
+		/**
+		 * Stores a type name or label for the lifetime of the service, traces refer to names without copying them
+		 * @param name the name to store
+		 * @return the stored name, nullptr when the name is empty
+		 */
+		const char* getName(const std::string& name);
+
+		// gives tasks access to the arena of the service
+		friend TweenTaskArena& getTweenTaskArena(TweenService& service);
+
+		// clocks of all tween groups, followed by all pools
+		TweenClocks												mClocks;
+
+		// cancelled groups whose members are killed during this update, see TweenClocks::takeKillQueue()
+		std::vector<uint32>										mKilledGroups;
+
+		// all tween pools, in order of creation
+		std::vector<std::unique_ptr<TweenPoolBase>> 			mPools;
+
+		// maps the tweened value type to its pool, springs are stored by the type of spring
+		std::unordered_map<std::type_index, TweenPoolBase*> 	mPoolMap;
+
+		// requests of other threads, executed at the start of every update
+		TweenCommandQueue										mCommands;
+
+		// thread that created the service, tweens are only changed on this thread
+		std::thread::id											mMainThread;
+
+		// tween tasks, resumed at the end of every update
+		TweenTaskScheduler										mTasks;
 
 		// vector holding tweens that need to be removed
-		std::vector<TweenBase*> 				mTweensToRemove;
+		std::vector<std::pair<TweenPoolBase*, TweenID>> 		mTweensToRemove;
+
+		// tweens that are removed this update, swapped with mTweensToRemove to keep the memory of both
+		std::vector<std::pair<TweenPoolBase*, TweenID>> 		mTweensRemoving;
+
+		// statistics of the last update, mTypes is in the same order as mPools
+		TweenServiceStats										mStats;
+
+		// number of allocations made by the service, its pools and handles when the statistics were last refreshed
+		size_t													mLastAllocationCount = 0;
+
+		// number of allocations made by the service itself
+		size_t													mAllocations = 0;
+
+		// last started trace, mActiveTrace points to it while recording
+		std::unique_ptr<TweenTrace>								mTrace = nullptr;
+		TweenTrace*												mActiveTrace = nullptr;
+		uint32													mTraceCapacity = 65536;
+
+		// type names and labels referred to by traces, the strings don't move when the set grows
+		std::unordered_set<std::string>							mNames;
+
+		// name of the value type of every pool, in the same order as mPools
+		std::vector<const char*>								mTypeNames;
+
+		// number of tweens and handles preallocated per value type
+		size_t													mInitialCapacity = 256;
+
+		// ease table sampled by all pools, nullptr when the eases are evaluated analytically
+		std::unique_ptr<TweenEaseTable>							mEaseTable = nullptr;
+
+		// if created tweens are lazy
+		bool													mLazy = false;
+
+		// tweens created during an update are staged, merged at the end of the update
+		bool													mUpdating = false;
+		bool													mStartStagedSameFrame = false;
+
+		// parallel update
+		std::unique_ptr<ThreadPool>								mThreadPool = nullptr;	///< Worker threads, nullptr when updating serially
+		uint32													mChunkSize = 4096;		///< Maximum number of tweens in a range
+		std::vector<TweenRange>									mRanges;				///< Ranges evaluated this frame
+		std::vector<std::vector<TweenEvent>>					mRangeEvents;			///< Events raised per range, reused every frame
+		std::atomic<uint32>										mNextRange = { 0 };		///< Next range to evaluate
+		std::mutex												mWorkerMutex;			///< Guards the worker state below
+		std::condition_variable									mWakeCondition;			///< Signalled when an update has ranges for the workers or the workers stop
+		std::condition_variable									mWorkerCondition;		///< Signalled when a worker finishes
+		uint32													mActiveWorkers = 0;		///< Number of workers that are still evaluating
+		uint64													mWorkerFrame = 0;		///< Incremented for every update that wakes the workers
+		bool													mStopWorkers = false;	///< Ends the worker loops
 	};
 
 	//////////////////////////////////////////////////////////////////////////
@@ -99,18 +612,392 @@ namespace nap
         if(!error.check(duration > 0.0f, "Tween duration must be greater than 0.0f"))
             return nullptr;
 
-		// construct tween
-		std::unique_ptr<Tween<T>> tween = std::make_unique<Tween<T>>(startValue, endValue, duration);
-		tween->setEase(easeType);
-		tween->setMode(mode);
+		// construct tween in pool
+		TweenPool<T>& pool = getPool<T>();
+		Tween<T>& tween = pool.create(startValue, endValue, duration, easeType, mode);
 
 		// construct handle
-		std::unique_ptr<TweenHandle<T>> tween_handle = std::make_unique<TweenHandle<T>>(*this, tween.get());
-
-		// move ownership of tween
-		mTweens.emplace_back(std::move(tween));
+		std::unique_ptr<TweenHandle<T>> tween_handle = std::make_unique<TweenHandle<T>>(*this, pool, tween.getID());
 
 		// return unique_ptr to handle
 		return std::move(tween_handle);
 	}
+
+
+	template<typename T, typename Ease>
+	std::unique_ptr<TweenHandle<T, Ease>> TweenService::createTween(T startValue, T endValue, float duration, utility::ErrorState& error, ETweenMode mode)
+	{
+		if(!error.check(duration > 0.0f, "Tween duration must be greater than 0.0f"))
+			return nullptr;
+
+		// construct tween in pool
+		TweenPool<T>& pool = getPool<T>();
+		Tween<T, Ease>& tween = pool.template create<Ease>(startValue, endValue, duration, mode);
+
+		// construct handle
+		return std::make_unique<TweenHandle<T, Ease>>(*this, pool, tween.getID());
+	}
+
+
+	template<typename T>
+	std::unique_ptr<SpringTweenHandle<T>> TweenService::createSpring(T value, float frequency, float damping, utility::ErrorState& error)
+	{
+		if (!error.check(frequency > 0.0f, "Spring frequency must be greater than 0.0f"))
+			return nullptr;
+		if (!error.check(damping > 0.0f, "Spring damping must be greater than 0.0f"))
+			return nullptr;
+
+		// construct spring in pool
+		SpringTweenPool<T>& pool = getSpringPool<T>();
+		SpringTween<T>& spring = pool.create(value, frequency, damping);
+
+		// construct handle
+		return std::make_unique<SpringTweenHandle<T>>(*this, pool, spring.getID());
+	}
+
+
+	template<typename T>
+	std::unique_ptr<TweenAsyncHandle<T>> TweenService::createTweenAsync(T startValue, T endValue, float duration, utility::ErrorState& error, ETweenEaseType easeType, ETweenMode mode)
+	{
+		if (!error.check(duration > 0.0f, "Tween duration must be greater than 0.0f"))
+			return nullptr;
+
+		// the tween is resolved once it's created on the main thread, the handle owns the id and hands it to its destroy request.
+		// requests of a handle are executed or deleted in order, the id outlives every request that refers to it
+		auto tween = std::make_unique<TweenPlayID>();
+		TweenPlayID* id = tween.get();
+		mCommands.post([this, id, startValue, endValue, duration, easeType, mode]()
+		{
+			TweenPool<T>& pool = getPool<T>();
+			id->mPool = &pool;
+			id->mID = pool.create(startValue, endValue, duration, easeType, mode).getID();
+		});
+		return std::make_unique<TweenAsyncHandle<T>>(*this, std::move(tween));
+	}
+
+
+	template<typename T>
+	TweenPlayID TweenService::play(T startValue, T endValue, float duration, utility::ErrorState& error, ETweenEaseType easeType, ETweenMode mode)
+	{
+		if (!error.check(duration > 0.0f, "Tween duration must be greater than 0.0f"))
+			return {};
+
+		// construct tween in pool, no handle refers to it
+		TweenPool<T>& pool = getPool<T>();
+		TweenID id = pool.create(startValue, endValue, duration, easeType, mode).getID();
+		pool.setRecycled(id);
+		return { &pool, id };
+	}
+
+
+	template<typename T>
+	Tween<T>* TweenService::getTween(TweenPlayID id)
+	{
+		if (id.mPool == nullptr || mPools.empty())
+			return nullptr;
+
+		// tween has another value type, find the pool without inserting one
+		assert(mPoolMap.count(std::type_index(typeid(T))) != 0 && mPoolMap.at(std::type_index(typeid(T))) == id.mPool);
+		return static_cast<TweenPool<T>*>(id.mPool)->find(id.mID);
+	}
+
+
+	template<typename T>
+	std::unique_ptr<TweenBatchHandle<T>> TweenService::createTweens(size_t count, const T* startValues, const T* endValues, const float* durations, utility::ErrorState& error, const ETweenEaseType* easeTypes, const ETweenMode* modes)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			if (!error.check(durations[i] > 0.0f, "Tween duration must be greater than 0.0f"))
+				return nullptr;
+		}
+
+		// reserve once for the whole group
+		TweenPool<T>& pool = getPool<T>();
+		pool.reserve(pool.size() + count);
+		std::vector<TweenID> ids;
+		ids.reserve(count);
+
+		// construct tweens in pool
+		for (size_t i = 0; i < count; i++)
+		{
+			ETweenEaseType ease = easeTypes != nullptr ? easeTypes[i] : ETweenEaseType::LINEAR;
+			ETweenMode mode = modes != nullptr ? modes[i] : ETweenMode::NORMAL;
+			ids.emplace_back(pool.create(startValues[i], endValues[i], durations[i], ease, mode).getID());
+		}
+
+		// construct handle
+		return std::make_unique<TweenBatchHandle<T>>(*this, pool, std::move(ids));
+	}
+
+
+	template<typename T>
+	TweenPool<T>& TweenService::getPool()
+	{
+		auto it = mPoolMap.find(std::type_index(typeid(T)));
+		if (it != mPoolMap.end())
+			return static_cast<TweenPool<T>&>(*it->second);
+
+		auto pool = std::make_unique<TweenPool<T>>();
+		pool->reserve(mInitialCapacity);
+		pool->setEaseTable(mEaseTable.get());
+		pool->setLazy(mLazy);
+		TweenPool<T>& ref = *pool;
+		addPool(std::move(pool), std::type_index(typeid(T)), RTTI_OF(T).get_name().to_string());
+		return ref;
+	}
+
+
+	template<typename T>
+	std::unique_ptr<BufferTweenHandle> TweenService::createBufferTween(const T* start, const T* end, T* output, size_t count, float duration, utility::ErrorState& error, ETweenEaseType easeType, ETweenMode mode)
+	{
+		static_assert(hasTweenLerpBatch<T>, "buffer tweens only support tightly packed float vectors");
+		constexpr size_t components = sizeof(T) / sizeof(float);
+		return createBufferTween(reinterpret_cast<const float*>(start), reinterpret_cast<const float*>(end), reinterpret_cast<float*>(output), count * components, duration, error, easeType, mode);
+	}
+
+
+	template<typename T>
+	SpringTweenPool<T>& TweenService::getSpringPool()
+	{
+		auto it = mPoolMap.find(std::type_index(typeid(SpringTween<T>)));
+		if (it != mPoolMap.end())
+			return static_cast<SpringTweenPool<T>&>(*it->second);
+
+		auto pool = std::make_unique<SpringTweenPool<T>>();
+		pool->reserve(mInitialCapacity);
+		SpringTweenPool<T>& ref = *pool;
+		addPool(std::move(pool), std::type_index(typeid(SpringTween<T>)), RTTI_OF(T).get_name().to_string() + " (spring)");
+		return ref;
+	}
+
+
+	/**
+	 * Handle to a tween created by TweenService::createTweenAsync, can be used and destroyed on any thread.
+	 * Every call posts a request to the service, requests are executed in order at the start of the next update.
+	 * The tween itself is never accessed by the handle: the value of the tween is observed through its binding.
+	 * The handle must be destroyed before the service. The destroy request owns the id of the tween,
+	 * it is deleted with the request when the service shuts down before executing it.
+	 * @tparam T the value type to tween
+	 */
+	template<typename T>
+	class TweenAsyncHandle
+	{
+	public:
+		/**
+		 * Constructor
+		 * @param service the service that creates the tween
+		 * @param tween id of the tween once it's created, handed to the request that destroys the tween
+		 */
+		TweenAsyncHandle(TweenService& service, std::unique_ptr<TweenPlayID> tween) : mService(service), mTween(std::move(tween))		{ }
+
+		/**
+		 * Destructor, requests the tween to be destroyed at the start of the next update.
+		 * Until then the tween keeps writing to its bound memory: keep that memory alive,
+		 * or release it from a function posted to the service after the handle is destroyed.
+		 */
+		~TweenAsyncHandle();
+
+		/**
+		 * Handles are not copyable, a handle owns its tween
+		 */
+		TweenAsyncHandle(const TweenAsyncHandle&) = delete;
+		TweenAsyncHandle& operator=(const TweenAsyncHandle&) = delete;
+
+		/**
+		 * Requests the tween to tween from its current value to a new end value, see Tween::retarget()
+		 * @param endValue the new end value
+		 * @param duration duration of the tween from its current value to the end value, in seconds
+		 */
+		void retarget(const T& endValue, float duration);
+
+		/**
+		 * Requests the tween to write its value into the given memory location, see Tween::bind()
+		 * @param target the memory location to write to, written by the thread that updates the service.
+		 * Must stay valid until the tween is destroyed at the start of the update after the handle is destroyed.
+		 */
+		void bind(T* target);
+
+		/**
+		 * Requests the tween to restart, see Tween::restart()
+		 */
+		void restart();
+
+	private:
+		TweenService&					mService;		///< Service that owns the tween
+		std::unique_ptr<TweenPlayID>	mTween;			///< Id of the tween, only accessed by requests on the main thread
+	};
+
+
+	template<typename T>
+	TweenAsyncHandle<T>::~TweenAsyncHandle()
+	{
+		// the request owns the id, it's deleted with the request when the queue is destroyed before executing it
+		TweenService& service = mService;
+		mService.post([&service, tween = std::move(mTween)]()
+		{
+			service.kill(*tween);
+		});
+	}
+
+
+	template<typename T>
+	void TweenAsyncHandle<T>::retarget(const T& endValue, float duration)
+	{
+		TweenService& service = mService;
+		TweenPlayID* tween = mTween.get();
+		mService.post([&service, tween, endValue, duration]()
+		{
+			Tween<T>* target = service.template getTween<T>(*tween);
+			if (target != nullptr)
+				target->retarget(endValue, duration);
+		});
+	}
+
+
+	template<typename T>
+	void TweenAsyncHandle<T>::bind(T* target)
+	{
+		TweenService& service = mService;
+		TweenPlayID* tween = mTween.get();
+		mService.post([&service, tween, target]()
+		{
+			Tween<T>* owner = service.template getTween<T>(*tween);
+			if (owner != nullptr)
+				owner->bind(target);
+		});
+	}
+
+
+	template<typename T>
+	void TweenAsyncHandle<T>::restart()
+	{
+		TweenService& service = mService;
+		TweenPlayID* tween = mTween.get();
+		mService.post([&service, tween]()
+		{
+			Tween<T>* target = service.template getTween<T>(*tween);
+			if (target != nullptr)
+				target->restart();
+		});
+	}
+
+
+#ifdef NAP_TWEEN_COROUTINES
+
+	/**
+	 * A tween played by TweenService::tween() that a task awaits, the task continues when the tween completed.
+	 * Destroying the awaiter kills the tween, which happens when the awaiting task is stopped.
+	 * @tparam T the value type to tween
+	 */
+	template<typename T>
+	class TweenTaskTween
+	{
+	public:
+		/**
+		 * Constructor
+		 * @param service the service that plays the tween
+		 * @param id id of the tween, invalid when the tween completed right away
+		 * @param endValue the end value of the tween
+		 */
+		TweenTaskTween(TweenService& service, TweenPlayID id, const T& endValue) :
+			mService(&service), mID(id), mEndValue(endValue)					{ }
+
+		/**
+		 * Destructor, kills the tween when it still plays
+		 */
+		~TweenTaskTween()														{ if (mService != nullptr) mService->kill(mID); }
+
+		/**
+		 * The awaiter is move only, it owns the tween
+		 */
+		TweenTaskTween(TweenTaskTween&& other) noexcept;
+		TweenTaskTween(const TweenTaskTween&) = delete;
+		TweenTaskTween& operator=(const TweenTaskTween&) = delete;
+
+		/**
+		 * Writes the value of the tween into the given memory location, see Tween::bind()
+		 * @param target the memory location to write to
+		 * @return the awaiter
+		 */
+		TweenTaskTween bind(T* target) &&;
+
+		/**
+		 * Calls an accessor of an object with the value of the tween, see Tween::bind()
+		 * @param object the object to call the accessor on
+		 * @return the awaiter
+		 */
+		template<typename Object, void (Object::*Setter)(const T&)>
+		TweenTaskTween bind(Object& object) &&;
+
+		/**
+		 * @return id of the tween, to change or label it with the functions of the service
+		 */
+		TweenPlayID getID() const												{ return mID; }
+
+		bool await_ready() const												{ return !mService->isPlaying(mID); }
+		void await_suspend(std::coroutine_handle<TweenTask::promise_type> handle);
+		void await_resume() const noexcept										{ }
+
+	private:
+		TweenService*	mService = nullptr;		///< Service that plays the tween, nullptr when moved from
+		TweenPlayID		mID;					///< The tween
+		T				mEndValue;				///< Written to the binding when the tween completed right away
+	};
+
+
+	template<typename T>
+	TweenTaskTween<T> TweenService::tween(T startValue, T endValue, float duration, ETweenEaseType easeType)
+	{
+		// a tween without duration completes right away, the task continues without suspending
+		TweenPlayID id;
+		if (duration > 0.0f)
+		{
+			utility::ErrorState error;
+			id = play<T>(startValue, endValue, duration, error, easeType);
+		}
+		return TweenTaskTween<T>(*this, id, endValue);
+	}
+
+
+	template<typename T>
+	TweenTaskTween<T>::TweenTaskTween(TweenTaskTween&& other) noexcept :
+		mService(other.mService), mID(other.mID), mEndValue(other.mEndValue)
+	{
+		other.mService = nullptr;
+	}
+
+
+	template<typename T>
+	TweenTaskTween<T> TweenTaskTween<T>::bind(T* target) &&
+	{
+		Tween<T>* tween = mService->template getTween<T>(mID);
+		if (tween != nullptr)
+			tween->bind(target);
+		else
+			*target = mEndValue;
+		return std::move(*this);
+	}
+
+
+	template<typename T>
+	template<typename Object, void (Object::*Setter)(const T&)>
+	TweenTaskTween<T> TweenTaskTween<T>::bind(Object& object) &&
+	{
+		Tween<T>* tween = mService->template getTween<T>(mID);
+		if (tween != nullptr)
+			tween->template bind<Object, Setter>(object);
+		else
+			(object.*Setter)(mEndValue);
+		return std::move(*this);
+	}
+
+
+	template<typename T>
+	void TweenTaskTween<T>::await_suspend(std::coroutine_handle<TweenTask::promise_type> handle)
+	{
+		TweenTask::promise_type& promise = handle.promise();
+		promise.mScheduler->resumeAfter(*mID.mPool, mID.mID, promise.getResume());
+	}
+
+#endif // NAP_TWEEN_COROUTINES
 }
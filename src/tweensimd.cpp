@@ -0,0 +1,282 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+// Local Includes
+#include "tweensimd.h"
+#include "tweensimdkernels.h"
+
+// External Includes
+#include <atomic>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	#define NAP_TWEEN_X86
+	#include <emmintrin.h>
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+	#define NAP_TWEEN_NEON
+	#include <arm_neon.h>
+#endif
+
+namespace nap
+{
+	namespace simd
+	{
+		/**
+		 * Portable scalar instruction set, one lane
+		 */
+		struct Scalar
+		{
+			using Reg = float;
+			using Mask = bool;
+			static constexpr size_t width = 1;
+			static Reg load(const float* p)					{ return *p; }
+			static void store(float* p, Reg v)				{ *p = v; }
+			static Reg set(float v)							{ return v; }
+			static Reg add(Reg a, Reg b)					{ return a + b; }
+			static Reg sub(Reg a, Reg b)					{ return a - b; }
+			static Reg mul(Reg a, Reg b)					{ return a * b; }
+			static Reg div(Reg a, Reg b)					{ return a / b; }
+			static Reg madd(Reg a, Reg b, Reg c)			{ return a * b + c; }
+			static Reg min(Reg a, Reg b)					{ return a < b ? a : b; }
+			static Reg max(Reg a, Reg b)					{ return a > b ? a : b; }
+			static Reg sqrt(Reg a)							{ return std::sqrt(a); }
+			static Reg floor(Reg a)							{ return std::floor(a); }
+			static Reg pow2i(Reg n)							{ return std::ldexp(1.0f, static_cast<int>(n)); }
+			static Mask lt(Reg a, Reg b)					{ return a < b; }
+			static Mask eq(Reg a, Reg b)					{ return a == b; }
+			static Mask either(Mask a, Mask b)				{ return a || b; }
+			static Reg select(Mask m, Reg a, Reg b)			{ return m ? a : b; }
+		};
+
+#ifdef NAP_TWEEN_X86
+		/**
+		 * SSE2 instruction set, 4 lanes. Part of every x86-64 cpu
+		 */
+		struct SSE2
+		{
+			using Reg = __m128;
+			using Mask = __m128;
+			static constexpr size_t width = 4;
+			static Reg load(const float* p)					{ return _mm_loadu_ps(p); }
+			static void store(float* p, Reg v)				{ _mm_storeu_ps(p, v); }
+			static Reg set(float v)							{ return _mm_set1_ps(v); }
+			static Reg add(Reg a, Reg b)					{ return _mm_add_ps(a, b); }
+			static Reg sub(Reg a, Reg b)					{ return _mm_sub_ps(a, b); }
+			static Reg mul(Reg a, Reg b)					{ return _mm_mul_ps(a, b); }
+			static Reg div(Reg a, Reg b)					{ return _mm_div_ps(a, b); }
+			static Reg madd(Reg a, Reg b, Reg c)			{ return _mm_add_ps(_mm_mul_ps(a, b), c); }
+			static Reg min(Reg a, Reg b)					{ return _mm_min_ps(a, b); }
+			static Reg max(Reg a, Reg b)					{ return _mm_max_ps(a, b); }
+			static Reg sqrt(Reg a)							{ return _mm_sqrt_ps(a); }
+			static Mask lt(Reg a, Reg b)					{ return _mm_cmplt_ps(a, b); }
+			static Mask eq(Reg a, Reg b)					{ return _mm_cmpeq_ps(a, b); }
+			static Mask either(Mask a, Mask b)				{ return _mm_or_ps(a, b); }
+			static Reg select(Mask m, Reg a, Reg b)			{ return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+
+			static Reg floor(Reg a)
+			{
+				// truncate, subtract one where truncation rounded up
+				Reg t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+				return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a), _mm_set1_ps(1.0f)));
+			}
+
+			static Reg pow2i(Reg n)
+			{
+				__m128i e = _mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127));
+				return _mm_castsi128_ps(_mm_slli_epi32(e, 23));
+			}
+		};
+#endif // NAP_TWEEN_X86
+
+#ifdef NAP_TWEEN_NEON
+		/**
+		 * ARM NEON instruction set, 4 lanes. Part of every 64 bit ARM cpu
+		 */
+		struct NEON
+		{
+			using Reg = float32x4_t;
+			using Mask = uint32x4_t;
+			static constexpr size_t width = 4;
+			static Reg load(const float* p)					{ return vld1q_f32(p); }
+			static void store(float* p, Reg v)				{ vst1q_f32(p, v); }
+			static Reg set(float v)							{ return vdupq_n_f32(v); }
+			static Reg add(Reg a, Reg b)					{ return vaddq_f32(a, b); }
+			static Reg sub(Reg a, Reg b)					{ return vsubq_f32(a, b); }
+			static Reg mul(Reg a, Reg b)					{ return vmulq_f32(a, b); }
+			static Reg div(Reg a, Reg b)					{ return vdivq_f32(a, b); }
+			static Reg madd(Reg a, Reg b, Reg c)			{ return vfmaq_f32(c, a, b); }
+			static Reg min(Reg a, Reg b)					{ return vminq_f32(a, b); }
+			static Reg max(Reg a, Reg b)					{ return vmaxq_f32(a, b); }
+			static Reg sqrt(Reg a)							{ return vsqrtq_f32(a); }
+			static Reg floor(Reg a)							{ return vrndmq_f32(a); }
+			static Mask lt(Reg a, Reg b)					{ return vcltq_f32(a, b); }
+			static Mask eq(Reg a, Reg b)					{ return vceqq_f32(a, b); }
+			static Mask either(Mask a, Mask b)				{ return vorrq_u32(a, b); }
+			static Reg select(Mask m, Reg a, Reg b)			{ return vbslq_f32(m, a, b); }
+
+			static Reg pow2i(Reg n)
+			{
+				int32x4_t e = vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(127));
+				return vreinterpretq_f32_s32(vshlq_n_s32(e, 23));
+			}
+		};
+#endif // NAP_TWEEN_NEON
+	}
+
+
+	//////////////////////////////////////////////////////////////////////////
+	// Dispatch
+	//////////////////////////////////////////////////////////////////////////
+
+	static const TweenKernels& getScalarKernels()
+	{
+		static const TweenKernels kernels = simd::makeKernels<simd::Scalar>();
+		return kernels;
+	}
+
+
+	static const TweenKernels* getSIMDKernels(ETweenInstructionSet set)
+	{
+		switch (set)
+		{
+#ifdef NAP_TWEEN_X86
+		case ETweenInstructionSet::SSE2:
+		{
+			static const TweenKernels kernels = simd::makeKernels<simd::SSE2>();
+			return &kernels;
+		}
+		case ETweenInstructionSet::AVX2:
+		{
+			// requires os support for the avx register state and the fma extension
+			static const bool supported = []()
+			{
+	#if defined(_MSC_VER)
+				int info[4];
+				__cpuid(info, 1);
+				bool osxsave = (info[2] & (1 << 27)) != 0;
+				bool fma = (info[2] & (1 << 12)) != 0;
+				if (!osxsave || !fma || (_xgetbv(0) & 0x6) != 0x6)
+					return false;
+				__cpuidex(info, 7, 0);
+				return (info[1] & (1 << 5)) != 0;
+	#else
+				__builtin_cpu_init();
+				return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+	#endif
+			}();
+			return supported ? getTweenKernelsAVX2() : nullptr;
+		}
+#endif // NAP_TWEEN_X86
+#ifdef NAP_TWEEN_NEON
+		case ETweenInstructionSet::NEON:
+		{
+			static const TweenKernels kernels = simd::makeKernels<simd::NEON>();
+			return &kernels;
+		}
+#endif // NAP_TWEEN_NEON
+		case ETweenInstructionSet::Scalar:
+			return &getScalarKernels();
+		default:
+			return nullptr;
+		}
+	}
+
+
+	/**
+	 * Active instruction set and its kernels, selected on first use
+	 */
+	struct ActiveKernels
+	{
+		ActiveKernels()
+		{
+			for (auto set : { ETweenInstructionSet::AVX2, ETweenInstructionSet::SSE2, ETweenInstructionSet::NEON })
+			{
+				if (getSIMDKernels(set) != nullptr)
+				{
+					mSet = set;
+					break;
+				}
+			}
+			mKernels = getSIMDKernels(mSet);
+		}
+
+		std::atomic<ETweenInstructionSet>	mSet = { ETweenInstructionSet::Scalar };
+		std::atomic<const TweenKernels*>	mKernels = { nullptr };
+	};
+
+
+	static ActiveKernels& getActiveKernels()
+	{
+		static ActiveKernels active;
+		return active;
+	}
+
+
+	ETweenInstructionSet getTweenInstructionSet()
+	{
+		return getActiveKernels().mSet.load();
+	}
+
+
+	bool setTweenInstructionSet(ETweenInstructionSet set)
+	{
+		const TweenKernels* kernels = getSIMDKernels(set);
+		if (kernels == nullptr)
+			return false;
+
+		auto& active = getActiveKernels();
+		active.mKernels.store(kernels);
+		active.mSet.store(set);
+		return true;
+	}
+
+
+	bool isTweenInstructionSetSupported(ETweenInstructionSet set)
+	{
+		return getSIMDKernels(set) != nullptr;
+	}
+
+
+	void evaluateEaseBatch(ETweenEaseType easing, const float* progress, float* out, size_t count)
+	{
+		assert(static_cast<uint32>(easing) < tweenEaseCount);
+		getActiveKernels().mKernels.load(std::memory_order_relaxed)->mEase[easing](progress, out, count);
+	}
+
+
+	void lerpBatch(const float* start, const float* end, const float* progress, float* out, size_t count)
+	{
+		getActiveKernels().mKernels.load(std::memory_order_relaxed)->mLerp(start, end, progress, out, count, 1);
+	}
+
+
+	void lerpBatch(const glm::vec2* start, const glm::vec2* end, const float* progress, glm::vec2* out, size_t count)
+	{
+		static_assert(sizeof(glm::vec2) == sizeof(float) * 2, "glm::vec2 must be tightly packed");
+		getActiveKernels().mKernels.load(std::memory_order_relaxed)->mLerp(&start->x, &end->x, progress, &out->x, count, 2);
+	}
+
+
+	void lerpBatch(const glm::vec3* start, const glm::vec3* end, const float* progress, glm::vec3* out, size_t count)
+	{
+		static_assert(sizeof(glm::vec3) == sizeof(float) * 3, "glm::vec3 must be tightly packed");
+		getActiveKernels().mKernels.load(std::memory_order_relaxed)->mLerp(&start->x, &end->x, progress, &out->x, count, 3);
+	}
+
+
+	void lerpBatch(const glm::vec4* start, const glm::vec4* end, const float* progress, glm::vec4* out, size_t count)
+	{
+		static_assert(sizeof(glm::vec4) == sizeof(float) * 4, "glm::vec4 must be tightly packed");
+		getActiveKernels().mKernels.load(std::memory_order_relaxed)->mLerp(&start->x, &end->x, progress, &out->x, count, 4);
+	}
+
+
+	void lerpBatch(const float* start, const float* end, float progress, float* out, size_t count)
+	{
+		getActiveKernels().mKernels.load(std::memory_order_relaxed)->mMix(start, end, progress, out, count);
+	}
+}
@@ -0,0 +1,144 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// internal includes
+#include "tweeneasing.h"
+
+// external includes
+#include <mathutils.h>
+#include <cstddef>
+#include <type_traits>
+
+namespace nap
+{
+	/**
+	 * Instruction sets available to the batch tween kernels
+	 */
+	enum class ETweenInstructionSet : int
+	{
+		Scalar	= 0,		///< Portable scalar fallback
+		SSE2	= 1,		///< x86 SSE2, 4 lanes
+		AVX2	= 2,		///< x86 AVX2 + FMA, 8 lanes
+		NEON	= 3			///< ARM NEON, 4 lanes
+	};
+
+	/**
+	 * Maximum absolute error of the eased progress computed by the batch kernels, compared to the scalar ease tags in tweeneasing.h.
+	 * Near zero this allows a large error in ulp, see getTweenBatchMaxUlp() for the relative bound.
+	 */
+	constexpr float tweenBatchMaxError = 1e-6f;
+
+	/**
+	 * Smallest magnitude the ulp error of the batch eases is measured at.
+	 * Most eases subtract nearly equal values close to 0, for example 1 - cos(x) or 1 - (1 - p)^3,
+	 * their absolute error there doesn't shrink with the result. Below this magnitude the error is measured in ulp of the floor.
+	 */
+	constexpr float tweenBatchUlpFloor = 1.0f / 64.0f;
+
+	/**
+	 * Maximum error of the eased progress computed by the batch kernels, compared to the scalar ease tags in tweeneasing.h,
+	 * in ulp of max(|expected|, tweenBatchUlpFloor). Polynomial kernels only differ by fused multiply-add rounding,
+	 * the exponential and trigonometric kernels use their own approximations and the circ eases take the square root of a cancelling difference.
+	 * The bounds are about twice the largest error measured on a million progress values with every instruction set.
+	 * @param easing the ease type
+	 * @return maximum error in ulp
+	 */
+	constexpr uint32 getTweenBatchMaxUlp(ETweenEaseType easing)
+	{
+		switch (easing)
+		{
+		case ETweenEaseType::BACK_IN:
+		case ETweenEaseType::BACK_INOUT:
+		case ETweenEaseType::BACK_OUT:
+			return 128;
+		case ETweenEaseType::BOUNCE_IN:
+		case ETweenEaseType::BOUNCE_INOUT:
+		case ETweenEaseType::BOUNCE_OUT:
+			return 64;
+		case ETweenEaseType::CIRC_IN:
+		case ETweenEaseType::CIRC_INOUT:
+		case ETweenEaseType::CIRC_OUT:
+			return 1024;
+		case ETweenEaseType::ELASTIC_IN:
+		case ETweenEaseType::ELASTIC_INOUT:
+		case ETweenEaseType::ELASTIC_OUT:
+			return 128;
+		case ETweenEaseType::EXPO_IN:
+		case ETweenEaseType::EXPO_INOUT:
+		case ETweenEaseType::EXPO_OUT:
+		case ETweenEaseType::SINE_IN:
+		case ETweenEaseType::SINE_INOUT:
+		case ETweenEaseType::SINE_OUT:
+			return 64;
+		default:
+			return 32;
+		}
+	}
+
+	/**
+	 * Maximum error of the values interpolated by the batch lerp kernels, compared to progress * (end - start) + start,
+	 * in ulp of the largest of |start| and |end|. Only fused multiply-add rounding differs.
+	 */
+	constexpr uint32 tweenLerpBatchMaxUlp = 4;
+
+	/**
+	 * @return the instruction set used by the batch kernels, selected on first use based on the cpu
+	 */
+	NAPAPI ETweenInstructionSet getTweenInstructionSet();
+
+	/**
+	 * Forces the batch kernels to use the given instruction set, used to compare kernels
+	 * @param set the instruction set to use
+	 * @return false if the instruction set is not supported by this cpu or build
+	 */
+	NAPAPI bool setTweenInstructionSet(ETweenInstructionSet set);
+
+	/**
+	 * @param set the instruction set
+	 * @return if the instruction set is supported by this cpu and build
+	 */
+	NAPAPI bool isTweenInstructionSetSupported(ETweenInstructionSet set);
+
+	/**
+	 * Evaluates an ease for many progress values at once: out[i] = ease(progress[i])
+	 * @param easing the ease type
+	 * @param progress progress values ( 0 - 1 )
+	 * @param out eased progress values, may alias progress
+	 * @param count number of values
+	 */
+	NAPAPI void evaluateEaseBatch(ETweenEaseType easing, const float* progress, float* out, size_t count);
+
+	/**
+	 * Interpolates many values at once: out[i] = progress[i] * (end[i] - start[i]) + start[i]
+	 * @param start start values
+	 * @param end end values
+	 * @param progress eased progress values
+	 * @param out interpolated values, may alias start or end
+	 * @param count number of values
+	 */
+	NAPAPI void lerpBatch(const float* start, const float* end, const float* progress, float* out, size_t count);
+	NAPAPI void lerpBatch(const glm::vec2* start, const glm::vec2* end, const float* progress, glm::vec2* out, size_t count);
+	NAPAPI void lerpBatch(const glm::vec3* start, const glm::vec3* end, const float* progress, glm::vec3* out, size_t count);
+	NAPAPI void lerpBatch(const glm::vec4* start, const glm::vec4* end, const float* progress, glm::vec4* out, size_t count);
+
+	/**
+	 * Interpolates many values with the same progress: out[i] = progress * (end[i] - start[i]) + start[i]
+	 * @param start start values
+	 * @param end end values
+	 * @param progress eased progress shared by all values
+	 * @param out interpolated values, may alias start or end
+	 * @param count number of values
+	 */
+	NAPAPI void lerpBatch(const float* start, const float* end, float progress, float* out, size_t count);
+
+	/**
+	 * Value types that have a batch lerp kernel
+	 */
+	template<typename T>
+	constexpr bool hasTweenLerpBatch =
+		std::is_same<T, float>::value || std::is_same<T, glm::vec2>::value ||
+		std::is_same<T, glm::vec3>::value || std::is_same<T, glm::vec4>::value;
+}
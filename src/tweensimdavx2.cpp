@@ -0,0 +1,90 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+// Local Includes
+#include "tweeneasing.h"
+
+// External Includes
+#include <cstddef>
+
+#if defined(_M_X64) || defined(__x86_64__)
+
+// Everything that is shared with other translation units is included before the target is changed,
+// only the kernels are compiled for AVX2 and FMA. They are selected at runtime when the cpu supports them.
+#include <immintrin.h>
+
+#if defined(__clang__)
+	#pragma clang attribute push (__attribute__((target("avx2,fma"))), apply_to = function)
+#elif defined(__GNUC__)
+	#pragma GCC push_options
+	#pragma GCC target("avx2,fma")
+#endif
+
+// kernel templates must be compiled with the target above
+#include "tweensimdkernels.h"
+
+namespace nap
+{
+	namespace simd
+	{
+		/**
+		 * AVX2 + FMA instruction set, 8 lanes
+		 */
+		struct AVX2
+		{
+			using Reg = __m256;
+			using Mask = __m256;
+			static constexpr size_t width = 8;
+			static Reg load(const float* p)					{ return _mm256_loadu_ps(p); }
+			static void store(float* p, Reg v)				{ _mm256_storeu_ps(p, v); }
+			static Reg set(float v)							{ return _mm256_set1_ps(v); }
+			static Reg add(Reg a, Reg b)					{ return _mm256_add_ps(a, b); }
+			static Reg sub(Reg a, Reg b)					{ return _mm256_sub_ps(a, b); }
+			static Reg mul(Reg a, Reg b)					{ return _mm256_mul_ps(a, b); }
+			static Reg div(Reg a, Reg b)					{ return _mm256_div_ps(a, b); }
+			static Reg madd(Reg a, Reg b, Reg c)			{ return _mm256_fmadd_ps(a, b, c); }
+			static Reg min(Reg a, Reg b)					{ return _mm256_min_ps(a, b); }
+			static Reg max(Reg a, Reg b)					{ return _mm256_max_ps(a, b); }
+			static Reg sqrt(Reg a)							{ return _mm256_sqrt_ps(a); }
+			static Reg floor(Reg a)							{ return _mm256_floor_ps(a); }
+			static Mask lt(Reg a, Reg b)					{ return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+			static Mask eq(Reg a, Reg b)					{ return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+			static Mask either(Mask a, Mask b)				{ return _mm256_or_ps(a, b); }
+			static Reg select(Mask m, Reg a, Reg b)			{ return _mm256_blendv_ps(b, a, m); }
+
+			static Reg pow2i(Reg n)
+			{
+				__m256i e = _mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127));
+				return _mm256_castsi256_ps(_mm256_slli_epi32(e, 23));
+			}
+		};
+	}
+
+
+	const TweenKernels* getTweenKernelsAVX2()
+	{
+		static const TweenKernels kernels = simd::makeKernels<simd::AVX2>();
+		return &kernels;
+	}
+}
+
+#if defined(__clang__)
+	#pragma clang attribute pop
+#elif defined(__GNUC__)
+	#pragma GCC pop_options
+#endif
+
+#else
+
+#include "tweensimdkernels.h"
+
+namespace nap
+{
+	const TweenKernels* getTweenKernelsAVX2()
+	{
+		return nullptr;
+	}
+}
+
+#endif
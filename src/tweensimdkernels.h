@@ -0,0 +1,474 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// internal includes
+#include "tweeneasing.h"
+
+// external includes
+#include <cstddef>
+
+/**
+ * Instruction set independent batch kernels, included by every instruction set specific translation unit.
+ * Every translation unit defines an instruction set type I that exposes a register type and its operations,
+ * the kernels below are instantiated once per instruction set with that type.
+ * Nothing in this file may be included by public headers: the kernels are compiled with different target options.
+ */
+/**
+ * Kernel helpers pass registers by value, they are always inlined into the batch kernels:
+ * out of line calls would depend on the calling convention of registers in code compiled for another target
+ */
+#if defined(_MSC_VER)
+	#define NAP_TWEEN_SIMD_INLINE __forceinline
+#else
+	#define NAP_TWEEN_SIMD_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace nap
+{
+	/**
+	 * Batch ease evaluation kernel: out[i] = ease(progress[i])
+	 */
+	using TweenEaseKernel = void(*)(const float* progress, float* out, size_t count);
+
+	/**
+	 * Batch lerp kernel: out[i] = progress[i] * (end[i] - start[i]) + start[i], for values with the given number of components
+	 */
+	using TweenLerpKernel = void(*)(const float* start, const float* end, const float* progress, float* out, size_t count, size_t components);
+
+	/**
+	 * Batch lerp kernel with one progress for all values: out[i] = progress * (end[i] - start[i]) + start[i]
+	 */
+	using TweenMixKernel = void(*)(const float* start, const float* end, float progress, float* out, size_t count);
+
+	/**
+	 * All kernels of one instruction set
+	 */
+	struct TweenKernels
+	{
+		TweenEaseKernel mEase[tweenEaseCount];		///< Ease kernel, indexed by ease type
+		TweenLerpKernel mLerp;						///< Lerp kernel
+		TweenMixKernel	mMix;						///< Lerp kernel with one progress for all values
+	};
+
+	/**
+	 * @return AVX2 + FMA kernels, nullptr when not available for this compiler or platform
+	 */
+	const TweenKernels* getTweenKernelsAVX2();
+
+	namespace simd
+	{
+		/**
+		 * Register wrapper that gives the instruction set operations arithmetic operators
+		 */
+		template<typename I>
+		struct Float
+		{
+			typename I::Reg r;
+			NAP_TWEEN_SIMD_INLINE static Float load(const float* p)		{ return { I::load(p) }; }
+			NAP_TWEEN_SIMD_INLINE static Float set(float v)				{ return { I::set(v) }; }
+			NAP_TWEEN_SIMD_INLINE void store(float* p) const			{ I::store(p, r); }
+		};
+
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> operator+(Float<I> a, Float<I> b)		{ return { I::add(a.r, b.r) }; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> operator-(Float<I> a, Float<I> b)		{ return { I::sub(a.r, b.r) }; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> operator*(Float<I> a, Float<I> b)		{ return { I::mul(a.r, b.r) }; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> operator/(Float<I> a, Float<I> b)		{ return { I::div(a.r, b.r) }; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> operator+(Float<I> a, float b)			{ return { I::add(a.r, I::set(b)) }; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> operator-(Float<I> a, float b)			{ return { I::sub(a.r, I::set(b)) }; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> operator*(Float<I> a, float b)			{ return { I::mul(a.r, I::set(b)) }; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> operator/(Float<I> a, float b)			{ return { I::div(a.r, I::set(b)) }; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> operator+(float a, Float<I> b)			{ return { I::add(I::set(a), b.r) }; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> operator-(float a, Float<I> b)			{ return { I::sub(I::set(a), b.r) }; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> operator*(float a, Float<I> b)			{ return { I::mul(I::set(a), b.r) }; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> operator-(Float<I> a)					{ return { I::sub(I::set(0.0f), a.r) }; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE typename I::Mask operator<(Float<I> a, float b)	{ return I::lt(a.r, I::set(b)); }
+		template<typename I> NAP_TWEEN_SIMD_INLINE typename I::Mask operator==(Float<I> a, float b)	{ return I::eq(a.r, I::set(b)); }
+
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> madd(Float<I> a, Float<I> b, Float<I> c)				{ return { I::madd(a.r, b.r, c.r) }; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> min(Float<I> a, float b)								{ return { I::min(a.r, I::set(b)) }; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> max(Float<I> a, float b)								{ return { I::max(a.r, I::set(b)) }; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> sqrt(Float<I> a)										{ return { I::sqrt(a.r) }; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> floor(Float<I> a)										{ return { I::floor(a.r) }; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> select(typename I::Mask m, Float<I> a, Float<I> b)	{ return { I::select(m, a.r, b.r) }; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE typename I::Mask either(typename I::Mask a, typename I::Mask b)	{ return I::either(a, b); }
+
+
+		//////////////////////////////////////////////////////////////////////////
+		// Math
+		//////////////////////////////////////////////////////////////////////////
+
+		/**
+		 * 2^x, x is clamped to [-126, 126]. Cephes polynomial, max error 2 ulp
+		 */
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> exp2(Float<I> x)
+		{
+			x = min(max(x, -126.0f), 126.0f);
+			Float<I> n = floor(x + 0.5f);
+			Float<I> f = x - n;
+
+			Float<I> p = Float<I>::set(1.535336188319500e-4f);
+			p = madd(p, f, Float<I>::set(1.339887440266574e-3f));
+			p = madd(p, f, Float<I>::set(9.618437357674640e-3f));
+			p = madd(p, f, Float<I>::set(5.550332471162809e-2f));
+			p = madd(p, f, Float<I>::set(2.402264791363012e-1f));
+			p = madd(p, f, Float<I>::set(6.931472028550421e-1f));
+			p = madd(p, f, Float<I>::set(1.0f));
+			return p * Float<I>{ I::pow2i(n.r) };
+		}
+
+		/**
+		 * sin(x) for |x| < 8192, Cody-Waite reduction to [-pi/4, pi/4] followed by the Cephes polynomials.
+		 * @param quadrant offset in quarter turns, 1 evaluates cos(x)
+		 */
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> sin(Float<I> x, float quadrant = 0.0f)
+		{
+			// quadrant and reduced argument
+			Float<I> q = floor(x * 0.636619772367581f + 0.5f);
+			Float<I> r = x - q * 1.5703125f;
+			r = r - q * 4.837512969970703125e-4f;
+			r = r - q * 7.54978995489188216e-8f;
+			q = q + quadrant;
+
+			// quadrant modulo 4
+			Float<I> k = q - floor(q * 0.25f) * 4.0f;
+			Float<I> r2 = r * r;
+
+			Float<I> s = Float<I>::set(-1.9515295891e-4f);
+			s = madd(s, r2, Float<I>::set(8.3321608736e-3f));
+			s = madd(s, r2, Float<I>::set(-1.6666654611e-1f));
+			s = madd(s * r2, r, r);
+
+			Float<I> c = Float<I>::set(2.443315711809948e-5f);
+			c = madd(c, r2, Float<I>::set(-1.388731625493765e-3f));
+			c = madd(c, r2, Float<I>::set(4.166664568298827e-2f));
+			c = madd(c * r2, r2, 1.0f - r2 * 0.5f);
+
+			// odd quadrants use the cosine, the upper two are negated
+			Float<I> odd = k - floor(k * 0.5f) * 2.0f;
+			Float<I> result = select(odd == 1.0f, c, s);
+			return select(k < 1.5f, result, -result);
+		}
+
+
+		//////////////////////////////////////////////////////////////////////////
+		// Eases, mirror the scalar tags in tweeneasing.h
+		//////////////////////////////////////////////////////////////////////////
+
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseLinear, Float<I> p)			{ return p; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInCubic, Float<I> p)		{ return p * p * p; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseOutCubic, Float<I> p)		{ Float<I> t = p - 1.0f; return t * t * t + 1.0f; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInQuad, Float<I> p)			{ return p * p; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseOutQuad, Float<I> p)		{ return -p * (p - 2.0f); }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInQuart, Float<I> p)		{ return p * p * p * p; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseOutQuart, Float<I> p)		{ Float<I> t = p - 1.0f; return -(t * t * t * t - 1.0f); }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInQuint, Float<I> p)		{ return p * p * p * p * p; }
+		template<typename I> NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseOutQuint, Float<I> p)		{ Float<I> t = p - 1.0f; return t * t * t * t * t + 1.0f; }
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInOutCubic, Float<I> p)
+		{
+			Float<I> t = p * 2.0f;
+			Float<I> u = t - 2.0f;
+			return select(t < 1.0f, 0.5f * t * t * t, 0.5f * (u * u * u + 2.0f));
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInOutQuad, Float<I> p)
+		{
+			Float<I> t = p * 2.0f;
+			Float<I> u = t - 1.0f;
+			return select(t < 1.0f, 0.5f * t * t, -0.5f * ((u - 2.0f) * u - 1.0f));
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInOutQuart, Float<I> p)
+		{
+			Float<I> t = p * 2.0f;
+			Float<I> u = t - 2.0f;
+			return select(t < 1.0f, 0.5f * t * t * t * t, -0.5f * (u * u * u * u - 2.0f));
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInOutQuint, Float<I> p)
+		{
+			Float<I> t = p * 2.0f;
+			Float<I> u = t - 2.0f;
+			return select(t < 1.0f, 0.5f * t * t * t * t * t, 0.5f * (u * u * u * u * u + 2.0f));
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInBack, Float<I> p)
+		{
+			constexpr float s = 1.70158f;
+			return p * p * ((s + 1.0f) * p - s);
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseOutBack, Float<I> p)
+		{
+			constexpr float s = 1.70158f;
+			Float<I> t = p - 1.0f;
+			return t * t * ((s + 1.0f) * t + s) + 1.0f;
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInOutBack, Float<I> p)
+		{
+			constexpr float s = 1.70158f * 1.525f;
+			Float<I> t = p * 2.0f;
+			Float<I> u = t - 2.0f;
+			return select(t < 1.0f, 0.5f * (t * t * ((s + 1.0f) * t - s)), 0.5f * (u * u * ((s + 1.0f) * u + s) + 2.0f));
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseOutBounce, Float<I> p)
+		{
+			// select the parabola, then evaluate it once
+			auto a = p < (1.0f / 2.75f);
+			auto b = p < (2.0f / 2.75f);
+			auto c = p < (2.5f / 2.75f);
+			Float<I> offset = select(a, Float<I>::set(0.0f), select(b, Float<I>::set(1.5f / 2.75f), select(c, Float<I>::set(2.25f / 2.75f), Float<I>::set(2.625f / 2.75f))));
+			Float<I> add = select(a, Float<I>::set(0.0f), select(b, Float<I>::set(0.75f), select(c, Float<I>::set(0.9375f), Float<I>::set(0.984375f))));
+			Float<I> t = p - offset;
+			return 7.5625f * t * t + add;
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInBounce, Float<I> p)
+		{
+			return 1.0f - ease(EaseOutBounce(), 1.0f - p);
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInOutBounce, Float<I> p)
+		{
+			Float<I> in = ease(EaseInBounce(), p * 2.0f) * 0.5f;
+			Float<I> out = ease(EaseOutBounce(), p * 2.0f - 1.0f) * 0.5f + 0.5f;
+			return select(p < 0.5f, in, out);
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInCirc, Float<I> p)
+		{
+			return -(sqrt(1.0f - p * p) - 1.0f);
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseOutCirc, Float<I> p)
+		{
+			Float<I> t = p - 1.0f;
+			return sqrt(1.0f - t * t);
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInOutCirc, Float<I> p)
+		{
+			Float<I> t = p * 2.0f;
+			Float<I> u = select(t < 1.0f, t, t - 2.0f);
+			Float<I> root = sqrt(max(1.0f - u * u, 0.0f));
+			return select(t < 1.0f, -0.5f * (root - 1.0f), 0.5f * (root + 1.0f));
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInElastic, Float<I> p)
+		{
+			constexpr float period = 0.3f;
+			constexpr float s = period / 4.0f;
+			Float<I> t = p - 1.0f;
+			Float<I> result = -(exp2(10.0f * t) * sin((t - s) * (2.0f * tweenPi) / period));
+			return select(either<I>(p == 0.0f, p == 1.0f), p, result);
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseOutElastic, Float<I> p)
+		{
+			constexpr float period = 0.3f;
+			constexpr float s = period / 4.0f;
+			Float<I> result = exp2(-10.0f * p) * sin((p - s) * (2.0f * tweenPi) / period) + 1.0f;
+			return select(either<I>(p == 0.0f, p == 1.0f), p, result);
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInOutElastic, Float<I> p)
+		{
+			constexpr float period = 0.3f * 1.5f;
+			constexpr float s = period / 4.0f;
+			Float<I> t = p * 2.0f - 1.0f;
+			auto first = t < 0.0f;
+			Float<I> e = exp2(select(first, 10.0f * t, -10.0f * t));
+			Float<I> wave = sin((t - s) * (2.0f * tweenPi) / period);
+			Float<I> result = select(first, -0.5f * (e * wave), e * wave * 0.5f + 1.0f);
+			return select(either<I>(p == 0.0f, p == 1.0f), p, result);
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInExpo, Float<I> p)
+		{
+			return select(p == 0.0f, Float<I>::set(0.0f), exp2(10.0f * (p - 1.0f)));
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseOutExpo, Float<I> p)
+		{
+			return select(p == 1.0f, Float<I>::set(1.0f), 1.0f - exp2(-10.0f * p));
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInOutExpo, Float<I> p)
+		{
+			Float<I> t = p * 2.0f;
+			auto first = t < 1.0f;
+			Float<I> e = exp2(select(first, 10.0f * (t - 1.0f), -10.0f * (t - 1.0f)));
+			Float<I> result = select(first, 0.5f * e, 0.5f * (2.0f - e));
+			return select(either<I>(p == 0.0f, p == 1.0f), p, result);
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInSine, Float<I> p)
+		{
+			return 1.0f - sin(p * (tweenPi * 0.5f), 1.0f);
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseOutSine, Float<I> p)
+		{
+			return sin(p * (tweenPi * 0.5f));
+		}
+
+		template<typename I>
+		NAP_TWEEN_SIMD_INLINE Float<I> ease(EaseInOutSine, Float<I> p)
+		{
+			return -0.5f * (sin(tweenPi * p, 1.0f) - 1.0f);
+		}
+
+
+		//////////////////////////////////////////////////////////////////////////
+		// Batch kernels
+		//////////////////////////////////////////////////////////////////////////
+
+		/**
+		 * Evaluates the ease for count values, the tail is padded so every value takes the same path
+		 */
+		template<typename I, typename Ease>
+		void easeBatch(const float* progress, float* out, size_t count)
+		{
+			size_t i = 0;
+			for (; i + I::width <= count; i += I::width)
+				ease(Ease(), Float<I>::load(progress + i)).store(out + i);
+
+			if (i < count)
+			{
+				float in_tail[I::width] = { };
+				float out_tail[I::width];
+				for (size_t j = 0; i + j < count; j++)
+					in_tail[j] = progress[i + j];
+				ease(Ease(), Float<I>::load(in_tail)).store(out_tail);
+				for (size_t j = 0; i + j < count; j++)
+					out[i + j] = out_tail[j];
+			}
+		}
+
+		/**
+		 * Lerps count values of the given number of components.
+		 * Progress is expanded per component in blocks, the lerp runs over the flattened components
+		 */
+		template<typename I>
+		void lerpBatch(const float* start, const float* end, const float* progress, float* out, size_t count, size_t components)
+		{
+			constexpr size_t block = 256;
+			float expanded[block * 4];
+
+			for (size_t first = 0; first < count; first += block)
+			{
+				size_t elements = count - first < block ? count - first : block;
+				size_t floats = elements * components;
+				const float* t = progress + first;
+				if (components > 1)
+				{
+					for (size_t e = 0; e < elements; e++)
+						for (size_t c = 0; c < components; c++)
+							expanded[e * components + c] = progress[first + e];
+					t = expanded;
+				}
+
+				const float* a = start + first * components;
+				const float* b = end + first * components;
+				float* o = out + first * components;
+
+				size_t i = 0;
+				for (; i + I::width <= floats; i += I::width)
+				{
+					Float<I> va = Float<I>::load(a + i);
+					madd(Float<I>::load(t + i), Float<I>::load(b + i) - va, va).store(o + i);
+				}
+				for (; i < floats; i++)
+					o[i] = t[i] * (b[i] - a[i]) + a[i];
+			}
+		}
+
+		/**
+		 * Lerps count floats with the same progress, the progress is broadcast once
+		 */
+		template<typename I>
+		void mixBatch(const float* start, const float* end, float progress, float* out, size_t count)
+		{
+			Float<I> t = Float<I>::set(progress);
+			size_t i = 0;
+			for (; i + I::width <= count; i += I::width)
+			{
+				Float<I> va = Float<I>::load(start + i);
+				madd(t, Float<I>::load(end + i) - va, va).store(out + i);
+			}
+			for (; i < count; i++)
+				out[i] = progress * (end[i] - start[i]) + start[i];
+		}
+
+		/**
+		 * @return all kernels of instruction set I
+		 */
+		template<typename I>
+		TweenKernels makeKernels()
+		{
+			TweenKernels kernels;
+			kernels.mEase[EaseLinear::type] 		= &easeBatch<I, EaseLinear>;
+			kernels.mEase[EaseInCubic::type] 		= &easeBatch<I, EaseInCubic>;
+			kernels.mEase[EaseInOutCubic::type] 	= &easeBatch<I, EaseInOutCubic>;
+			kernels.mEase[EaseOutCubic::type] 		= &easeBatch<I, EaseOutCubic>;
+			kernels.mEase[EaseInBack::type] 		= &easeBatch<I, EaseInBack>;
+			kernels.mEase[EaseInOutBack::type] 		= &easeBatch<I, EaseInOutBack>;
+			kernels.mEase[EaseOutBack::type] 		= &easeBatch<I, EaseOutBack>;
+			kernels.mEase[EaseInBounce::type] 		= &easeBatch<I, EaseInBounce>;
+			kernels.mEase[EaseInOutBounce::type] 	= &easeBatch<I, EaseInOutBounce>;
+			kernels.mEase[EaseOutBounce::type] 		= &easeBatch<I, EaseOutBounce>;
+			kernels.mEase[EaseInCirc::type] 		= &easeBatch<I, EaseInCirc>;
+			kernels.mEase[EaseInOutCirc::type] 		= &easeBatch<I, EaseInOutCirc>;
+			kernels.mEase[EaseOutCirc::type] 		= &easeBatch<I, EaseOutCirc>;
+			kernels.mEase[EaseInElastic::type] 		= &easeBatch<I, EaseInElastic>;
+			kernels.mEase[EaseInOutElastic::type] 	= &easeBatch<I, EaseInOutElastic>;
+			kernels.mEase[EaseOutElastic::type] 	= &easeBatch<I, EaseOutElastic>;
+			kernels.mEase[EaseInExpo::type] 		= &easeBatch<I, EaseInExpo>;
+			kernels.mEase[EaseInOutExpo::type] 		= &easeBatch<I, EaseInOutExpo>;
+			kernels.mEase[EaseOutExpo::type] 		= &easeBatch<I, EaseOutExpo>;
+			kernels.mEase[EaseInQuad::type] 		= &easeBatch<I, EaseInQuad>;
+			kernels.mEase[EaseInOutQuad::type] 		= &easeBatch<I, EaseInOutQuad>;
+			kernels.mEase[EaseOutQuad::type] 		= &easeBatch<I, EaseOutQuad>;
+			kernels.mEase[EaseInQuart::type] 		= &easeBatch<I, EaseInQuart>;
+			kernels.mEase[EaseInOutQuart::type] 	= &easeBatch<I, EaseInOutQuart>;
+			kernels.mEase[EaseOutQuart::type] 		= &easeBatch<I, EaseOutQuart>;
+			kernels.mEase[EaseInQuint::type] 		= &easeBatch<I, EaseInQuint>;
+			kernels.mEase[EaseInOutQuint::type] 	= &easeBatch<I, EaseInOutQuint>;
+			kernels.mEase[EaseOutQuint::type] 		= &easeBatch<I, EaseOutQuint>;
+			kernels.mEase[EaseInSine::type] 		= &easeBatch<I, EaseInSine>;
+			kernels.mEase[EaseInOutSine::type] 		= &easeBatch<I, EaseInOutSine>;
+			kernels.mEase[EaseOutSine::type] 		= &easeBatch<I, EaseOutSine>;
+			kernels.mLerp = &lerpBatch<I>;
+			kernels.mMix = &mixBatch<I>;
+			return kernels;
+		}
+	}
+}
@@ -0,0 +1,293 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// internal includes
+#include "tween.h"
+#include "tweenspringpool.h"
+
+// external includes
+#include <mathutils.h>
+#include <nap/signalslot.h>
+
+namespace nap
+{
+	//////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * A SpringTween follows a target with the motion of a damped spring instead of a fixed duration and ease.
+	 * Change the target at any time with setTarget(), the spring continues from its current value and velocity without allocating.
+	 * The spring is parameterized by its natural frequency in Hz, which sets how fast it responds,
+	 * and its damping ratio: 1 is critically damped and arrives as fast as possible without overshooting,
+	 * below 1 overshoots and oscillates, above 1 approaches the target slower.
+	 * Every update the spring is advanced with the exact solution of the spring over the time step,
+	 * the motion is the same for any frame rate and never becomes unstable.
+	 * Once the spring is within epsilon of its target and almost at rest it snaps to the target and sleeps,
+	 * a settled spring costs nothing to update until its target changes.
+	 * A SpringTween can be created by the user, call update() to advance it,
+	 * or by the TweenService with createSpring<T>, the service updates it and returns a SpringTweenHandle.
+	 * The state of the spring is stored in a SpringTweenPool, the SpringTween is a view onto its slot in that pool
+	 * @tparam T the type of value that you would like to tween: float, double or a glm vector
+	 */
+	template<typename T>
+	class SpringTween : public TweenBase
+	{
+		friend class SpringTweenPool<T>;
+		friend class TweenSignal<T, SpringTween<T>>;
+	public:
+		/**
+		 * Constructor of a spring that is managed by the user, call update() to advance it
+		 * @param value the initial value and target, the spring starts at rest
+		 * @param frequency natural frequency in Hz, must be greater than 0
+		 * @param damping damping ratio, must be greater than 0
+		 */
+		SpringTween(T value, float frequency, float damping);
+
+		/**
+		 * update function, only available when the spring is managed by the user
+		 * @param deltaTime time in seconds since last update
+		 */
+		void update(double deltaTime);
+
+		/**
+		 * Changes the target, the spring continues from its current value and velocity and wakes when it settled
+		 * @param target the new target
+		 */
+		void setTarget(const T& target);
+
+		/**
+		 * @return the target the spring moves to
+		 */
+		const T& getTarget() const							{ return mPool->mTarget[index()]; }
+
+		/**
+		 * Moves the spring to the given value, keeps its velocity and wakes it
+		 * @param value the new value
+		 */
+		void setValue(const T& value);
+
+		/**
+		 * @return current value of the spring
+		 */
+		const T& getCurrentValue() const					{ return mPool->mValue[index()]; }
+
+		/**
+		 * Changes the velocity of the spring, for example to give it a kick, and wakes it
+		 * @param velocity the new velocity per second
+		 */
+		void setVelocity(const T& velocity);
+
+		/**
+		 * @return current velocity of the spring per second
+		 */
+		const T& getVelocity() const						{ return mPool->mVelocity[index()]; }
+
+		/**
+		 * @param frequency natural frequency in Hz, must be greater than 0
+		 */
+		void setFrequency(float frequency);
+
+		/**
+		 * @return natural frequency in Hz
+		 */
+		float getFrequency() const							{ return mPool->mFrequency[index()]; }
+
+		/**
+		 * @param damping damping ratio, must be greater than 0
+		 */
+		void setDamping(float damping);
+
+		/**
+		 * @return damping ratio
+		 */
+		float getDamping() const							{ return mPool->mDamping[index()]; }
+
+		/**
+		 * Sets the distance to the target below which the spring settles, applies to every component of the value.
+		 * The velocity must also drop below epsilon times the angular frequency of the spring, 2 * pi * frequency.
+		 * @param epsilon the distance, 0.001 by default
+		 */
+		void setEpsilon(float epsilon);
+
+		/**
+		 * @return distance to the target below which the spring settles
+		 */
+		float getEpsilon() const							{ return mPool->mEpsilon[index()]; }
+
+		/**
+		 * @return if the spring settled at its target, a settled spring costs nothing to update
+		 */
+		bool isSettled() const								{ return (mPool->mFlags[index()] & SpringTweenPool<T>::EFlags::Sleeping) != 0; }
+
+		/**
+		 * Writes the value of the spring into the given memory location every update, without dispatching a signal.
+		 * The target must outlive the spring or be unbound. Destroying the handle of the spring unbinds it.
+		 * When the service updates in parallel, the target is written on a worker thread.
+		 * @param target the memory location to write to
+		 */
+		void bind(T* target);
+
+		/**
+		 * Calls an accessor of an object with the value of the spring every update, without dispatching a signal.
+		 * For example: spring.bind<TransformComponentInstance, &TransformComponentInstance::setTranslate>(transform)
+		 * The object must outlive the spring or be unbound. Destroying the handle of the spring unbinds it.
+		 * @param object the object to call the accessor on
+		 * @tparam Object the type of object
+		 * @tparam Setter the member function that receives the value
+		 */
+		template<typename Object, void (Object::*Setter)(const T&)>
+		void bind(Object& object);
+
+		/**
+		 * Removes the output binding of the spring
+		 */
+		void unbind()										{ mPool->unbind(mID); }
+
+		/**
+		 * @return if the output of the spring is bound
+		 */
+		bool isBound() const								{ return mPool->mBindings[index()].mTarget != nullptr; }
+
+		/**
+		 * Moves the spring to a group, the spring follows the time scale and paused state of the group from now on.
+		 * The group must be created by the service that created the spring.
+		 * @param group the group, nullptr to follow the clock of the service
+		 */
+		void setGroup(const TweenGroup* group)				{ mPool->setGroup(mID.mSlot, group); }
+	public:
+		// Signals
+
+		/**
+		 * Update signal dispatched every update while the spring moves
+		 * Occurs on main thread
+		 */
+		TweenSignal<T, SpringTween<T>> UpdateSignal { *this };
+
+		/**
+		 * Settled signal dispatched when the spring settles at its target
+		 * Always dispatched on main thread
+		 */
+		TweenSignal<T, SpringTween<T>> SettledSignal { *this };
+	protected:
+		/**
+		 * Constructor used by the pool
+		 * @param pool the pool that owns this spring
+		 */
+		SpringTween(SpringTweenPool<T>& pool) : TweenBase(), mPool(&pool)	{ }
+	private:
+		/**
+		 * @return index of the spring in the pool
+		 */
+		uint32 index() const								{ return mPool->mSlots[mID.mSlot].mIndex; }
+
+		/**
+		 * Called when a handler connects to one of the signals, from now on the pool records events for this spring
+		 */
+		void listen(const TweenSignal<T, SpringTween<T>>&)		{ mPool->listen(mID.mSlot); }
+
+		// pool the spring state is stored in
+		SpringTweenPool<T>* 					mPool = nullptr;
+
+		// pool owned by this spring when managed by the user
+		std::unique_ptr<SpringTweenPool<T>> 	mOwnedPool = nullptr;
+	};
+
+
+	//////////////////////////////////////////////////////////////////////////
+	// Declarations
+	//////////////////////////////////////////////////////////////////////////
+	using SpringTweenFloat = SpringTween<float>;
+	using SpringTweenVec2 = SpringTween<glm::vec2>;
+	using SpringTweenVec3 = SpringTween<glm::vec3>;
+
+
+	//////////////////////////////////////////////////////////////////////////
+	// Template Definitions
+	//////////////////////////////////////////////////////////////////////////
+
+	template<typename T>
+	SpringTween<T>::SpringTween(T value, float frequency, float damping)
+		: TweenBase(), mOwnedPool(std::make_unique<SpringTweenPool<T>>())
+	{
+		mPool = mOwnedPool.get();
+		mID = mPool->add(this, value, frequency, damping);
+	}
+
+
+	template<typename T>
+	void SpringTween<T>::update(double deltaTime)
+	{
+		assert(mOwnedPool != nullptr); // spring is updated by the service
+		mOwnedPool->update(deltaTime);
+	}
+
+
+	template<typename T>
+	void SpringTween<T>::setTarget(const T& target)
+	{
+		mPool->mTarget[index()] = target;
+		mPool->wake(mID.mSlot);
+	}
+
+
+	template<typename T>
+	void SpringTween<T>::setValue(const T& value)
+	{
+		mPool->mValue[index()] = value;
+		mPool->wake(mID.mSlot);
+	}
+
+
+	template<typename T>
+	void SpringTween<T>::setVelocity(const T& velocity)
+	{
+		mPool->mVelocity[index()] = velocity;
+		mPool->wake(mID.mSlot);
+	}
+
+
+	template<typename T>
+	void SpringTween<T>::setFrequency(float frequency)
+	{
+		assert(frequency > 0.0f); // spring never moves
+		mPool->mFrequency[index()] = frequency;
+	}
+
+
+	template<typename T>
+	void SpringTween<T>::setDamping(float damping)
+	{
+		assert(damping > 0.0f); // spring never settles
+		mPool->mDamping[index()] = damping;
+	}
+
+
+	template<typename T>
+	void SpringTween<T>::setEpsilon(float epsilon)
+	{
+		assert(epsilon >= 0.0f); // invalid epsilon
+		mPool->mEpsilon[index()] = epsilon;
+	}
+
+
+	template<typename T>
+	void SpringTween<T>::bind(T* target)
+	{
+		TweenBinding<T> binding;
+		binding.mTarget = target;
+		mPool->bind(mID, binding);
+	}
+
+
+	template<typename T>
+	template<typename Object, void (Object::*Setter)(const T&)>
+	void SpringTween<T>::bind(Object& object)
+	{
+		TweenBinding<T> binding;
+		binding.mTarget = &object;
+		binding.mSetter = [](void* target, const T& value) { (static_cast<Object*>(target)->*Setter)(value); };
+		mPool->bind(mID, binding);
+	}
+}
@@ -0,0 +1,59 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "tweenspringpool.h"
+
+// external includes
+#include <cmath>
+
+namespace nap
+{
+	TweenSpringStep TweenSpringStep::solve(float frequency, float damping, float time)
+	{
+		// solved in double precision, the exponentials of stiff springs and large steps lose accuracy in float
+		double omega = 2.0 * tweenPi * frequency;
+		double zeta = damping;
+		double t = time;
+		TweenSpringStep step;
+
+		if (std::abs(zeta - 1.0) < 1e-4)
+		{
+			// critically damped: offset = (a + b * t) * e^(-omega * t)
+			double e = std::exp(-omega * t);
+			step.mOffset 			= static_cast<float>((1.0 + omega * t) * e);
+			step.mOffsetVelocity 	= static_cast<float>(t * e);
+			step.mVelocityOffset 	= static_cast<float>(-omega * omega * t * e);
+			step.mVelocity 			= static_cast<float>((1.0 - omega * t) * e);
+		}
+		else if (zeta < 1.0)
+		{
+			// under damped: oscillates at the damped frequency while it decays
+			double alpha = zeta * omega;
+			double beta = omega * std::sqrt(1.0 - zeta * zeta);
+			double e = std::exp(-alpha * t);
+			double c = std::cos(beta * t);
+			double s = std::sin(beta * t);
+			step.mOffset 			= static_cast<float>(e * (c + alpha * s / beta));
+			step.mOffsetVelocity 	= static_cast<float>(e * s / beta);
+			step.mVelocityOffset 	= static_cast<float>(-e * omega * omega * s / beta);
+			step.mVelocity 			= static_cast<float>(e * (c - alpha * s / beta));
+		}
+		else
+		{
+			// over damped: the sum of two decaying exponentials
+			double root = omega * std::sqrt(zeta * zeta - 1.0);
+			double r1 = -zeta * omega + root;
+			double r2 = -zeta * omega - root;
+			double e1 = std::exp(r1 * t);
+			double e2 = std::exp(r2 * t);
+			double difference = (e2 - e1) / (r2 - r1);
+			double derivative = (r2 * e2 - r1 * e1) / (r2 - r1);
+			step.mOffset 			= static_cast<float>(e1 - r1 * difference);
+			step.mOffsetVelocity 	= static_cast<float>(difference);
+			step.mVelocityOffset 	= static_cast<float>(r1 * e1 - r1 * derivative);
+			step.mVelocity 			= static_cast<float>(derivative);
+		}
+		return step;
+	}
+}
@@ -0,0 +1,891 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// internal includes
+#include "tweenpool.h"
+
+// external includes
+#include <mathutils.h>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <new>
+#include <cmath>
+
+namespace nap
+{
+	//////////////////////////////////////////////////////////////////////////
+
+	// forward declares
+	template<typename T>
+	class SpringTween;
+
+	/**
+	 * Exact solution of a damped spring over one step: maps the offset from the target and the velocity
+	 * at the start of the step to the offset and velocity at the end of the step.
+	 * offset' = mOffset * offset + mOffsetVelocity * velocity
+	 * velocity' = mVelocityOffset * offset + mVelocity * velocity
+	 */
+	struct NAPAPI TweenSpringStep
+	{
+		float mOffset = 1.0f;				///< Contribution of the offset to the new offset
+		float mOffsetVelocity = 0.0f;		///< Contribution of the velocity to the new offset
+		float mVelocityOffset = 0.0f;		///< Contribution of the offset to the new velocity
+		float mVelocity = 1.0f;				///< Contribution of the velocity to the new velocity
+
+		/**
+		 * Solves the spring for the given step, stable for any step size
+		 * @param frequency natural frequency of the spring in Hz
+		 * @param damping damping ratio, 1 is critically damped, below 1 overshoots, above 1 approaches the target slower
+		 * @param time step size in seconds
+		 * @return the solution of the step
+		 */
+		static TweenSpringStep solve(float frequency, float damping, float time);
+	};
+
+
+	/**
+	 * @return largest absolute component of the given value, used to decide when a spring settled
+	 */
+	template<typename T>
+	float getSpringDistance(const T& value);
+
+
+	/**
+	 * Stores all springs of type T in contiguous arrays, see SpringTween.
+	 * A spring is advanced with the exact solution of a damped spring for the time step of its group,
+	 * springs that share their frequency, damping and group share the solution of a step.
+	 * Settled springs are stored after the active springs and cost nothing to update, changing the target wakes the spring.
+	 * Like the TweenPool, a SpringTween is a view onto a slot in the pool, slots are reused and guarded by a generation counter.
+	 * @tparam T the type of value that is tweened
+	 */
+	template<typename T>
+	class SpringTweenPool : public TweenPoolBase
+	{
+		friend class SpringTween<T>;
+	public:
+		/**
+		 * Constructor
+		 */
+		SpringTweenPool() = default;
+
+		/**
+		 * Deconstructor, deletes all springs owned by the pool
+		 */
+		~SpringTweenPool() override;
+
+		/**
+		 * Makes sure the given number of springs can be created without allocating memory
+		 * @param capacity number of springs
+		 */
+		void reserve(size_t capacity);
+
+		/**
+		 * Constructs a new spring owned by the pool, the spring rests at the given value
+		 * @param value the initial value and target
+		 * @param frequency natural frequency in Hz
+		 * @param damping damping ratio
+		 * @return the new spring
+		 */
+		SpringTween<T>& create(const T& value, float frequency, float damping);
+
+		/**
+		 * Adds a spring that is owned by someone else to the pool, the spring rests at the given value
+		 * @param spring the spring to add
+		 * @param value the initial value and target
+		 * @param frequency natural frequency in Hz
+		 * @param damping damping ratio
+		 * @return the id of the spring
+		 */
+		TweenID add(SpringTween<T>* spring, const T& value, float frequency, float damping);
+
+		/**
+		 * Advances all springs in the pool, dispatches signals afterwards
+		 * @param deltaTime time in seconds since last update
+		 */
+		void update(double deltaTime) override;
+
+		/**
+		 * Advances all springs in the pool, the raised signals are dispatched by dispatch()
+		 * @param deltaTime time in seconds since last update
+		 */
+		void evaluate(double deltaTime) override;
+
+		/**
+		 * Dispatches the signals raised by the last call to evaluate()
+		 */
+		void dispatch() override					{ dispatch(mEvents); }
+
+		/**
+		 * Advances the clocks of the pool when it owns them and computes the time step of every group
+		 * @param deltaTime time in seconds since last update
+		 */
+		void beginUpdate(double deltaTime) override;
+
+		/**
+		 * Makes the pool follow the given group clocks instead of its own
+		 * @param clocks the clocks, advanced by their owner
+		 */
+		void setClocks(TweenClocks& clocks) override;
+
+		/**
+		 * Moves springs that settled during the update to the dormant set
+		 */
+		void endUpdate() override;
+
+		/**
+		 * Splits all active springs in the pool into ranges that can be advanced independently
+		 * @param maxSize maximum number of springs in a range
+		 * @param ranges the ranges to append to
+		 */
+		void getRanges(uint32 maxSize, std::vector<TweenRange>& ranges) override;
+
+		/**
+		 * Advances the springs in a range without dispatching signals
+		 * @param range the range to advance
+		 * @param events receives the raised signals, in order
+		 */
+		void updateRange(const TweenRange& range, std::vector<TweenEvent>& events) override;
+
+		/**
+		 * Dispatches signals raised by updateRange()
+		 * @param events the events to dispatch
+		 */
+		void dispatch(const std::vector<TweenEvent>& events) override;
+
+		/**
+		 * Springs are added asleep and start moving when their target changes, there is nothing to stage
+		 */
+		void beginStaging() override				{ }
+
+		/**
+		 * Springs are added asleep, there is nothing to merge
+		 */
+		uint32 merge(bool) override					{ return 0; }
+
+		/**
+		 * Springs are never recycled, they follow their target until they are removed
+		 */
+		void recycle() override						{ }
+
+		/**
+		 * Puts every spring that didn't settle yet in the given cancelled groups to sleep and dispatches its KilledSignal.
+		 * The spring stays where it is until it is removed by its handle.
+		 * @param groups indices of the cancelled groups
+		 */
+		void killCancelled(const std::vector<uint32>& groups) override;
+
+		/**
+		 * Binds the output of a spring, replaces the current binding and writes the current value
+		 * @param id the id of the spring
+		 * @param binding the memory or accessor that receives the value
+		 */
+		void bind(TweenID id, const TweenBinding<T>& binding);
+
+		/**
+		 * Removes the output binding of a spring, ignored when the id is no longer valid
+		 * @param id the id of the spring
+		 */
+		void unbind(TweenID id) override;
+
+		/**
+		 * Removes the spring with the given id in O(1), ignored when the id is no longer valid.
+		 * Dispatches the KilledSignal of the spring when it didn't settle
+		 * @param id the id of the spring to remove
+		 */
+		void remove(TweenID id) override;
+
+		/**
+		 * @param id the id to validate
+		 * @return if the id refers to a spring in this pool
+		 */
+		bool isValid(TweenID id) const override;
+
+		/**
+		 * @param id the id of the spring
+		 * @return the spring with the given id, nullptr if the id is no longer valid
+		 */
+		SpringTween<T>* find(TweenID id) const;
+
+		/**
+		 * @return number of springs in the pool
+		 */
+		size_t size() const override				{ return mSlots.size(); }
+
+		/**
+		 * @return number of springs that are advanced every update
+		 */
+		size_t getActiveCount() const override		{ return mActive; }
+
+		/**
+		 * @return number of memory allocations made by the pool since it was created
+		 */
+		size_t getAllocationCount() const override	{ return mAllocations + mSlots.getAllocationCount() + mSpringStorage.getChunkCount(); }
+
+		/**
+		 * Records the lifecycle events of all springs in the pool into the given trace
+		 * @param trace the trace to record into, nullptr stops recording
+		 * @param type name of the tweened value type, must outlive the trace
+		 */
+		void setTrace(TweenTrace* trace, const char* type) override	{ mTrace = trace; mTraceType = type; }
+
+		/**
+		 * Sets the label that identifies the spring in a trace, ignored when the id is no longer valid
+		 * @param id the id of the spring
+		 * @param label the label, nullptr for none, must outlive the trace
+		 */
+		void setLabel(TweenID id, const char* label) override;
+
+		/**
+		 * @param id the id of the spring
+		 * @return label of the spring, nullptr when it has none or the id is no longer valid
+		 */
+		const char* getLabel(TweenID id) const override		{ return isValid(id) ? mSlots[id.mSlot].mLabel : nullptr; }
+
+	private:
+		/**
+		 * Spring state flags
+		 */
+		enum EFlags : uint8
+		{
+			Sleeping	= 1 << 0,		///< Spring settled at its target
+			Listening	= 1 << 1		///< A handler is connected to the update or settled signal
+		};
+
+		/**
+		 * Events raised during evaluation
+		 */
+		enum EEvents : uint8
+		{
+			Updated		= 1 << 0,		///< Value changed, UpdateSignal
+			Settled		= 1 << 1		///< Spring settled, SettledSignal
+		};
+
+		/**
+		 * Number of arrays that hold the state of the springs, they grow at the same time
+		 */
+		static constexpr size_t arrayCount = 10;
+
+		/**
+		 * Maps a stable slot to the index a spring is currently stored at
+		 */
+		struct Slot
+		{
+			uint32						mIndex = invalid;		///< Index of the spring, invalid when the slot is free
+			uint32						mGeneration = 0;		///< Incremented every time the slot is released
+			SpringTween<T>*				mSpring = nullptr;		///< The spring that occupies this slot, receives signals
+			bool						mOwned = false;			///< If the spring is owned by the pool, stored in mSpringStorage
+			const char*					mLabel = nullptr;		///< Label that identifies the spring in a trace
+		};
+
+		/**
+		 * Advances springs [begin, end) by the time step of their group, appends raised events
+		 */
+		void updateRange(uint32 begin, uint32 end, std::vector<TweenEvent>& events);
+
+		/**
+		 * Removes the spring at the given index by moving the last spring into its place, keeps the active and dormant set intact
+		 */
+		void erase(uint32 index);
+
+		/**
+		 * Swaps two springs and updates their slots
+		 */
+		void swap(uint32 a, uint32 b);
+
+		/**
+		 * Moves the spring in the given slot to the active or dormant set, based on its flags
+		 */
+		void refresh(uint32 slot);
+
+		/**
+		 * Wakes the spring in the given slot, called when its state changed
+		 */
+		void wake(uint32 slot);
+
+		/**
+		 * Moves the spring in the given slot to a group, the spring follows the time step of that group
+		 */
+		void setGroup(uint32 slot, const TweenGroup* group);
+
+		/**
+		 * Adds a spring to a group, the time step of the group is measured from now on
+		 */
+		void join(uint32 group);
+
+		/**
+		 * Called when a handler connects to a signal of the spring in the given slot, from now on the pool records its events
+		 */
+		void listen(uint32 slot);
+
+		/**
+		 * Destroys the spring owned by the pool in the given slot and releases its memory
+		 */
+		void destroy(Slot& slot);
+
+		/**
+		 * Records a lifecycle event of the spring in the given slot, costs a single branch when the pool isn't traced
+		 */
+		void trace(ETweenTraceEvent event, uint32 slot, bool completed = false)
+		{
+			if (mTrace != nullptr)
+				mTrace->record(event, mTraceType, mSlots[slot].mLabel, slot, mSlots[slot].mGeneration, completed);
+		}
+
+		/**
+		 * Counts the allocations made when an element is appended to the given array
+		 */
+		template<typename Array>
+		void track(const Array& array, size_t count = 1)		{ mAllocations += array.size() == array.capacity() ? count : 0; }
+
+		/**
+		 * Reserves memory in the given array, counts the allocation
+		 */
+		template<typename Array>
+		void reserve(Array& array, size_t capacity);
+
+		std::vector<T>						mValue;			///< Current values
+		std::vector<T>						mTarget;		///< Target values
+		std::vector<T>						mVelocity;		///< Velocities, per second
+		std::vector<float>					mFrequency;		///< Natural frequencies in Hz
+		std::vector<float>					mDamping;		///< Damping ratios
+		std::vector<float>					mEpsilon;		///< Distance to the target below which the spring settles
+		std::vector<uint32>					mGroup;			///< Group the spring follows the time step of
+		std::vector<uint8>					mFlags;			///< State flags
+		std::vector<uint32>					mSpringSlots;	///< Slot that points to the spring at the same index
+		std::vector<TweenBinding<T>>		mBindings;		///< Output bindings
+		uint32								mActive = 0;	///< Number of active springs, stored in front
+
+		TweenStorage<SpringTween<T>>		mSpringStorage;	///< Memory of springs owned by the pool
+		TweenSlots<Slot>					mSlots;			///< All slots
+		TweenClocks							mOwnClocks;		///< Clocks of the pool when it isn't managed by a service
+		TweenClocks*						mClocks = &mOwnClocks;	///< Clocks the springs follow
+		std::vector<double>					mTimes;			///< Clock of every group during the previous update
+		std::vector<float>					mSteps;			///< Time step of every group during this update
+		std::vector<TweenEvent>				mEvents;		///< Events raised during last update
+		std::vector<TweenID>				mKilled;		///< Springs in cancelled groups, killed by killCancelled()
+		size_t								mAllocations = 0;	///< Number of times the arrays of the pool allocated memory
+		TweenTrace*							mTrace = nullptr;	///< Records lifecycle events, nullptr when not traced
+		const char*							mTraceType = nullptr;	///< Name of the tweened value type in the trace
+	};
+
+
+	//////////////////////////////////////////////////////////////////////////
+	// Template Definitions
+	//////////////////////////////////////////////////////////////////////////
+
+	template<typename T>
+	float getSpringDistance(const T& value)
+	{
+		if constexpr (std::is_arithmetic<T>::value)
+		{
+			return static_cast<float>(std::abs(value));
+		}
+		else
+		{
+			float distance = 0.0f;
+			for (typename T::length_type i = 0; i < T::length(); i++)
+				distance = std::max(distance, static_cast<float>(std::abs(value[i])));
+			return distance;
+		}
+	}
+
+
+	template<typename T>
+	SpringTweenPool<T>::~SpringTweenPool()
+	{
+		for (auto& slot : mSlots)
+			destroy(slot);
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::reserve(size_t capacity)
+	{
+		if (capacity > mSpringSlots.capacity())
+		{
+			mValue.reserve(capacity);
+			mTarget.reserve(capacity);
+			mVelocity.reserve(capacity);
+			mFrequency.reserve(capacity);
+			mDamping.reserve(capacity);
+			mEpsilon.reserve(capacity);
+			mGroup.reserve(capacity);
+			mFlags.reserve(capacity);
+			mSpringSlots.reserve(capacity);
+			mBindings.reserve(capacity);
+			mAllocations += arrayCount;
+		}
+		mSlots.reserve(capacity);
+		reserve(mEvents, capacity);
+		mSpringStorage.reserve(capacity);
+	}
+
+
+	template<typename T>
+	template<typename Array>
+	void SpringTweenPool<T>::reserve(Array& array, size_t capacity)
+	{
+		if (capacity <= array.capacity())
+			return;
+		array.reserve(capacity);
+		mAllocations++;
+	}
+
+
+	template<typename T>
+	SpringTween<T>& SpringTweenPool<T>::create(const T& value, float frequency, float damping)
+	{
+		SpringTween<T>& ref = *new (mSpringStorage.allocate()) SpringTween<T>(*this);
+		ref.mID = add(&ref, value, frequency, damping);
+		mSlots[ref.mID.mSlot].mOwned = true;
+		return ref;
+	}
+
+
+	template<typename T>
+	TweenID SpringTweenPool<T>::add(SpringTween<T>* spring, const T& value, float frequency, float damping)
+	{
+		assert(frequency > 0.0f && damping > 0.0f); // spring never settles
+
+		// a new spring rests at its target, it's dormant until the target changes
+		uint32 slot_index = mSlots.allocate();
+		Slot& slot = mSlots[slot_index];
+		track(mSpringSlots, arrayCount);
+		mValue.emplace_back(value);
+		mTarget.emplace_back(value);
+		mVelocity.emplace_back(0.0f * value);
+		mFrequency.emplace_back(frequency);
+		mDamping.emplace_back(damping);
+		mEpsilon.emplace_back(1e-3f);
+		mGroup.emplace_back(TweenClocks::root);
+		mFlags.emplace_back(EFlags::Sleeping);
+		mSpringSlots.emplace_back(slot_index);
+		mBindings.emplace_back();
+		join(TweenClocks::root);
+
+		slot.mIndex = static_cast<uint32>(mSpringSlots.size() - 1);
+		slot.mSpring = spring;
+		slot.mOwned = false;
+		slot.mLabel = nullptr;
+		trace(ETweenTraceEvent::Create, slot_index);
+		return { slot_index, slot.mGeneration };
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::remove(TweenID id)
+	{
+		if (!isValid(id))
+			return;
+
+		// notify listeners the spring is killed before it settled
+		const Slot& killed = mSlots[id.mSlot];
+		bool settled = (mFlags[killed.mIndex] & EFlags::Sleeping) != 0;
+		if (!mSlots.kill(id, *killed.mSpring, settled))
+			return;
+		trace(ETweenTraceEvent::Kill, id.mSlot, settled);
+
+		// swap and pop, update the slot of the spring that took its place
+		Slot& entry = mSlots[id.mSlot];
+		mSlots.leave(id.mSlot, mGroup[entry.mIndex]);
+		mClocks->leave(mGroup[entry.mIndex]);
+		erase(entry.mIndex);
+
+		// release slot, invalidates all ids that refer to it
+		mSlots.release(id.mSlot);
+		destroy(entry);
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::killCancelled(const std::vector<uint32>& groups)
+	{
+		// collect first, handlers of the killed signal can create, change or remove springs
+		const uint8* cancelled = mClocks->getCancelled();
+		for (uint32 group : groups)
+		{
+			if (!cancelled[group])
+				continue;
+
+			for (uint32 slot = mSlots.getFirstMember(group); slot != invalid; slot = mSlots.getNextMember(slot))
+			{
+				if (!(mFlags[mSlots[slot].mIndex] & EFlags::Sleeping))
+				{
+					track(mKilled);
+					mKilled.push_back({ slot, mSlots[slot].mGeneration });
+				}
+			}
+		}
+
+		// handlers might have moved or removed the spring since it was collected
+		for (const auto& id : mKilled)
+		{
+			if (!isValid(id))
+				continue;
+
+			Slot& entry = mSlots[id.mSlot];
+			if (!mClocks->getCancelled()[mGroup[entry.mIndex]] || (mFlags[entry.mIndex] & EFlags::Sleeping))
+				continue;
+
+			// the spring stays where it is and sleeps, the kill is traced when its handle removes it
+			mFlags[entry.mIndex] |= EFlags::Sleeping;
+			refresh(id.mSlot);
+			trace(ETweenTraceEvent::Complete, id.mSlot);
+			entry.mSpring->KilledSignal();
+		}
+		mKilled.clear();
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::destroy(Slot& slot)
+	{
+		SpringTween<T>* spring = slot.mSpring;
+		bool owned = slot.mOwned;
+		slot.mSpring = nullptr;
+		slot.mOwned = false;
+		if (owned)
+		{
+			spring->~SpringTween();
+			mSpringStorage.release(spring);
+		}
+	}
+
+
+	template<typename T>
+	bool SpringTweenPool<T>::isValid(TweenID id) const
+	{
+		return mSlots.isValid(id);
+	}
+
+
+	template<typename T>
+	SpringTween<T>* SpringTweenPool<T>::find(TweenID id) const
+	{
+		return isValid(id) ? mSlots[id.mSlot].mSpring : nullptr;
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::erase(uint32 index)
+	{
+		// move an active spring to the front of the dormant set first
+		if (index < mActive)
+		{
+			mActive--;
+			swap(index, mActive);
+			index = mActive;
+		}
+
+		uint32 last = static_cast<uint32>(mSpringSlots.size() - 1);
+		if (index != last)
+		{
+			mValue[index] 		= mValue[last];
+			mTarget[index] 		= mTarget[last];
+			mVelocity[index] 	= mVelocity[last];
+			mFrequency[index] 	= mFrequency[last];
+			mDamping[index] 	= mDamping[last];
+			mEpsilon[index] 	= mEpsilon[last];
+			mGroup[index] 		= mGroup[last];
+			mFlags[index] 		= mFlags[last];
+			mSpringSlots[index] = mSpringSlots[last];
+			mBindings[index] 	= mBindings[last];
+			mSlots[mSpringSlots[index]].mIndex = index;
+		}
+
+		mValue.pop_back();
+		mTarget.pop_back();
+		mVelocity.pop_back();
+		mFrequency.pop_back();
+		mDamping.pop_back();
+		mEpsilon.pop_back();
+		mGroup.pop_back();
+		mFlags.pop_back();
+		mSpringSlots.pop_back();
+		mBindings.pop_back();
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::swap(uint32 a, uint32 b)
+	{
+		if (a == b)
+			return;
+
+		std::swap(mValue[a], mValue[b]);
+		std::swap(mTarget[a], mTarget[b]);
+		std::swap(mVelocity[a], mVelocity[b]);
+		std::swap(mFrequency[a], mFrequency[b]);
+		std::swap(mDamping[a], mDamping[b]);
+		std::swap(mEpsilon[a], mEpsilon[b]);
+		std::swap(mGroup[a], mGroup[b]);
+		std::swap(mFlags[a], mFlags[b]);
+		std::swap(mSpringSlots[a], mSpringSlots[b]);
+		std::swap(mBindings[a], mBindings[b]);
+		mSlots[mSpringSlots[a]].mIndex = a;
+		mSlots[mSpringSlots[b]].mIndex = b;
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::refresh(uint32 slot)
+	{
+		uint32 index = mSlots[slot].mIndex;
+		bool active = index < mActive;
+		bool awake = (mFlags[index] & EFlags::Sleeping) == 0;
+
+		// a killed member of a cancelled group that wakes up is killed again
+		if (awake && mClocks->getCancelled()[mGroup[index]])
+			mClocks->queueKill(mGroup[index]);
+
+		if (awake && !active)
+		{
+			swap(index, mActive);
+			mActive++;
+		}
+		else if (!awake && active)
+		{
+			mActive--;
+			swap(index, mActive);
+		}
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::wake(uint32 slot)
+	{
+		uint32 index = mSlots[slot].mIndex;
+		if (!(mFlags[index] & EFlags::Sleeping))
+			return;
+
+		mFlags[index] &= ~EFlags::Sleeping;
+		refresh(slot);
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::setGroup(uint32 slot, const TweenGroup* group)
+	{
+		assert(group == nullptr || &group->getClocks() == mClocks); // group belongs to another service
+		uint32 index = group != nullptr ? group->getIndex() : TweenClocks::root;
+		uint32& current = mGroup[mSlots[slot].mIndex];
+		if (current == index)
+			return;
+
+		mSlots.leave(slot, current);
+		mClocks->leave(current);
+		mSlots.join(slot, index);
+		join(index);
+		current = index;
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::join(uint32 group)
+	{
+		// in between updates the clock of a group is at the time it was last stepped, unless the group was reused
+		mClocks->join(group);
+		if (mTimes.size() < mClocks->size())
+		{
+			mTimes.resize(mClocks->size(), 0.0);
+			mSteps.resize(mClocks->size(), 0.0f);
+			mAllocations += 2;
+		}
+		mTimes[group] = mClocks->getTime(group);
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::listen(uint32 slot)
+	{
+		mFlags[mSlots[slot].mIndex] |= EFlags::Listening;
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::bind(TweenID id, const TweenBinding<T>& binding)
+	{
+		assert(isValid(id));
+
+		// a settled spring isn't written until it moves again, write its value right away
+		uint32 index = mSlots[id.mSlot].mIndex;
+		mBindings[index] = binding;
+		if (binding.mTarget != nullptr)
+			binding.apply(mValue[index]);
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::unbind(TweenID id)
+	{
+		if (isValid(id))
+			bind(id, {});
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::setLabel(TweenID id, const char* label)
+	{
+		if (isValid(id))
+			mSlots[id.mSlot].mLabel = label;
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::update(double deltaTime)
+	{
+		evaluate(deltaTime);
+		dispatch();
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::evaluate(double deltaTime)
+	{
+		beginUpdate(deltaTime);
+		mEvents.clear();
+		size_t capacity = mEvents.capacity();
+		updateRange(0, mActive, mEvents);
+		mAllocations += mEvents.capacity() != capacity ? 1 : 0;
+		endUpdate();
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::beginUpdate(double deltaTime)
+	{
+		// the clocks of a service are advanced by the service
+		if (mClocks == &mOwnClocks)
+			mOwnClocks.advance(deltaTime);
+
+		// springs integrate the time step of their group, which includes its time scale and paused state.
+		// groups created since the last update have no springs yet
+		const double* clocks = mClocks->getTimes();
+		uint32 count = std::min<uint32>(mClocks->size(), static_cast<uint32>(mTimes.size()));
+		for (uint32 group = 0; group < count; group++)
+		{
+			mSteps[group] = static_cast<float>(std::max(clocks[group] - mTimes[group], 0.0));
+			mTimes[group] = clocks[group];
+		}
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::setClocks(TweenClocks& clocks)
+	{
+		assert(size() == 0); // springs follow the clocks they were added with
+		mClocks = &clocks;
+		mTimes.clear();
+		mSteps.clear();
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::endUpdate()
+	{
+		for (uint32 i = 0; i < mActive;)
+		{
+			if (mFlags[i] & EFlags::Sleeping)
+			{
+				trace(ETweenTraceEvent::Complete, mSpringSlots[i]);
+				mActive--;
+				swap(i, mActive);
+			}
+			else
+			{
+				i++;
+			}
+		}
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::getRanges(uint32 maxSize, std::vector<TweenRange>& ranges)
+	{
+		assert(maxSize > 0);
+		for (uint32 begin = 0; begin < mActive; begin += maxSize)
+			ranges.push_back({ this, 0, begin, std::min(begin + maxSize, mActive) });
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::updateRange(const TweenRange& range, std::vector<TweenEvent>& events)
+	{
+		assert(range.mPool == this);
+		updateRange(range.mBegin, range.mEnd, events);
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::updateRange(uint32 begin, uint32 end, std::vector<TweenEvent>& events)
+	{
+		const float* steps = mSteps.data();
+
+		// springs that share their frequency, damping and time step share the solution of the step
+		TweenSpringStep solution;
+		float frequency = -1.0f, damping = -1.0f, step = -1.0f, omega = 0.0f;
+		for (uint32 i = begin; i < end; i++)
+		{
+			// springs of a stopped group don't move
+			float time = steps[mGroup[i]];
+			if (time <= 0.0f)
+				continue;
+
+			if (mFrequency[i] != frequency || mDamping[i] != damping || time != step)
+			{
+				frequency = mFrequency[i];
+				damping = mDamping[i];
+				step = time;
+				omega = 2.0f * tweenPi * frequency;
+				solution = TweenSpringStep::solve(frequency, damping, step);
+			}
+
+			// the spring settles when it's close to its target and almost at rest,
+			// velocity is measured against epsilon per 1 / omega seconds: the rate at which a spring within epsilon still moves
+			T offset = mValue[i] - mTarget[i];
+			T moved = solution.mOffset * offset + solution.mOffsetVelocity * mVelocity[i];
+			mVelocity[i] = solution.mVelocityOffset * offset + solution.mVelocity * mVelocity[i];
+			uint8 raised = EEvents::Updated;
+			if (getSpringDistance(moved) <= mEpsilon[i] && getSpringDistance(mVelocity[i]) <= mEpsilon[i] * omega)
+			{
+				mValue[i] = mTarget[i];
+				mVelocity[i] = 0.0f * mVelocity[i];
+				mFlags[i] |= EFlags::Sleeping;
+				raised |= EEvents::Settled;
+			}
+			else
+			{
+				mValue[i] = mTarget[i] + moved;
+			}
+
+			if (mBindings[i].mTarget != nullptr)
+				mBindings[i].apply(mValue[i]);
+			if (mFlags[i] & EFlags::Listening)
+				events.push_back({ mSpringSlots[i], raised });
+		}
+	}
+
+
+	template<typename T>
+	void SpringTweenPool<T>::dispatch(const std::vector<TweenEvent>& events)
+	{
+		// handlers are allowed to create, change or remove springs: resolve every event through its slot and copy the value
+		for (const auto& event : events)
+		{
+			const Slot& entry = mSlots[event.mSlot];
+			if (entry.mSpring == nullptr)
+				continue;
+
+			T value = mValue[entry.mIndex];
+			SpringTween<T>& spring = *entry.mSpring;
+			if (event.mEvents & EEvents::Updated)
+				spring.UpdateSignal.trigger(value);
+			if (event.mEvents & EEvents::Settled)
+				spring.SettledSignal.trigger(value);
+		}
+	}
+}
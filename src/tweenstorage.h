@@ -0,0 +1,137 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// external includes
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+namespace nap
+{
+	//////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * Memory for objects of a fixed size with stable addresses.
+	 * Memory is allocated in chunks and released blocks are reused through a free list,
+	 * once the storage has grown to its peak size allocating and releasing objects never touches the heap.
+	 * The storage only hands out memory, objects are constructed and destroyed by the owner.
+	 * @tparam Object the type of object stored, determines size and alignment of a block
+	 */
+	template<typename Object>
+	class TweenStorage
+	{
+	public:
+		/**
+		 * Size of a block in bytes
+		 */
+		static constexpr size_t blockSize = sizeof(Object);
+
+		/**
+		 * Constructor
+		 */
+		TweenStorage() = default;
+
+		/**
+		 * Storage is not copyable
+		 */
+		TweenStorage(const TweenStorage&) = delete;
+		TweenStorage& operator=(const TweenStorage&) = delete;
+
+		/**
+		 * @return memory for one object, grows the storage when no block is free
+		 */
+		void* allocate();
+
+		/**
+		 * Returns memory for reuse, the object must be destroyed already
+		 * @param memory memory obtained from allocate()
+		 */
+		void release(void* memory);
+
+		/**
+		 * Makes sure the given number of objects can be allocated without growing the storage
+		 * @param capacity number of objects
+		 */
+		void reserve(size_t capacity);
+
+		/**
+		 * @return number of objects that can be allocated without growing the storage
+		 */
+		size_t getCapacity() const						{ return mCapacity; }
+
+		/**
+		 * @return number of chunks allocated since the storage was created, every chunk is one allocation
+		 */
+		size_t getChunkCount() const					{ return mChunks.size(); }
+
+	private:
+		/**
+		 * Free blocks link to the next free block
+		 */
+		union Block
+		{
+			Block*									mNext;
+			alignas(Object) unsigned char			mData[sizeof(Object)];
+		};
+
+		/**
+		 * Adds a chunk of the given number of blocks to the free list
+		 */
+		void grow(size_t count);
+
+		std::vector<std::unique_ptr<Block[]>>		mChunks;				///< All allocated chunks
+		Block*										mFree = nullptr;		///< First free block
+		size_t										mCapacity = 0;			///< Total number of blocks
+	};
+
+
+	//////////////////////////////////////////////////////////////////////////
+	// Template Definitions
+	//////////////////////////////////////////////////////////////////////////
+
+	template<typename Object>
+	void* TweenStorage<Object>::allocate()
+	{
+		// double the storage when all blocks are in use
+		if (mFree == nullptr)
+			grow(mCapacity > 0 ? mCapacity : 64);
+
+		Block* block = mFree;
+		mFree = block->mNext;
+		return block->mData;
+	}
+
+
+	template<typename Object>
+	void TweenStorage<Object>::release(void* memory)
+	{
+		Block* block = reinterpret_cast<Block*>(memory);
+		block->mNext = mFree;
+		mFree = block;
+	}
+
+
+	template<typename Object>
+	void TweenStorage<Object>::reserve(size_t capacity)
+	{
+		if (capacity > mCapacity)
+			grow(capacity - mCapacity);
+	}
+
+
+	template<typename Object>
+	void TweenStorage<Object>::grow(size_t count)
+	{
+		std::unique_ptr<Block[]> chunk(new Block[count]);
+		for (size_t i = 0; i < count; i++)
+		{
+			chunk[i].mNext = mFree;
+			mFree = &chunk[i];
+		}
+		mChunks.emplace_back(std::move(chunk));
+		mCapacity += count;
+	}
+}
@@ -0,0 +1,246 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "tweentask.h"
+
+// external includes
+#include <algorithm>
+#include <new>
+
+namespace nap
+{
+	// every frame starts with the arena it belongs to, padded to keep the frame aligned for any type
+	static constexpr std::size_t frameHeaderSize = __STDCPP_DEFAULT_NEW_ALIGNMENT__ > sizeof(void*) ? __STDCPP_DEFAULT_NEW_ALIGNMENT__ : sizeof(void*);
+	static constexpr std::size_t smallestFrameSize = 64;
+
+
+	/**
+	 * @return the size class of a frame including its header, classCount when it's allocated on the heap
+	 */
+	static uint32 getSizeClass(std::size_t size, uint32 classCount)
+	{
+		uint32 index = 0;
+		for (std::size_t block = smallestFrameSize; block < size + frameHeaderSize; block *= 2)
+			index++;
+		return std::min(index, classCount);
+	}
+
+
+	void* TweenTaskArena::allocate(TweenTaskArena* arena, std::size_t size)
+	{
+		uint32 index = getSizeClass(size, classCount);
+		char* block = nullptr;
+		if (arena == nullptr || index == classCount)
+		{
+			block = static_cast<char*>(::operator new(size + frameHeaderSize));
+			if (arena != nullptr)
+				arena->mAllocations++;
+			arena = nullptr;
+		}
+		else
+		{
+			// carve a new page into blocks when the free list of this size is empty
+			if (arena->mFree[index] == nullptr)
+			{
+				std::size_t block_size = smallestFrameSize << index;
+				arena->mPages.emplace_back(new char[block_size * blocksPerPage]);
+				arena->mAllocations++;
+				char* page = arena->mPages.back().get();
+				for (uint32 i = blocksPerPage; i > 0; i--)
+				{
+					Block* free = reinterpret_cast<Block*>(page + (i - 1) * block_size);
+					free->mNext = arena->mFree[index];
+					arena->mFree[index] = free;
+				}
+			}
+			Block* free = arena->mFree[index];
+			arena->mFree[index] = free->mNext;
+			block = reinterpret_cast<char*>(free);
+		}
+
+		*reinterpret_cast<TweenTaskArena**>(block) = arena;
+		return block + frameHeaderSize;
+	}
+
+
+	void TweenTaskArena::deallocate(void* frame, std::size_t size)
+	{
+		char* block = static_cast<char*>(frame) - frameHeaderSize;
+		TweenTaskArena* arena = *reinterpret_cast<TweenTaskArena**>(block);
+		if (arena == nullptr)
+		{
+			::operator delete(block);
+			return;
+		}
+
+		uint32 index = getSizeClass(size, classCount);
+		assert(index < classCount);
+		Block* free = reinterpret_cast<Block*>(block);
+		free->mNext = arena->mFree[index];
+		arena->mFree[index] = free;
+	}
+
+
+	TweenTaskScheduler::~TweenTaskScheduler()
+	{
+		clear();
+	}
+
+
+	TweenTaskID TweenTaskScheduler::start(void* frame, TweenTaskFunction resume, TweenTaskFunction destroy)
+	{
+		uint32 slot;
+		if (mFreeSlots.empty())
+		{
+			slot = static_cast<uint32>(mTasks.size());
+			push(mTasks, Task());
+		}
+		else
+		{
+			slot = mFreeSlots.back();
+			mFreeSlots.pop_back();
+		}
+
+		Task& task = mTasks[slot];
+		task.mFrame = frame;
+		task.mDestroy = destroy;
+		task.mFinished = false;
+		mTaskCount++;
+
+		TweenTaskID id = { slot, task.mGeneration };
+		push(mNext, { frame, resume, id });
+		return id;
+	}
+
+
+	void TweenTaskScheduler::stop(TweenTaskID id)
+	{
+		if (!isRunning(id))
+			return;
+
+		// a task that stops itself keeps running until it suspends
+		if (id.mSlot == mCurrent)
+		{
+			mTasks[id.mSlot].mFinished = true;
+			return;
+		}
+
+		// forget the waits of the task, resumes of this update are skipped by their generation
+		auto other_task = [id](const TweenTaskResume& resume) { return resume.mTask == id; };
+		mNext.erase(std::remove_if(mNext.begin(), mNext.end(), other_task), mNext.end());
+		mTweenWaits.erase(std::remove_if(mTweenWaits.begin(), mTweenWaits.end(), [&](const TweenWait& wait) { return other_task(wait.mResume); }), mTweenWaits.end());
+		auto end = std::remove_if(mTimeWaits.begin(), mTimeWaits.end(), [&](const TimeWait& wait) { return other_task(wait.mResume); });
+		if (end != mTimeWaits.end())
+		{
+			mTimeWaits.erase(end, mTimeWaits.end());
+			std::make_heap(mTimeWaits.begin(), mTimeWaits.end());
+		}
+		destroy(id.mSlot);
+	}
+
+
+	void TweenTaskScheduler::finish(TweenTaskID id)
+	{
+		assert(id.mSlot < mTasks.size() && mTasks[id.mSlot].mGeneration == id.mGeneration);
+		mTasks[id.mSlot].mFinished = true;
+	}
+
+
+	bool TweenTaskScheduler::isRunning(TweenTaskID id) const
+	{
+		return id.mSlot < mTasks.size() && mTasks[id.mSlot].mGeneration == id.mGeneration &&
+			mTasks[id.mSlot].mFrame != nullptr && !mTasks[id.mSlot].mFinished;
+	}
+
+
+	void TweenTaskScheduler::resumeNext(const TweenTaskResume& resume)
+	{
+		push(mNext, resume);
+	}
+
+
+	void TweenTaskScheduler::resumeAt(double time, const TweenTaskResume& resume)
+	{
+		push(mTimeWaits, { resume, time });
+		std::push_heap(mTimeWaits.begin(), mTimeWaits.end());
+	}
+
+
+	void TweenTaskScheduler::resumeAfter(TweenPoolBase& pool, TweenID id, const TweenTaskResume& resume)
+	{
+		push(mTweenWaits, { resume, &pool, id });
+	}
+
+
+	void TweenTaskScheduler::update(double time)
+	{
+		// collect every wait that is over, waits added while resuming are handled during the next update
+		mTime = time;
+		size_t capacity = mResuming.capacity();
+		mResuming.swap(mNext);
+
+		// tweens that completed were recycled or removed earlier in the update
+		uint32 kept = 0;
+		for (const auto& wait : mTweenWaits)
+		{
+			if (wait.mPool->isValid(wait.mID))
+				mTweenWaits[kept++] = wait;
+			else
+				mResuming.push_back(wait.mResume);
+		}
+		mTweenWaits.resize(kept);
+
+		while (!mTimeWaits.empty() && mTimeWaits.front().mTime <= time)
+		{
+			std::pop_heap(mTimeWaits.begin(), mTimeWaits.end());
+			mResuming.push_back(mTimeWaits.back().mResume);
+			mTimeWaits.pop_back();
+		}
+		mAllocations += mResuming.capacity() != capacity ? 1 : 0;
+
+		// resume in order, a task can stop tasks that are resumed after it
+		for (const auto& resume : mResuming)
+		{
+			if (!isRunning(resume.mTask))
+				continue;
+
+			mCurrent = resume.mTask.mSlot;
+			resume.mResume(resume.mFrame);
+			mCurrent = std::numeric_limits<uint32>::max();
+			if (mTasks[resume.mTask.mSlot].mFinished)
+				destroy(resume.mTask.mSlot);
+		}
+		mResuming.clear();
+	}
+
+
+	void TweenTaskScheduler::clear()
+	{
+		// destroying a task can kill tweens, not start or resume other tasks
+		for (uint32 i = 0; i < mTasks.size(); i++)
+		{
+			if (mTasks[i].mFrame != nullptr)
+				destroy(i);
+		}
+		mNext.clear();
+		mTweenWaits.clear();
+		mTimeWaits.clear();
+		mResuming.clear();
+	}
+
+
+	void TweenTaskScheduler::destroy(uint32 slot)
+	{
+		Task& task = mTasks[slot];
+		void* frame = task.mFrame;
+		TweenTaskFunction destroy = task.mDestroy;
+		task.mFrame = nullptr;
+		task.mDestroy = nullptr;
+		task.mFinished = false;
+		task.mGeneration++;
+		push(mFreeSlots, slot);
+		mTaskCount--;
+		destroy(frame);
+	}
+}
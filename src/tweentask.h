@@ -0,0 +1,533 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// internal includes
+#include "tweenpool.h"
+
+// external includes
+#include <mathutils.h>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Tween tasks are C++20 coroutines, they are available when the application is built with coroutine support.
+// The scheduler below doesn't depend on them: the service has the same layout in every language mode.
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+	#if __has_include(<coroutine>)
+		#define NAP_TWEEN_COROUTINES
+		#include <coroutine>
+		#include <exception>
+	#endif
+#endif
+
+namespace nap
+{
+	//////////////////////////////////////////////////////////////////////////
+
+	// forward declares
+	class TweenService;
+
+	/**
+	 * Id of a task started with TweenService::start(), stop the task with TweenService::stop().
+	 * The id stays safe to use after the task finished, it no longer refers to a running task once the task is destroyed.
+	 */
+	struct NAPAPI TweenTaskID
+	{
+		uint32 mSlot = 0;				///< Slot of the task in the scheduler
+		uint32 mGeneration = 0;			///< Generation of the slot when the task started, 0 when the task couldn't be started
+
+		bool operator==(const TweenTaskID& other) const		{ return mSlot == other.mSlot && mGeneration == other.mGeneration; }
+		bool operator!=(const TweenTaskID& other) const		{ return !(*this == other); }
+	};
+
+
+	/**
+	 * Function that resumes or destroys the coroutine frame at the given address
+	 */
+	using TweenTaskFunction = void (*)(void* frame);
+
+
+	/**
+	 * A suspended coroutine of a task, resumed by the scheduler
+	 */
+	struct NAPAPI TweenTaskResume
+	{
+		void*				mFrame = nullptr;		///< Frame of the suspended coroutine, a task or one of the tasks it awaits
+		TweenTaskFunction	mResume = nullptr;		///< Resumes the frame
+		TweenTaskID			mTask;					///< Task the coroutine belongs to
+	};
+
+
+	/**
+	 * Allocates the coroutine frames of tween tasks from pages that are reused once a task finishes.
+	 * Frames are rounded up to a power of two and kept in a free list per size,
+	 * after the first tasks of every size have run, starting a task no longer allocates.
+	 * Frames larger than the largest size class are allocated on the heap.
+	 * Not thread safe, tasks are created and destroyed on the main thread.
+	 */
+	class NAPAPI TweenTaskArena
+	{
+	public:
+		/**
+		 * Constructor
+		 */
+		TweenTaskArena() = default;
+
+		/**
+		 * The arena is not copyable, frames refer to it
+		 */
+		TweenTaskArena(const TweenTaskArena&) = delete;
+		TweenTaskArena& operator=(const TweenTaskArena&) = delete;
+
+		/**
+		 * Allocates a coroutine frame
+		 * @param arena the arena to allocate from, nullptr to allocate on the heap
+		 * @param size size of the frame in bytes
+		 * @return the frame
+		 */
+		static void* allocate(TweenTaskArena* arena, std::size_t size);
+
+		/**
+		 * Releases a frame returned by allocate() to the arena it was allocated from
+		 * @param frame the frame
+		 * @param size size of the frame in bytes
+		 */
+		static void deallocate(void* frame, std::size_t size);
+
+		/**
+		 * @return number of allocated pages and heap frames since the arena was created
+		 */
+		size_t getAllocationCount() const								{ return mAllocations; }
+
+	private:
+		static constexpr uint32 classCount = 7;						///< Size classes of 64 up to 4096 bytes
+		static constexpr uint32 blocksPerPage = 32;					///< Number of frames allocated at once
+
+		/**
+		 * A released frame, linked into the free list of its size
+		 */
+		struct Block
+		{
+			Block* mNext = nullptr;
+		};
+
+		std::vector<std::unique_ptr<char[]>>	mPages;							///< All pages of the arena
+		Block*									mFree[classCount] = {};			///< Free list per size class
+		size_t									mAllocations = 0;				///< Number of allocated pages and heap frames
+	};
+
+
+	/**
+	 * Resumes suspended tween tasks once per TweenService update.
+	 * A task waits for the completion of a tween, a point in time or the next update, every wait is resumed in one batch.
+	 * The scheduler only refers to coroutine frames by address: it is compiled in every language mode,
+	 * the coroutines themselves are resumed through the functions that come with every wait.
+	 * Tasks are resumed on the main thread, in the order in which their waits were satisfied.
+	 */
+	class NAPAPI TweenTaskScheduler
+	{
+	public:
+		/**
+		 * Constructor
+		 */
+		TweenTaskScheduler() = default;
+
+		/**
+		 * Destructor, destroys all tasks
+		 */
+		~TweenTaskScheduler();
+
+		/**
+		 * The scheduler is not copyable, tasks refer to it
+		 */
+		TweenTaskScheduler(const TweenTaskScheduler&) = delete;
+		TweenTaskScheduler& operator=(const TweenTaskScheduler&) = delete;
+
+		/**
+		 * Takes ownership of a suspended task, the task is resumed for the first time during the next update
+		 * @param frame the frame of the task
+		 * @param resume resumes the frame
+		 * @param destroy destroys the frame
+		 * @return id of the task
+		 */
+		TweenTaskID start(void* frame, TweenTaskFunction resume, TweenTaskFunction destroy);
+
+		/**
+		 * Destroys a task and all tasks it awaits. A task that stops itself is destroyed at its next suspension.
+		 * Nothing happens when the task already finished.
+		 * @param id id of the task
+		 */
+		void stop(TweenTaskID id);
+
+		/**
+		 * Called by a task when its coroutine finished, the task is destroyed once the scheduler regains control
+		 * @param id id of the task
+		 */
+		void finish(TweenTaskID id);
+
+		/**
+		 * @param id id of a task
+		 * @return if the task is running, false once it finished or is stopped
+		 */
+		bool isRunning(TweenTaskID id) const;
+
+		/**
+		 * Resumes a coroutine during the next update
+		 * @param resume the suspended coroutine
+		 */
+		void resumeNext(const TweenTaskResume& resume);
+
+		/**
+		 * Resumes a coroutine during the first update at or after the given time
+		 * @param time time of the root clock of the service in seconds, see getTime()
+		 * @param resume the suspended coroutine
+		 */
+		void resumeAt(double time, const TweenTaskResume& resume);
+
+		/**
+		 * Resumes a coroutine during the first update in which the given tween no longer exists
+		 * @param pool the pool the tween is stored in
+		 * @param id id of the tween in the pool
+		 * @param resume the suspended coroutine
+		 */
+		void resumeAfter(TweenPoolBase& pool, TweenID id, const TweenTaskResume& resume);
+
+		/**
+		 * Resumes every coroutine whose wait is over, called once per update by the service
+		 * @param time time of the root clock of the service in seconds
+		 */
+		void update(double time);
+
+		/**
+		 * Destroys all tasks
+		 */
+		void clear();
+
+		/**
+		 * @return time of the root clock of the service during the last update
+		 */
+		double getTime() const											{ return mTime; }
+
+		/**
+		 * @return number of running tasks
+		 */
+		size_t getTaskCount() const										{ return mTaskCount; }
+
+		/**
+		 * @return arena the coroutine frames of the tasks are allocated from
+		 */
+		TweenTaskArena& getArena()										{ return mArena; }
+
+		/**
+		 * @return number of allocations made by the scheduler and its arena since it was created
+		 */
+		size_t getAllocationCount() const								{ return mAllocations + mArena.getAllocationCount(); }
+
+	private:
+		/**
+		 * A started task
+		 */
+		struct Task
+		{
+			void*				mFrame = nullptr;		///< Frame of the outermost coroutine, nullptr when the slot is free
+			TweenTaskFunction	mDestroy = nullptr;		///< Destroys the frame
+			uint32				mGeneration = 1;		///< Incremented every time the slot is released
+			bool				mFinished = false;		///< If the task finished or is stopped, it's destroyed once it's no longer resumed
+		};
+
+		/**
+		 * A coroutine that waits for a tween
+		 */
+		struct TweenWait
+		{
+			TweenTaskResume		mResume;				///< The coroutine
+			TweenPoolBase*		mPool = nullptr;		///< Pool the tween is stored in
+			TweenID				mID;					///< Id of the tween
+		};
+
+		/**
+		 * A coroutine that waits for a point in time
+		 */
+		struct TimeWait
+		{
+			TweenTaskResume		mResume;				///< The coroutine
+			double				mTime = 0.0;			///< Time of the root clock at which it's resumed
+
+			bool operator<(const TimeWait& other) const	{ return mTime > other.mTime; }
+		};
+
+		/**
+		 * Destroys the frame of a task and releases its slot
+		 * @param slot slot of the task
+		 */
+		void destroy(uint32 slot);
+
+		/**
+		 * Appends an element, counts the allocation when the vector grows
+		 */
+		template<typename E>
+		void push(std::vector<E>& vector, const E& element);
+
+		TweenTaskArena					mArena;							///< Coroutine frames of all tasks
+		std::vector<Task>				mTasks;							///< All task slots
+		std::vector<uint32>				mFreeSlots;						///< Released task slots
+		std::vector<TweenTaskResume>	mNext;							///< Coroutines resumed during the next update
+		std::vector<TweenWait>			mTweenWaits;					///< Coroutines that wait for a tween
+		std::vector<TimeWait>			mTimeWaits;						///< Coroutines that wait for a point in time, a min heap
+		std::vector<TweenTaskResume>	mResuming;						///< Coroutines resumed this update
+		uint32							mCurrent = std::numeric_limits<uint32>::max();	///< Slot of the task that is resumed
+		double							mTime = 0.0;					///< Time of the root clock during the last update
+		size_t							mTaskCount = 0;					///< Number of running tasks
+		size_t							mAllocations = 0;				///< Number of allocations made by the scheduler
+	};
+
+
+	/**
+	 * @param service the service
+	 * @return the arena the tasks of the service allocate their coroutine frames from
+	 */
+	NAPAPI TweenTaskArena& getTweenTaskArena(TweenService& service);
+
+
+#ifdef NAP_TWEEN_COROUTINES
+
+	/**
+	 * Finds the arena of the first TweenService among the parameters of a coroutine, nullptr when there is none
+	 */
+	inline TweenTaskArena* findTweenTaskArena()							{ return nullptr; }
+
+	template<typename Arg, typename... Args>
+	TweenTaskArena* findTweenTaskArena(Arg& arg, Args&... args);
+
+
+	/**
+	 * A coroutine that scripts tweens over multiple updates without nested signal handlers:
+	 *
+	 *		TweenTask fadeIn(TweenService& service, float& alpha)
+	 *		{
+	 *			co_await service.tween(0.0f, 1.0f, 0.5f, ETweenEaseType::QUAD_OUT).bind(&alpha);
+	 *			co_await delay(0.2);
+	 *			co_await service.tween(1.0f, 0.0f, 0.5f).bind(&alpha);
+	 *		}
+	 *
+	 *		TweenTaskID id = service.start(fadeIn(service, mAlpha));
+	 *
+	 * A task starts suspended, TweenService::start() resumes it for the first time during the next update.
+	 * Suspended tasks are resumed by the service in one batch at the end of every update, on the main thread,
+	 * after the tweens they wait for completed and were recycled.
+	 * A task can await another task, which runs right away and continues the awaiting task when it finishes.
+	 * When a task takes the TweenService by reference its coroutine frame is allocated from an arena owned by the service,
+	 * a finished task returns its frame to the arena. Such a task must be started or destroyed before the service shuts down.
+	 * Stopping a task destroys its coroutine: the tweens it waits for are killed and its locals are destroyed.
+	 * Only available when the application is built with C++20 coroutines, see NAP_TWEEN_COROUTINES.
+	 */
+	class TweenTask
+	{
+	public:
+		/**
+		 * Coroutine promise of a task
+		 */
+		struct promise_type
+		{
+			TweenTaskScheduler*		mScheduler = nullptr;		///< Scheduler that resumes the task
+			TweenTaskID				mTask;						///< Outermost task the coroutine belongs to
+			std::coroutine_handle<>	mContinuation = nullptr;	///< Task that awaits this task, nullptr for a started task
+
+			/**
+			 * Continues the awaiting task, or tells the scheduler the task finished
+			 */
+			struct FinalAwaiter
+			{
+				bool await_ready() const noexcept										{ return false; }
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+				void await_resume() const noexcept										{ }
+			};
+
+			TweenTask get_return_object()										{ return TweenTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+			std::suspend_always initial_suspend() const noexcept				{ return {}; }
+			FinalAwaiter final_suspend() const noexcept							{ return {}; }
+			void return_void() const											{ }
+			void unhandled_exception() const									{ std::terminate(); }
+
+			/**
+			 * Allocates the frame from the arena of the TweenService parameter of the coroutine, or the heap when there is none
+			 */
+			template<typename... Args>
+			static void* operator new(std::size_t size, Args&... args)			{ return TweenTaskArena::allocate(findTweenTaskArena(args...), size); }
+			static void operator delete(void* frame, std::size_t size)			{ TweenTaskArena::deallocate(frame, size); }
+
+			/**
+			 * @return the coroutine of the promise as a suspended coroutine of the task
+			 */
+			TweenTaskResume getResume();
+		};
+
+		/**
+		 * Starts another task from within a task, the awaiting task continues when the awaited task finishes
+		 */
+		struct Awaiter
+		{
+			std::coroutine_handle<promise_type> mHandle;
+
+			bool await_ready() const noexcept										{ return !mHandle || mHandle.done(); }
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+			void await_resume() const noexcept										{ }
+		};
+
+		/**
+		 * Tasks are move only, a task owns its coroutine until it's started
+		 */
+		TweenTask(TweenTask&& other) noexcept : mHandle(other.mHandle)			{ other.mHandle = nullptr; }
+		TweenTask& operator=(TweenTask&& other) noexcept;
+		TweenTask(const TweenTask&) = delete;
+		TweenTask& operator=(const TweenTask&) = delete;
+
+		/**
+		 * Destructor, destroys the coroutine when the task wasn't started
+		 */
+		~TweenTask()															{ if (mHandle) mHandle.destroy(); }
+
+		/**
+		 * @return if the task owns a coroutine
+		 */
+		bool isValid() const													{ return static_cast<bool>(mHandle); }
+
+		/**
+		 * Hands the coroutine to a scheduler, called by TweenService::start()
+		 * @param scheduler the scheduler that resumes the task
+		 * @return id of the task
+		 */
+		TweenTaskID start(TweenTaskScheduler& scheduler);
+
+		/**
+		 * Awaits the task from within another task
+		 */
+		Awaiter operator co_await() && noexcept									{ return { mHandle }; }
+
+	private:
+		/**
+		 * Constructor used by the promise
+		 */
+		explicit TweenTask(std::coroutine_handle<promise_type> handle) : mHandle(handle)	{ }
+
+		/**
+		 * Resumes or destroys the coroutine at the given address, used by the scheduler
+		 */
+		static void resume(void* frame)											{ std::coroutine_handle<>::from_address(frame).resume(); }
+		static void destroy(void* frame)										{ std::coroutine_handle<>::from_address(frame).destroy(); }
+
+		std::coroutine_handle<promise_type> mHandle = nullptr;
+	};
+
+
+	/**
+	 * Suspends a task for the given time, awaited with co_await delay(seconds)
+	 */
+	struct TweenTaskDelay
+	{
+		double mSeconds = 0.0;		///< Time to wait in seconds
+
+		bool await_ready() const noexcept										{ return false; }
+		void await_suspend(std::coroutine_handle<TweenTask::promise_type> handle);
+		void await_resume() const noexcept										{ }
+	};
+
+
+	/**
+	 * Suspends a task for the given time on the root clock of the service, group time scales don't apply.
+	 * A delay of 0 resumes the task during the next update.
+	 * @param seconds time to wait in seconds
+	 * @return the awaitable delay
+	 */
+	inline TweenTaskDelay delay(double seconds)									{ return { seconds }; }
+
+
+	//////////////////////////////////////////////////////////////////////////
+	// Template Definitions
+	//////////////////////////////////////////////////////////////////////////
+
+	template<typename Arg, typename... Args>
+	TweenTaskArena* findTweenTaskArena(Arg& arg, Args&... args)
+	{
+		if constexpr (std::is_same<typename std::remove_const<Arg>::type, TweenService>::value)
+			return &getTweenTaskArena(const_cast<TweenService&>(arg));
+		else
+			return findTweenTaskArena(args...);
+	}
+
+
+	inline std::coroutine_handle<> TweenTask::promise_type::FinalAwaiter::await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+	{
+		// an awaited task continues its parent, the parent destroys it when the co_await expression ends
+		promise_type& promise = handle.promise();
+		if (promise.mContinuation)
+			return promise.mContinuation;
+
+		// a started task is destroyed by the scheduler once it regains control
+		promise.mScheduler->finish(promise.mTask);
+		return std::noop_coroutine();
+	}
+
+
+	inline TweenTaskResume TweenTask::promise_type::getResume()
+	{
+		return { std::coroutine_handle<promise_type>::from_promise(*this).address(), &TweenTask::resume, mTask };
+	}
+
+
+	inline std::coroutine_handle<> TweenTask::Awaiter::await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+	{
+		// the awaited task belongs to the same outermost task and runs right away
+		promise_type& parent = handle.promise();
+		promise_type& child = mHandle.promise();
+		child.mScheduler = parent.mScheduler;
+		child.mTask = parent.mTask;
+		child.mContinuation = handle;
+		return mHandle;
+	}
+
+
+	inline TweenTask& TweenTask::operator=(TweenTask&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (mHandle)
+				mHandle.destroy();
+			mHandle = other.mHandle;
+			other.mHandle = nullptr;
+		}
+		return *this;
+	}
+
+
+	inline TweenTaskID TweenTask::start(TweenTaskScheduler& scheduler)
+	{
+		assert(mHandle && !mHandle.done()); // task is empty or already started
+		promise_type& promise = mHandle.promise();
+		promise.mScheduler = &scheduler;
+		promise.mTask = scheduler.start(mHandle.address(), &TweenTask::resume, &TweenTask::destroy);
+		mHandle = nullptr;
+		return promise.mTask;
+	}
+
+
+	inline void TweenTaskDelay::await_suspend(std::coroutine_handle<TweenTask::promise_type> handle)
+	{
+		TweenTask::promise_type& promise = handle.promise();
+		promise.mScheduler->resumeAt(promise.mScheduler->getTime() + mSeconds, promise.getResume());
+	}
+
+#endif // NAP_TWEEN_COROUTINES
+
+
+	template<typename E>
+	void TweenTaskScheduler::push(std::vector<E>& vector, const E& element)
+	{
+		mAllocations += vector.size() == vector.capacity() ? 1 : 0;
+		vector.push_back(element);
+	}
+}
@@ -0,0 +1,220 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "tweentrace.h"
+
+// external includes
+#include <fstream>
+#include <sstream>
+#include <cassert>
+#include <cstring>
+#include <type_traits>
+
+namespace nap
+{
+	// events are copied through atomic words
+	static_assert(std::is_trivially_copyable<TweenTraceEvent>::value, "TweenTraceEvent must be trivially copyable");
+
+
+	/**
+	 * @return index of the calling thread, assigned when the thread records its first event
+	 */
+	static uint32 getThreadIndex()
+	{
+		static std::atomic<uint32> thread_count = { 0 };
+		thread_local uint32 index = thread_count++;
+		return index;
+	}
+
+
+	/**
+	 * Writes a string as a JSON string, escapes quotes, backslashes and control characters
+	 */
+	static void writeString(std::ostringstream& stream, const char* string)
+	{
+		stream << '"';
+		for (const char* c = string; *c != '\0'; c++)
+		{
+			switch (*c)
+			{
+			case '"':	stream << "\\\"";	break;
+			case '\\':	stream << "\\\\";	break;
+			case '\n':	stream << "\\n";	break;
+			case '\t':	stream << "\\t";	break;
+			default:
+				if (static_cast<unsigned char>(*c) >= 0x20)
+					stream << *c;
+				break;
+			}
+		}
+		stream << '"';
+	}
+
+
+	TweenTrace::TweenTrace(uint32 capacity) :
+		mStart(Clock::now())
+	{
+		uint64 size = 1;
+		while (size < capacity)
+			size <<= 1;
+		mEntries = std::make_unique<Entry[]>(size);
+		mMask = size - 1;
+	}
+
+
+	void TweenTrace::record(ETweenTraceEvent event, const char* type, const char* label, uint32 slot, uint32 generation, bool completed)
+	{
+		TweenTraceEvent entry;
+		entry.mEvent = event;
+		entry.mThread = getThreadIndex();
+		entry.mTime = getTime(Clock::now());
+		entry.mType = type;
+		entry.mLabel = label;
+		entry.mSlot = slot;
+		entry.mGeneration = generation;
+		entry.mCompleted = completed;
+		push(entry);
+	}
+
+
+	void TweenTrace::recordSpan(ETweenTraceEvent event, const char* type, Clock::time_point begin, Clock::time_point end)
+	{
+		TweenTraceEvent entry;
+		entry.mEvent = event;
+		entry.mThread = getThreadIndex();
+		entry.mTime = getTime(begin);
+		entry.mDuration = std::chrono::duration<double, std::micro>(end - begin).count();
+		entry.mType = type;
+		push(entry);
+	}
+
+
+	void TweenTrace::push(const TweenTraceEvent& event)
+	{
+		// the sequence is cleared before and set after the event is written, readers skip entries that change while copied
+		uint64 index = mHead.fetch_add(1, std::memory_order_relaxed);
+		Entry& entry = mEntries[index & mMask];
+		uint64 words[wordCount] = {};
+		std::memcpy(words, &event, sizeof(TweenTraceEvent));
+		entry.mSequence.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		for (size_t i = 0; i < wordCount; i++)
+			entry.mWords[i].store(words[i], std::memory_order_relaxed);
+		entry.mSequence.store(index + 1, std::memory_order_release);
+	}
+
+
+	std::vector<TweenTraceEvent> TweenTrace::getEvents() const
+	{
+		uint64 head = mHead.load(std::memory_order_acquire);
+		uint64 capacity = mMask + 1;
+		uint64 first = head > capacity ? head - capacity : 0;
+
+		std::vector<TweenTraceEvent> events;
+		events.reserve(head - first);
+		for (uint64 index = first; index < head; index++)
+		{
+			// skip events that are still written or were overwritten since
+			const Entry& entry = mEntries[index & mMask];
+			if (entry.mSequence.load(std::memory_order_acquire) != index + 1)
+				continue;
+
+			uint64 words[wordCount];
+			for (size_t i = 0; i < wordCount; i++)
+				words[i] = entry.mWords[i].load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (entry.mSequence.load(std::memory_order_relaxed) != index + 1)
+				continue;
+
+			TweenTraceEvent& event = events.emplace_back();
+			std::memcpy(&event, words, sizeof(TweenTraceEvent));
+		}
+		return events;
+	}
+
+
+	std::string TweenTrace::toJSON() const
+	{
+		std::ostringstream stream;
+		stream.precision(3);
+		stream << std::fixed;
+		stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+		bool first = true;
+		for (const auto& event : getEvents())
+		{
+			stream << (first ? "\n" : ",\n");
+			first = false;
+
+			// spans are complete events, lifecycle events are thread scoped instant events
+			bool span = event.mEvent >= ETweenTraceEvent::Update;
+			stream << "{\"name\":";
+			writeString(stream, getName(event.mEvent));
+			stream << ",\"cat\":\"tween\",\"ph\":\"" << (span ? 'X' : 'i') << "\",\"ts\":" << event.mTime;
+			if (span)
+				stream << ",\"dur\":" << event.mDuration;
+			else
+				stream << ",\"s\":\"t\"";
+			stream << ",\"pid\":1,\"tid\":" << event.mThread << ",\"args\":{";
+
+			bool has_args = false;
+			if (event.mType != nullptr)
+			{
+				stream << "\"type\":";
+				writeString(stream, event.mType);
+				has_args = true;
+			}
+			if (!span)
+			{
+				stream << (has_args ? "," : "") << "\"slot\":" << event.mSlot << ",\"generation\":" << event.mGeneration;
+				if (event.mLabel != nullptr)
+				{
+					stream << ",\"label\":";
+					writeString(stream, event.mLabel);
+				}
+				if (event.mEvent == ETweenTraceEvent::Kill)
+					stream << ",\"completed\":" << (event.mCompleted ? "true" : "false");
+			}
+			stream << "}}";
+		}
+		stream << "\n]}\n";
+		return stream.str();
+	}
+
+
+	bool TweenTrace::write(const std::string& path, utility::ErrorState& error) const
+	{
+		std::ofstream file(path, std::ios::binary);
+		if (!error.check(file.is_open(), "Unable to open trace file: %s", path.c_str()))
+			return false;
+
+		file << toJSON();
+		return error.check(file.good(), "Unable to write trace file: %s", path.c_str());
+	}
+
+
+	const char* TweenTrace::getName(ETweenTraceEvent event)
+	{
+		switch (event)
+		{
+		case ETweenTraceEvent::Create:		return "Create";
+		case ETweenTraceEvent::Complete:	return "Complete";
+		case ETweenTraceEvent::Kill:		return "Kill";
+		case ETweenTraceEvent::Restart:		return "Restart";
+		case ETweenTraceEvent::Update:		return "Update";
+		case ETweenTraceEvent::Evaluate:	return "Evaluate";
+		case ETweenTraceEvent::Dispatch:	return "Dispatch";
+		case ETweenTraceEvent::Remove:		return "Remove";
+		case ETweenTraceEvent::Resume:		return "Resume";
+		}
+		assert(false);
+		return "";
+	}
+
+
+	double TweenTrace::getTime(Clock::time_point time) const
+	{
+		return std::chrono::duration<double, std::micro>(time - mStart).count();
+	}
+}
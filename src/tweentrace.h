@@ -0,0 +1,157 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// external includes
+#include <utility/errorstate.h>
+#include <mathutils.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nap
+{
+	//////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * Events recorded by a TweenTrace, scoped because the ease types already occupy names like LINEAR
+	 */
+	enum class ETweenTraceEvent : uint8
+	{
+		Create		= 0,		///< Tween was added to the service
+		Complete	= 1,		///< Tween completed during an update
+		Kill		= 2,		///< Tween was removed from the service
+		Restart		= 3,		///< Tween was restarted
+		Update		= 4,		///< Span of a whole TweenService update
+		Evaluate	= 5,		///< Span in which the tweens of a pool are evaluated
+		Dispatch	= 6,		///< Span in which the signals of a pool are dispatched
+		Remove		= 7,		///< Span in which killed tweens are removed
+		Resume		= 8			///< Span in which suspended tween tasks are resumed
+	};
+
+
+	/**
+	 * A recorded tween lifecycle event or update span
+	 */
+	struct NAPAPI TweenTraceEvent
+	{
+		ETweenTraceEvent	mEvent = ETweenTraceEvent::Create;	///< Recorded event
+		uint32				mThread = 0;						///< Index of the thread that recorded the event, in order of first use
+		double				mTime = 0.0;						///< Microseconds since the trace started
+		double				mDuration = 0.0;					///< Duration of a span in microseconds, 0 for lifecycle events
+		const char*			mType = nullptr;					///< Tweened value type, nullptr when the span covers all types
+		const char*			mLabel = nullptr;					///< Label of the tween, nullptr when it has none
+		uint32				mSlot = 0;							///< Slot of the tween in its pool
+		uint32				mGeneration = 0;					///< Generation of the slot, together with the slot it identifies the tween
+		bool				mCompleted = false;					///< If a killed tween completed before it was removed
+	};
+
+
+	/**
+	 * Records tween lifecycle events and update spans into a lock-free ring buffer of fixed size.
+	 * Recording claims an entry with a single atomic increment and never blocks or allocates,
+	 * any thread can record while the buffer is exported. When the buffer is full the oldest events are overwritten.
+	 * The recorded events can be written as Chrome trace event JSON, which is opened by chrome://tracing and ui.perfetto.dev.
+	 * Type names and labels are not copied, they must outlive the trace.
+	 */
+	class NAPAPI TweenTrace
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		/**
+		 * Constructor, the trace starts at construction
+		 * @param capacity number of events kept, rounded up to a power of two
+		 */
+		TweenTrace(uint32 capacity);
+
+		/**
+		 * Records a lifecycle event of a tween
+		 * @param event the event
+		 * @param type name of the tweened value type
+		 * @param label label of the tween, nullptr when it has none
+		 * @param slot slot of the tween in its pool
+		 * @param generation generation of the slot
+		 * @param completed if a killed tween completed before it was removed
+		 */
+		void record(ETweenTraceEvent event, const char* type, const char* label, uint32 slot, uint32 generation, bool completed = false);
+
+		/**
+		 * Records a span
+		 * @param event the span
+		 * @param type name of the tweened value type, nullptr when the span covers all types
+		 * @param begin time at which the span started
+		 * @param end time at which the span ended
+		 */
+		void recordSpan(ETweenTraceEvent event, const char* type, Clock::time_point begin, Clock::time_point end);
+
+		/**
+		 * @return the recorded events that weren't overwritten yet, oldest first
+		 */
+		std::vector<TweenTraceEvent> getEvents() const;
+
+		/**
+		 * @return number of events recorded since the trace started, including the overwritten events
+		 */
+		uint64 getRecordCount() const					{ return mHead.load(std::memory_order_relaxed); }
+
+		/**
+		 * @return number of events kept
+		 */
+		uint32 getCapacity() const						{ return static_cast<uint32>(mMask + 1); }
+
+		/**
+		 * @return the recorded events as Chrome trace event JSON
+		 */
+		std::string toJSON() const;
+
+		/**
+		 * Writes the recorded events as Chrome trace event JSON to a file
+		 * @param path the file to write
+		 * @param error contains the error when the file can't be written
+		 * @return if the file was written
+		 */
+		bool write(const std::string& path, utility::ErrorState& error) const;
+
+		/**
+		 * @return name of the given event, as shown by the trace viewer
+		 */
+		static const char* getName(ETweenTraceEvent event);
+
+	private:
+		/**
+		 * Number of 64 bit words that hold an event
+		 */
+		static constexpr size_t wordCount = (sizeof(TweenTraceEvent) + sizeof(uint64) - 1) / sizeof(uint64);
+
+		/**
+		 * An event in the ring buffer, the sequence tells if the event is completely written.
+		 * The event is copied in and out of relaxed atomic words, so a reader that races a writer of the same entry
+		 * reads a torn event it discards, instead of causing a data race.
+		 */
+		struct Entry
+		{
+			std::atomic<uint64>		mSequence = { 0 };		///< Record index + 1 once the event is written, 0 while it's written
+			std::atomic<uint64>		mWords[wordCount] = {};	///< The event, copied word by word
+		};
+
+		/**
+		 * Claims the next entry and writes the event into it
+		 */
+		void push(const TweenTraceEvent& event);
+
+		/**
+		 * @return microseconds between the start of the trace and the given time
+		 */
+		double getTime(Clock::time_point time) const;
+
+		std::unique_ptr<Entry[]>		mEntries;				///< Ring buffer
+		uint64							mMask = 0;				///< Capacity - 1
+		std::atomic<uint64>				mHead = { 0 };			///< Number of events recorded, the next event is written at mHead & mMask
+		Clock::time_point				mStart;					///< Time at which the trace started
+	};
+}
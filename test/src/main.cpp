@@ -0,0 +1,36 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+// Local Includes
+#include "tweentest.h"
+
+// External Includes
+#include <nap/logger.h>
+#include <cstring>
+
+/**
+ * Tween Test.
+ * Checks the tween module without a window, exits with a non zero code when a check fails.
+ * Usage: naptweentest [--filter suite]
+ */
+int main(int argc, char *argv[])
+{
+	std::string filter;
+	for (int i = 1; i < argc; i++)
+	{
+		bool has_value = i + 1 < argc;
+		if (std::strcmp(argv[i], "--filter") == 0 && has_value)
+		{
+			filter = argv[++i];
+		}
+		else
+		{
+			nap::Logger::error("Unknown argument: %s", argv[i]);
+			return -1;
+		}
+	}
+
+	nap::TweenTest test(filter);
+	return test.run() ? 0 : 1;
+}
@@ -0,0 +1,52 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+// Local Includes
+#include "tweenallocationcounter.h"
+
+// External Includes
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// every heap allocation of the executable passes through here
+static std::atomic<size_t> sAllocations = { 0 };
+
+static void* allocate(size_t size)
+{
+	sAllocations.fetch_add(1, std::memory_order_relaxed);
+	return std::malloc(size > 0 ? size : 1);
+}
+
+void* operator new(size_t size)
+{
+	if (void* memory = allocate(size))
+		return memory;
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+	if (void* memory = allocate(size))
+		return memory;
+	throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept			{ return allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept		{ return allocate(size); }
+
+void operator delete(void* memory) noexcept								{ std::free(memory); }
+void operator delete[](void* memory) noexcept							{ std::free(memory); }
+void operator delete(void* memory, size_t) noexcept						{ std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept					{ std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept		{ std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept	{ std::free(memory); }
+
+namespace nap
+{
+	size_t getHeapAllocationCount()
+	{
+		return sAllocations.load(std::memory_order_relaxed);
+	}
+}
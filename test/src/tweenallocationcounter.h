@@ -0,0 +1,19 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// External Includes
+#include <cstddef>
+
+namespace nap
+{
+	/**
+	 * Number of heap allocations made by the executable since it started.
+	 * Counted by the global operator new and new[] replacements in tweenallocationcounter.cpp, linked into the test and benchmark executables.
+	 * The replacements live in their own translation unit, so they are never inlined into the code that allocates.
+	 * @return number of heap allocations
+	 */
+	size_t getHeapAllocationCount();
+}
@@ -0,0 +1,381 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+// Local Includes
+#include "tweentest.h"
+#include "tweenallocationcounter.h"
+
+// External Includes
+#include <tweensimd.h>
+#include <nap/logger.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+namespace nap
+{
+	/**
+	 * Exposes the update loop of the service, which is normally driven by core
+	 */
+	class TestTweenService : public TweenService
+	{
+	public:
+		using TweenService::TweenService;
+		using TweenService::init;
+		using TweenService::update;
+		using TweenService::shutdown;
+	};
+
+
+	// odd count, so the scalar tail of every vector kernel is tested as well
+	static constexpr uint32 sKernelSamples = (1 << 16) + 7;
+	static constexpr double sDeltaTime = 1.0 / 60.0;
+	static constexpr uint32 sChurnCount = 200;
+	static constexpr uint32 sWarmupCycles = 60;
+	static constexpr uint32 sSteadyCycles = 120;
+	static constexpr uint32 sGroupCount = 1000;
+
+
+	static std::string getName(ETweenEaseType easing)
+	{
+		return RTTI_OF(ETweenEaseType).get_enumeration().value_to_name(easing).to_string();
+	}
+
+
+	static std::string getName(ETweenInstructionSet set)
+	{
+		switch (set)
+		{
+		case ETweenInstructionSet::SSE2:	return "SSE2";
+		case ETweenInstructionSet::AVX2:	return "AVX2";
+		case ETweenInstructionSet::NEON:	return "NEON";
+		default:							return "Scalar";
+		}
+	}
+
+
+	/**
+	 * Largest absolute difference between two arrays of floats, NaN counts as infinitely large
+	 */
+	static float getMaxError(const float* values, const float* expected, size_t count)
+	{
+		float error = 0.0f;
+		for (size_t i = 0; i < count; i++)
+		{
+			float difference = std::fabs(values[i] - expected[i]);
+			error = difference <= error ? error : difference;
+		}
+		return error;
+	}
+
+
+	/**
+	 * Largest difference between two arrays of floats in ulp of the given magnitudes, clamped to a floor, NaN counts as infinitely large
+	 */
+	static float getMaxUlpError(const float* values, const float* expected, const float* magnitudes, size_t count, float floor)
+	{
+		float error = 0.0f;
+		for (size_t i = 0; i < count; i++)
+		{
+			float magnitude = std::max(std::fabs(magnitudes[i]), floor);
+			float ulp = std::ldexp(1.0f, std::ilogb(magnitude) - std::numeric_limits<float>::digits + 1);
+			float difference = std::fabs(values[i] - expected[i]) / ulp;
+			error = difference <= error ? error : difference;
+		}
+		return error;
+	}
+
+
+	/**
+	 * Deterministic values in the range [-1, 1]
+	 */
+	static std::vector<float> makeValues(size_t count, uint32 seed)
+	{
+		std::vector<float> values(count);
+		uint32 state = seed;
+		for (auto& value : values)
+		{
+			state = state * 1664525u + 1013904223u;
+			value = static_cast<float>(state >> 8) / static_cast<float>(1u << 23) - 1.0f;
+		}
+		return values;
+	}
+
+
+	TweenTest::TweenTest(const std::string& filter) :
+		mFilter(filter)
+	{ }
+
+
+	bool TweenTest::run()
+	{
+		if (isEnabled("kernels"))
+			testKernels();
+		if (isEnabled("allocations"))
+			testAllocations();
+		if (isEnabled("groups"))
+			testGroups();
+
+		if (mFailures > 0)
+			nap::Logger::error("%d of %d checks failed", mFailures, mChecks);
+		else
+			nap::Logger::info("All %d checks passed", mChecks);
+		return mFailures == 0;
+	}
+
+
+	bool TweenTest::isEnabled(const std::string& suite) const
+	{
+		return mFilter.empty() || suite.find(mFilter) != std::string::npos;
+	}
+
+
+	bool TweenTest::check(bool condition, const std::string& message)
+	{
+		mChecks++;
+		if (!condition)
+		{
+			mFailures++;
+			nap::Logger::error("%s", message.c_str());
+		}
+		return condition;
+	}
+
+
+	void TweenTest::testKernels()
+	{
+		// half of the progress covers the whole range including both ends, the other half is spaced geometrically towards both ends,
+		// where most eases subtract nearly equal values
+		const uint32 uniform_count = sKernelSamples / 2 + 1;
+		const uint32 geometric_count = sKernelSamples - uniform_count;
+		std::vector<float> progress(sKernelSamples);
+		for (uint32 i = 0; i < uniform_count; i++)
+			progress[i] = static_cast<float>(i) / static_cast<float>(uniform_count - 1);
+		for (uint32 i = 0; i < geometric_count; i++)
+		{
+			float distance = std::exp2(-20.0f * static_cast<float>(i / 2 + 1) / static_cast<float>(geometric_count / 2));
+			progress[uniform_count + i] = i % 2 == 0 ? distance : 1.0f - distance;
+		}
+
+		// reference results of the scalar eases
+		std::vector<std::vector<float>> eased(tweenEaseCount, std::vector<float>(sKernelSamples));
+		for (uint32 e = 0; e < tweenEaseCount; e++)
+		{
+			for (uint32 i = 0; i < sKernelSamples; i++)
+				eased[e][i] = evaluateTweenEase(static_cast<ETweenEaseType>(e), progress[i]);
+		}
+
+		// lerp inputs hold a whole number of vectors of every size
+		const size_t lerp_count = sKernelSamples * 12;
+		std::vector<float> start = makeValues(lerp_count, 1);
+		std::vector<float> end = makeValues(lerp_count, 2);
+		std::vector<float> lerp_progress(lerp_count);
+		for (size_t i = 0; i < lerp_count; i++)
+			lerp_progress[i] = progress[i % sKernelSamples];
+		const float uniform = progress[sKernelSamples / 3];
+
+		// the lerp error is measured in ulp of the largest operand
+		std::vector<float> magnitudes(lerp_count);
+		for (size_t i = 0; i < lerp_count; i++)
+			magnitudes[i] = std::max(std::fabs(start[i]), std::fabs(end[i]));
+
+		// every instruction set that runs on this cpu
+		ETweenInstructionSet selected = getTweenInstructionSet();
+		const ETweenInstructionSet sets[] = { ETweenInstructionSet::Scalar, ETweenInstructionSet::SSE2, ETweenInstructionSet::AVX2, ETweenInstructionSet::NEON };
+		std::vector<float> out(lerp_count);
+		for (auto set : sets)
+		{
+			if (!setTweenInstructionSet(set))
+			{
+				nap::Logger::info("kernels: %s not supported, skipped", getName(set).c_str());
+				continue;
+			}
+
+			float ease_error = 0.0f;
+			float ease_ulp = 0.0f;
+			for (uint32 e = 0; e < tweenEaseCount; e++)
+			{
+				auto easing = static_cast<ETweenEaseType>(e);
+				evaluateEaseBatch(easing, progress.data(), out.data(), sKernelSamples);
+				float error = getMaxError(out.data(), eased[e].data(), sKernelSamples);
+				float ulp = getMaxUlpError(out.data(), eased[e].data(), eased[e].data(), sKernelSamples, tweenBatchUlpFloor);
+				ease_error = std::max(ease_error, error);
+				ease_ulp = std::max(ease_ulp, ulp);
+
+				std::ostringstream message;
+				message << "kernels: " << getName(set) << " ease " << getName(easing) << " max error " << error << " exceeds " << tweenBatchMaxError;
+				check(error <= tweenBatchMaxError, message.str());
+
+				std::ostringstream ulp_message;
+				ulp_message << "kernels: " << getName(set) << " ease " << getName(easing) << " max error " << ulp << " ulp exceeds " << getTweenBatchMaxUlp(easing);
+				check(ulp <= static_cast<float>(getTweenBatchMaxUlp(easing)), ulp_message.str());
+			}
+
+			// every lerp kernel interpolates all floats, a vector kernel takes one progress value per vector
+			float lerp_ulp = 0.0f;
+			auto check_lerp = [&](const char* kernel, size_t width, bool shared)
+			{
+				std::vector<float> expected(lerp_count);
+				for (size_t i = 0; i < lerp_count; i++)
+				{
+					float value = shared ? uniform : lerp_progress[i / width];
+					expected[i] = value * (end[i] - start[i]) + start[i];
+				}
+				float ulp = getMaxUlpError(out.data(), expected.data(), magnitudes.data(), lerp_count, std::numeric_limits<float>::min());
+				lerp_ulp = std::max(lerp_ulp, ulp);
+
+				std::ostringstream message;
+				message << "kernels: " << getName(set) << " lerp " << kernel << " max error " << ulp << " ulp exceeds " << tweenLerpBatchMaxUlp;
+				check(ulp <= static_cast<float>(tweenLerpBatchMaxUlp), message.str());
+			};
+
+			lerpBatch(start.data(), end.data(), lerp_progress.data(), out.data(), lerp_count);
+			check_lerp("float", 1, false);
+			lerpBatch(reinterpret_cast<const glm::vec2*>(start.data()), reinterpret_cast<const glm::vec2*>(end.data()), lerp_progress.data(), reinterpret_cast<glm::vec2*>(out.data()), lerp_count / 2);
+			check_lerp("vec2", 2, false);
+			lerpBatch(reinterpret_cast<const glm::vec3*>(start.data()), reinterpret_cast<const glm::vec3*>(end.data()), lerp_progress.data(), reinterpret_cast<glm::vec3*>(out.data()), lerp_count / 3);
+			check_lerp("vec3", 3, false);
+			lerpBatch(reinterpret_cast<const glm::vec4*>(start.data()), reinterpret_cast<const glm::vec4*>(end.data()), lerp_progress.data(), reinterpret_cast<glm::vec4*>(out.data()), lerp_count / 4);
+			check_lerp("vec4", 4, false);
+			lerpBatch(start.data(), end.data(), uniform, out.data(), lerp_count);
+			check_lerp("uniform", 1, true);
+
+			nap::Logger::info("kernels: %s max ease error %g (%g ulp), max lerp error %g ulp", getName(set).c_str(), ease_error, ease_ulp, lerp_ulp);
+		}
+		setTweenInstructionSet(selected);
+	}
+
+
+	void TweenTest::testAllocations()
+	{
+		const bool parallel[] = { false, true };
+		for (bool in_parallel : parallel)
+		{
+			const char* name = in_parallel ? "parallel" : "serial";
+			TweenServiceConfiguration config;
+			config.mParallel = in_parallel;
+			config.mThreadCount = 2;
+			config.mChunkSize = 64;
+			TestTweenService service(&config);
+			utility::ErrorState error;
+			if (!check(service.init(error), std::string("allocations: unable to initialize tween service: ") + error.toString()))
+				continue;
+
+			// creates and destroys tweens of every kind, some complete during the cycle, the others are killed
+			std::vector<std::unique_ptr<TweenHandle<float>>> floats;
+			std::vector<std::unique_ptr<TweenHandle<glm::vec3>>> vectors;
+			floats.reserve(sChurnCount);
+			vectors.reserve(sChurnCount);
+			auto cycle = [&]()
+			{
+				for (uint32 i = 0; i < sChurnCount; i++)
+				{
+					float duration = (i % 4 == 0) ? 0.5f * static_cast<float>(sDeltaTime) : 1.0f;
+					floats.emplace_back(service.createTween<float>(0.0f, 1.0f, duration, error, ETweenEaseType::CUBIC_INOUT));
+					vectors.emplace_back(service.createTween<glm::vec3>(glm::vec3(0.0f), glm::vec3(1.0f), duration, error, ETweenEaseType::SINE_OUT, ETweenMode::PING_PONG));
+					service.play<float>(0.0f, 1.0f, duration, error, ETweenEaseType::QUAD_OUT);
+				}
+				service.update(sDeltaTime);
+				floats.clear();
+				vectors.clear();
+				service.update(sDeltaTime);
+				return service.getStats().mAllocationCount;
+			};
+
+			// warm up until the pools, handles and service reached their peak capacity, the handles alone allocate
+			size_t warmup = getHeapAllocationCount();
+			for (uint32 i = 0; i < sWarmupCycles; i++)
+				cycle();
+			check(getHeapAllocationCount() > warmup, std::string("allocations: ") + name + " warm up made no heap allocations, operator new isn't counted");
+
+			size_t before = getHeapAllocationCount();
+			size_t pool_allocations = 0;
+			for (uint32 i = 0; i < sSteadyCycles; i++)
+				pool_allocations += cycle();
+			size_t allocations = getHeapAllocationCount() - before;
+
+			std::ostringstream heap_message;
+			heap_message << "allocations: " << name << " steady state made " << allocations << " heap allocations in " << sSteadyCycles << " cycles";
+			check(allocations == 0, heap_message.str());
+
+			std::ostringstream pool_message;
+			pool_message << "allocations: " << name << " steady state reported " << pool_allocations << " pool allocations in " << sSteadyCycles << " cycles";
+			check(pool_allocations == 0, pool_message.str());
+
+			nap::Logger::info("allocations: %s %d heap and %d pool allocations in %d steady state cycles", name, static_cast<int>(allocations), static_cast<int>(pool_allocations), sSteadyCycles);
+			service.shutdown();
+		}
+	}
+
+
+	void TweenTest::testGroups()
+	{
+		TweenServiceConfiguration config;
+		TestTweenService service(&config);
+		utility::ErrorState error;
+		if (!check(service.init(error), std::string("groups: unable to initialize tween service: ") + error.toString()))
+			return;
+
+		// played tweens that would run for a minute, and a tween that is kept alive by its handle
+		auto group = service.createGroup();
+		uint32 index = group->getIndex();
+		std::vector<TweenPlayID> played;
+		for (uint32 i = 0; i < sGroupCount; i++)
+		{
+			played.emplace_back(service.play<float>(0.0f, 1.0f, 60.0f, error));
+			service.getTween<float>(played.back())->setGroup(group.get());
+		}
+		uint32 killed = 0;
+		auto handle = service.createTween<float>(0.0f, 1.0f, 60.0f, error);
+		handle->getTween().setGroup(group.get());
+		handle->getTween().KilledSignal.connect([&killed]() { killed++; });
+		service.update(sDeltaTime);
+
+		// destroying the group kills its tweens during the next update
+		group = nullptr;
+		service.update(sDeltaTime);
+		uint32 playing = 0;
+		for (const auto& id : played)
+			playing += service.isPlaying(id) ? 1 : 0;
+		check(playing == 0, "groups: " + std::to_string(playing) + " played tweens of a destroyed group are still playing");
+		check(killed == 1, "groups: the tween of a destroyed group was killed " + std::to_string(killed) + " times");
+		check(service.getStats().mActiveCount == 0, "groups: " + std::to_string(service.getStats().mActiveCount) + " tweens of a destroyed group are still active");
+
+		// the group is reused once its last member left
+		handle = nullptr;
+		service.update(sDeltaTime);
+		check(killed == 1, "groups: removing a killed tween killed it again");
+		auto reused = service.createGroup();
+		check(reused->getIndex() == index, "groups: a destroyed group without members isn't reused");
+
+		// restarting a killed tween or waking a killed spring of a cancelled group kills it again, other tweens keep playing
+		killed = 0;
+		auto tween = service.createTween<float>(0.0f, 1.0f, 60.0f, error);
+		tween->getTween().setGroup(reused.get());
+		tween->getTween().KilledSignal.connect([&killed]() { killed++; });
+		auto spring = service.createSpring<float>(0.0f, 2.0f, 1.0f, error);
+		spring->getTween().setGroup(reused.get());
+		spring->getTween().KilledSignal.connect([&killed]() { killed++; });
+		spring->getTween().setTarget(1.0f);
+		auto other = service.createTween<float>(0.0f, 1.0f, 60.0f, error);
+		reused->cancel();
+		service.update(sDeltaTime);
+		check(killed == 2, "groups: the members of a cancelled group were killed " + std::to_string(killed) + " times");
+		tween->getTween().restart();
+		service.update(sDeltaTime);
+		check(killed == 3, "groups: a restarted tween of a cancelled group isn't killed again");
+		spring->getTween().setTarget(2.0f);
+		service.update(sDeltaTime);
+		check(killed == 4, "groups: a woken spring of a cancelled group isn't killed again");
+		check(service.getStats().mActiveCount == 1, "groups: " + std::to_string(service.getStats().mActiveCount) + " tweens are active instead of 1");
+
+		tween = nullptr;
+		spring = nullptr;
+		other = nullptr;
+		reused = nullptr;
+		service.shutdown();
+	}
+}
@@ -0,0 +1,66 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// External Includes
+#include <tweenservice.h>
+#include <string>
+
+namespace nap
+{
+	//////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * Headless tests of the tween module: no window, no core, the module is driven directly.
+	 * Suites:
+	 * 	- kernels: every batch kernel of every supported instruction set matches the scalar eases within tweenBatchMaxError
+	 * 	  and getTweenBatchMaxUlp(), and the scalar lerp within tweenLerpBatchMaxUlp
+	 * 	- allocations: creating, destroying and updating tweens in a steady state doesn't allocate memory,
+	 * 	  counted by a replaced global operator new and by the statistics of the service
+	 * 	- groups: the tweens of a destroyed group are killed, played tweens are removed and the group is reused,
+	 * 	  a killed tween of a cancelled group that is restarted or woken up is killed again
+	 * Every failed check is logged, run() returns false when a check failed.
+	 */
+	class TweenTest
+	{
+	public:
+		/**
+		 * Constructor
+		 * @param filter only run suites whose name contains this string, empty runs all
+		 */
+		TweenTest(const std::string& filter);
+
+		/**
+		 * Runs all suites that pass the filter
+		 * @return if all checks passed
+		 */
+		bool run();
+
+		/**
+		 * @return number of failed checks
+		 */
+		uint32 getFailureCount() const						{ return mFailures; }
+
+	private:
+		void testKernels();
+		void testAllocations();
+		void testGroups();
+
+		/**
+		 * @return if the suite with the given name passes the filter
+		 */
+		bool isEnabled(const std::string& suite) const;
+
+		/**
+		 * Logs and counts a failure when the condition doesn't hold
+		 * @return the condition
+		 */
+		bool check(bool condition, const std::string& message);
+
+		std::string								mFilter;
+		uint32									mChecks = 0;
+		uint32									mFailures = 0;
+	};
+}